@@ -0,0 +1,243 @@
+/*********************************************************************
+ * \file   action_map.cpp
+ * \brief  ANV蓖āiconstexpr e[urbg}XN֕ϊĔj
+ *********************************************************************/
+#include "action_map.h"
+
+//==============================================================================
+// 萔`
+//==============================================================================
+namespace {
+    // ͌̂ʒu
+    constexpr int AXIS_CONDITION_SHIFT = 32;
+}
+
+//==============================================================================
+// 蓖Ă̓ǂݍ
+//==============================================================================
+bool ActionMap::Load(const ActionDef* pDefs, int count) {
+    if (count < 0 || count > MAX_BINDINGS) return false;
+
+    for (int i = 0; i < count; i++) {
+        if (!IsValidAction(pDefs[i].action)) return false;
+    }
+    for (int i = 0; i < count; i++) {
+        m_bindings[i] = pDefs[i];
+    }
+    m_bindingCount = count;
+    return Rebuild();
+}
+
+//==============================================================================
+// CAEg
+//==============================================================================
+void ActionMap::SetLayout(ControllerType type, const ActionDef* pDefs, int count) {
+    int index = static_cast<int>(type);
+    if (index < 0 || index >= LAYOUT_COUNT) return;
+    m_layouts[index].pDefs = pDefs;
+    m_layouts[index].count = count;
+}
+
+bool ActionMap::IsNintendo(ControllerType type) {
+    return type == ControllerType::NintendoSwitch ||
+        type == ControllerType::NintendoSwitchJoyconLeft ||
+        type == ControllerType::NintendoSwitchJoyconRight ||
+        type == ControllerType::NintendoSwitchJoyconPair;
+}
+
+bool ActionMap::SelectLayout(ControllerType type) {
+    int index = static_cast<int>(type);
+    if (index >= 0 && index < LAYOUT_COUNT && m_layouts[index].pDefs) {
+        return Load(m_layouts[index].pDefs, m_layouts[index].count);
+    }
+
+    const Layout& fallback = m_layouts[static_cast<int>(ControllerType::Unknown)];
+    if (!fallback.pDefs || !Load(fallback.pDefs, fallback.count)) return false;
+
+    if (m_nintendoFaceSwap && IsNintendo(type)) {
+        for (int i = 0; i < m_bindingCount; i++) {
+            m_bindings[i].binding.mask = SwapFaceButtons(m_bindings[i].binding.mask);
+        }
+        return Rebuild();
+    }
+    return true;
+}
+
+//==============================================================================
+// s̊蓖ĕύX
+//==============================================================================
+bool ActionMap::Rebind(int action, const ActionBinding& binding, int index) {
+    if (!IsValidAction(action) || index < 0) return false;
+
+    int found = 0;
+    for (int i = 0; i < m_bindingCount; i++) {
+        if (m_bindings[i].action != action) continue;
+        if (found++ == index) {
+            ActionBinding previous = m_bindings[i].binding;
+            m_bindings[i].binding = binding;
+            if (Rebuild()) return true;
+
+            // \Ɏ܂ȂΌɖ߂
+            m_bindings[i].binding = previous;
+            Rebuild();
+            return false;
+        }
+    }
+
+    if (m_bindingCount >= MAX_BINDINGS) return false;
+    m_bindings[m_bindingCount].action = action;
+    m_bindings[m_bindingCount].binding = binding;
+    m_bindingCount++;
+    if (Rebuild()) return true;
+
+    m_bindingCount--;
+    Rebuild();
+    return false;
+}
+
+void ActionMap::ClearBindings(int action) {
+    int count = 0;
+    for (int i = 0; i < m_bindingCount; i++) {
+        if (m_bindings[i].action != action) {
+            m_bindings[count++] = m_bindings[i];
+        }
+    }
+    m_bindingCount = count;
+    Rebuild();
+}
+
+int ActionMap::GetBindingCount(int action) const {
+    int count = 0;
+    for (int i = 0; i < m_bindingCount; i++) {
+        count += (m_bindings[i].action == action) ? 1 : 0;
+    }
+    return count;
+}
+
+const ActionBinding* ActionMap::GetBinding(int action, int index) const {
+    int found = 0;
+    for (int i = 0; i < m_bindingCount; i++) {
+        if (m_bindings[i].action == action && found++ == index) {
+            return &m_bindings[i].binding;
+        }
+    }
+    return nullptr;
+}
+
+//==============================================================================
+// }XN\̍č\z
+//------------------------------------------------------------------------------
+// Button  1 rbg̃}XNɕAChord ͂̂܂ 1 ̃}XNɂB
+// ͓͌̏ 32 rbg 1 rbg蓖Ăi͋LjB
+//==============================================================================
+bool ActionMap::Rebuild() {
+    m_axisConditionCount = 0;
+    m_maskCount = 0;
+
+    for (int i = 0; i < m_bindingCount; i++) {
+        const ActionBinding& binding = m_bindings[i].binding;
+        int action = m_bindings[i].action;
+
+        switch (binding.kind) {
+        case BindingKind::Button:
+            for (uint32_t bits = binding.mask; bits; bits &= bits - 1) {
+                if (!AddMask(bits & (~bits + 1), action)) return false;
+            }
+            break;
+
+        case BindingKind::Chord:
+            if (binding.mask && !AddMask(binding.mask, action)) return false;
+            break;
+
+        case BindingKind::AxisAbove:
+        case BindingKind::AxisBelow: {
+            int condition = FindAxisCondition(binding);
+            if (condition < 0) return false;
+            if (!AddMask(1ull << (AXIS_CONDITION_SHIFT + condition), action)) return false;
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+    return true;
+}
+
+int ActionMap::FindAxisCondition(const ActionBinding& binding) {
+    if (binding.axis < 0 || binding.axis >= SDL_GAMEPAD_AXIS_COUNT) return -1;
+
+    bool above = (binding.kind == BindingKind::AxisAbove);
+    for (int i = 0; i < m_axisConditionCount; i++) {
+        const AxisCondition& condition = m_axisConditions[i];
+        if (condition.axis == binding.axis && condition.above == above && condition.threshold == binding.threshold) {
+            return i;
+        }
+    }
+
+    if (m_axisConditionCount >= MAX_AXIS_CONDITIONS) return -1;
+    AxisCondition& condition = m_axisConditions[m_axisConditionCount];
+    condition.axis = binding.axis;
+    condition.above = above;
+    condition.threshold = binding.threshold;
+    return m_axisConditionCount++;
+}
+
+bool ActionMap::AddMask(Uint64 mask, int action) {
+    if (m_maskCount >= MAX_MASKS) return false;
+    m_masks[m_maskCount] = mask;
+    m_maskActions[m_maskCount] = static_cast<Uint8>(action);
+    m_maskCount++;
+    return true;
+}
+
+//==============================================================================
+// 
+//==============================================================================
+void ActionMap::Update(const GamepadState& state) {
+    // SDL_GamepadAxis 
+    const float axes[SDL_GAMEPAD_AXIS_COUNT] = {
+        state.leftStickX, state.leftStickY,
+        state.rightStickX, state.rightStickY,
+        state.leftTrigger, state.rightTrigger,
+    };
+
+    // ͌i 32 rbg: {^A 32 rbg: j
+    Uint64 input = state.buttons;
+    for (int i = 0; i < m_axisConditionCount; i++) {
+        const AxisCondition& condition = m_axisConditions[i];
+        float value = axes[condition.axis];
+        bool hit = condition.above ? (value >= condition.threshold) : (value <= condition.threshold);
+        input |= static_cast<Uint64>(hit) << (AXIS_CONDITION_SHIFT + i);
+    }
+
+    // t[ŉė{^iGamepadState ̃GbWjEƂĐB
+    // ͂̃t[ŉꂽ{^܂߂đΐƂB
+    // t[̉́AÕt[ŐĂÃt[Ő̂
+    Uint64 pressed = state.triggered;
+    Uint64 released = state.released;
+
+    Uint64 active = 0;
+    Uint64 tapTriggered = 0;
+    Uint64 tapReleased = 0;
+    for (int i = 0; i < m_maskCount; i++) {
+        Uint64 mask = m_masks[i];
+        Uint64 bit = 1ull << m_maskActions[i];
+        active |= ((input & mask) == mask) ? bit : 0;
+        tapTriggered |= ((pressed & mask) && ((input | pressed) & mask) == mask) ? bit : 0;
+        tapReleased |= ((released & mask) && ((input | pressed | released) & mask) == mask) ? bit : 0;
+    }
+
+    tapReleased &= m_active | tapTriggered;
+
+    Uint64 changed = active ^ m_active;
+    m_triggered = (changed & active) | tapTriggered;
+    m_released = (changed & m_active) | tapReleased;
+    m_active = active;
+}
+
+void ActionMap::Clear() {
+    m_active = 0;
+    m_triggered = 0;
+    m_released = 0;
+}
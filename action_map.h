@@ -0,0 +1,159 @@
+/*********************************************************************
+ * \file   action_map.h
+ * \brief  ANV蓖āiconstexpr e[urbg}XN֕ϊĔj
+ *********************************************************************/
+#pragma once
+#include "game_controller.h"
+
+//==============================================================================
+// 蓖Ďʗ񋓌^
+//==============================================================================
+enum class BindingKind : Uint8 {
+    None,
+    Button,     // mask ̂ꂩĂ
+    Chord,      // mask ׂ̂ĂĂ
+    AxisAbove,  // ̒l threshold ȏ
+    AxisBelow   // ̒l threshold ȉ
+};
+
+//==============================================================================
+// 蓖č\́iconstexpr ŕ\悤ɂĂj
+//==============================================================================
+struct ActionBinding {
+    BindingKind kind = BindingKind::None;
+    Sint8 axis = -1;
+    uint32_t mask = 0;
+    float threshold = 0.0f;
+
+    constexpr ActionBinding() = default;
+    constexpr ActionBinding(BindingKind kind_, uint32_t mask_, Sint8 axis_, float threshold_)
+        : kind(kind_), axis(axis_), mask(mask_), threshold(threshold_) {}
+
+    static constexpr ActionBinding Button(uint32_t mask) {
+        return ActionBinding(BindingKind::Button, mask, -1, 0.0f);
+    }
+    static constexpr ActionBinding Chord(uint32_t mask) {
+        return ActionBinding(BindingKind::Chord, mask, -1, 0.0f);
+    }
+    static constexpr ActionBinding AxisAbove(SDL_GamepadAxis axis, float threshold) {
+        return ActionBinding(BindingKind::AxisAbove, 0, static_cast<Sint8>(axis), threshold);
+    }
+    static constexpr ActionBinding AxisBelow(SDL_GamepadAxis axis, float threshold) {
+        return ActionBinding(BindingKind::AxisBelow, 0, static_cast<Sint8>(axis), threshold);
+    }
+};
+
+//==============================================================================
+// ANV`iANVԍƊ蓖Ă̑gBANV𕡐s ORj
+//------------------------------------------------------------------------------
+//  enum Action { ACTION_JUMP, ACTION_FIRE, ACTION_MENU };
+//  constexpr ActionDef DEFAULT_ACTIONS[] = {
+//      { ACTION_JUMP, ActionBinding::Button(BUTTON_MASK_DOWN) },
+//      { ACTION_FIRE, ActionBinding::AxisAbove(SDL_GAMEPAD_AXIS_RIGHT_TRIGGER, 0.3f) },
+//      { ACTION_MENU, ActionBinding::Chord(BUTTON_MASK_SELECT | BUTTON_MASK_START) },
+//  };
+//==============================================================================
+struct ActionDef {
+    int action;
+    ActionBinding binding;
+};
+
+//==============================================================================
+// \Lǂ̖ʃ{^ɍ킹邽߂̓ւiƉEAƏj
+//------------------------------------------------------------------------------
+// SDL ̃{^͈ʒuȂ̂ŁANintendo ́uA Ōv͉E{^ɂȂB
+//==============================================================================
+constexpr uint32_t SwapFaceButtons(uint32_t mask) {
+    return (mask & ~BUTTON_MASK_FACE) |
+        ((mask & BUTTON_MASK_DOWN) ? BUTTON_MASK_RIGHT : 0u) |
+        ((mask & BUTTON_MASK_RIGHT) ? BUTTON_MASK_DOWN : 0u) |
+        ((mask & BUTTON_MASK_LEFT) ? BUTTON_MASK_UP : 0u) |
+        ((mask & BUTTON_MASK_UP) ? BUTTON_MASK_LEFT : 0u);
+}
+
+//==============================================================================
+// ANV蓖ăNX
+//------------------------------------------------------------------------------
+// 蓖Ă̓{^ 32 rbg +  32 rbg̓͌ɑ΂}XN֕ϊA
+// Update() ł̓}XN̕\ 1 Ȃ߂邾őSANV𔻒肷B
+// 蓖Ă̕ύX͌Œ蒷̔zōsAmۂ͂ȂB
+//==============================================================================
+class ActionMap {
+public:
+    static constexpr int MAX_ACTIONS = 64;
+    static constexpr int MAX_BINDINGS = 64;
+    static constexpr int MAX_AXIS_CONDITIONS = 32;
+    static constexpr int MAX_MASKS = 128;
+    static constexpr int LAYOUT_COUNT = static_cast<int>(ControllerType::Other) + 1;
+
+    // 蓖Ă̓ǂݍ݁i\̓e̔zփRs[j
+    bool Load(const ActionDef* pDefs, int count);
+    template<int N>
+    bool Load(const ActionDef (&defs)[N]) { return Load(defs, N); }
+
+    // Rg[[ʂƂ̊背CAEgi\͌Ăяoێ邱Ɓj
+    // Unknown ɓo^̂ʂ̊ɂȂB
+    void SetLayout(ControllerType type, const ActionDef* pDefs, int count);
+    template<int N>
+    void SetLayout(ControllerType type, const ActionDef (&defs)[N]) { SetLayout(type, defs, N); }
+
+    // CAEgo^ Nintendo nŖʃ{^\Lǂɓւ邩
+    void SetNintendoFaceSwap(bool enable) { m_nintendoFaceSwap = enable; }
+
+    // ʂɍCAEgǂݍ
+    bool SelectLayout(ControllerType type);
+
+    // s̊蓖ĕύXiindex Ԗڂ̊蓖ĂuAΒǉj
+    bool Rebind(int action, const ActionBinding& binding, int index = 0);
+    void ClearBindings(int action);
+    int GetBindingCount(int action) const;
+    const ActionBinding* GetBinding(int action, int index) const;
+
+    // i1 t[ 1 jBt[ŉė{^EƂĐ
+    void Update(const GamepadState& state);
+    void Clear();
+
+    bool IsActive(int action) const { return IsValidAction(action) && ((m_active >> action) & 1); }
+    bool IsTriggered(int action) const { return IsValidAction(action) && ((m_triggered >> action) & 1); }
+    bool IsReleased(int action) const { return IsValidAction(action) && ((m_released >> action) & 1); }
+    Uint64 GetActive() const { return m_active; }
+    Uint64 GetTriggered() const { return m_triggered; }
+    Uint64 GetReleased() const { return m_released; }
+
+private:
+    static bool IsValidAction(int action) { return action >= 0 && action < MAX_ACTIONS; }
+
+    struct AxisCondition {
+        Sint8 axis;
+        bool above;
+        float threshold;
+    };
+
+    struct Layout {
+        const ActionDef* pDefs = nullptr;
+        int count = 0;
+    };
+
+    static bool IsNintendo(ControllerType type);
+    bool Rebuild();
+    int FindAxisCondition(const ActionBinding& binding);
+    bool AddMask(Uint64 mask, int action);
+
+    // 蓖āiANVł͂Ȃǂݍݏj
+    ActionDef m_bindings[MAX_BINDINGS] = {};
+    int m_bindingCount = 0;
+
+    // ϊς݂̃}XNiƁA{^Ẽ}XNj
+    AxisCondition m_axisConditions[MAX_AXIS_CONDITIONS] = {};
+    int m_axisConditionCount = 0;
+    Uint64 m_masks[MAX_MASKS] = {};
+    Uint8 m_maskActions[MAX_MASKS] = {};
+    int m_maskCount = 0;
+
+    Layout m_layouts[LAYOUT_COUNT];
+    bool m_nintendoFaceSwap = true;
+
+    Uint64 m_active = 0;
+    Uint64 m_triggered = 0;
+    Uint64 m_released = 0;
+};
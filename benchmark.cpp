@@ -0,0 +1,795 @@
+/*********************************************************************
+ * \file   benchmark.cpp
+ * \brief  ͏̃}CNx`}[NiSDL zWCXeBbNgp / wbhXj
+ *
+ * g: benchmark [--pads N] [--frames N] [--startup N] [--mappings PATH] [--json PATH]
+ *   1 ` N ̉zQ[pbhڑA{^EEZT[E^b`
+ *   t[Ȃ Update() ̃RXgv JSON ŏo͂B
+ *   ʐMpGR[_[͍͂ŃX[vbg 1 t[̃oCg𑪂B
+ *   NԂ͏i / 񓯊jƃ}bsO̎荞݁ieLXg / LbV
+ *   ̑OEɓnj --startup 񂸂B--mappings 
+ *   gamecontrollerdb.txt ̍s𐶐ĎgBLbV̑OÊǂł
+ *   荞܂Aɂqgc邱Ƃm߂isƏIR[h 1jB
+ *   R}h͂̔F͓o^ 1 ` 64 ƕςāA1 t[̃RXgςȂƂB
+ *********************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include "game_controller.h"
+#include "gamepad_manager.h"
+#include "input_codec.h"
+#include "mapping_cache.h"
+#include "motion_command.h"
+
+//==============================================================================
+// mۉ񐔂̌viSDL  C++ ̗j
+//==============================================================================
+namespace {
+    // o̓XbhE̓Xbhmۂ̂ŃAg~bNɐ
+    std::atomic<size_t> g_allocCount(0);
+
+    void CountAlloc() { g_allocCount.fetch_add(1, std::memory_order_relaxed); }
+    Uint64 GetAllocCount() { return g_allocCount.load(std::memory_order_relaxed); }
+
+    SDL_malloc_func g_pOrigMalloc = nullptr;
+    SDL_calloc_func g_pOrigCalloc = nullptr;
+    SDL_realloc_func g_pOrigRealloc = nullptr;
+    SDL_free_func g_pOrigFree = nullptr;
+
+    void* SDLCALL CountingMalloc(size_t size) { CountAlloc(); return g_pOrigMalloc(size); }
+    void* SDLCALL CountingCalloc(size_t nmemb, size_t size) { CountAlloc(); return g_pOrigCalloc(nmemb, size); }
+    void* SDLCALL CountingRealloc(void* pMem, size_t size) { CountAlloc(); return g_pOrigRealloc(pMem, size); }
+    void SDLCALL CountingFree(void* pMem) { g_pOrigFree(pMem); }
+
+    void InstallAllocCounter() {
+        SDL_GetOriginalMemoryFunctions(&g_pOrigMalloc, &g_pOrigCalloc, &g_pOrigRealloc, &g_pOrigFree);
+        SDL_SetMemoryFunctions(CountingMalloc, CountingCalloc, CountingRealloc, CountingFree);
+    }
+}
+
+void* operator new(size_t size) {
+    CountAlloc();
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+//==============================================================================
+// 萔Eݒ
+//==============================================================================
+namespace {
+    constexpr int MAX_PADS = GamepadManager::MAX_SLOTS;
+    constexpr int MAX_FRAMES = 20000;
+    constexpr int WARMUP_FRAMES = 30;
+    constexpr int ACCESSOR_ITERATIONS = 200000;
+
+    struct Options {
+        int maxPads = 4;
+        int frames = 2000;
+        int startupIterations = 20;
+        const char* pMappingsPath = nullptr;
+        const char* pJsonPath = nullptr;
+    };
+
+    // zpbh
+    struct VirtualPad {
+        SDL_JoystickID id = 0;
+        SDL_Joystick* pJoystick = nullptr;
+    };
+
+    // v
+    struct Result {
+        char name[48] = {};
+        int pads = 0;
+        double nsPerFrameAvg = 0.0;
+        double nsPerFrameP99 = 0.0;
+        double nsPerFrameMax = 0.0;
+        double eventsPerSec = 0.0;
+        double allocsPerFrame = 0.0;
+    };
+
+    // GR[_[̌v
+    struct CodecResult {
+        char name[48] = {};
+        double encodeNsPerFrame = 0.0;
+        double decodeNsPerFrame = 0.0;
+        double bytesPerFrameAvg = 0.0;
+        int bytesPerFrameMax = 0;
+        int rawBytesPerFrame = 0;
+        double allocsPerFrame = 0.0;
+    };
+
+    // NԂ̌v
+    struct StartupResult {
+        char name[48] = {};
+        int iterations = 0;
+        double nsAvg = 0.0;
+        double nsMax = 0.0;
+        int mappings = 0;
+        int loaded = -1;        // SDL ɑ}bsOim߂ĂȂ -1j
+    };
+
+    Uint64 g_frameTimes[MAX_FRAMES];
+    Result g_results[64];
+    int g_resultCount = 0;
+    CodecResult g_codecResults[8];
+    int g_codecResultCount = 0;
+    RecordedFrame g_codecFrames[MAX_FRAMES];
+    Uint8 g_packets[MAX_FRAMES][InputCodecFormat::MAX_PACKET_SIZE];
+    size_t g_packetSizes[MAX_FRAMES];
+    StartupResult g_startupResults[8];
+    int g_startupResultCount = 0;
+
+    // R}h͂̔F̌v
+    struct MotionResult {
+        int commands = 0;
+        double nsPerFrameAvg = 0.0;
+        double nsPerFrameP99 = 0.0;
+        double allocsPerFrame = 0.0;
+        int triggered = 0;
+    };
+
+    MotionResult g_motionResults[8];
+    int g_motionResultCount = 0;
+    volatile int g_sink = 0;
+}
+
+//==============================================================================
+// zpbh̐ڑE
+//==============================================================================
+namespace {
+    const SDL_VirtualJoystickSensorDesc SENSOR_DESCS[] = {
+        { SDL_SENSOR_GYRO, 1000.0f },
+        { SDL_SENSOR_ACCEL, 1000.0f },
+    };
+    const SDL_VirtualJoystickTouchpadDesc TOUCHPAD_DESCS[] = {
+        { 2, { 0, 0, 0 } },
+    };
+
+    bool AttachPad(VirtualPad* pPad, int index) {
+        SDL_VirtualJoystickDesc desc;
+        SDL_INIT_INTERFACE(&desc);
+        desc.type = SDL_JOYSTICK_TYPE_GAMEPAD;
+        desc.naxes = SDL_GAMEPAD_AXIS_COUNT;
+        desc.nbuttons = SDL_GAMEPAD_BUTTON_COUNT;
+        desc.ntouchpads = SDL_arraysize(TOUCHPAD_DESCS);
+        desc.touchpads = TOUCHPAD_DESCS;
+        desc.nsensors = SDL_arraysize(SENSOR_DESCS);
+        desc.sensors = SENSOR_DESCS;
+        desc.vendor_id = 0x1234;
+        desc.product_id = static_cast<Uint16>(0x1000 + index);
+        desc.name = "Benchmark Virtual Pad";
+
+        pPad->id = SDL_AttachVirtualJoystick(&desc);
+        if (!pPad->id) return false;
+
+        pPad->pJoystick = SDL_OpenJoystick(pPad->id);
+        return pPad->pJoystick != nullptr;
+    }
+
+    void DetachPad(VirtualPad* pPad) {
+        if (pPad->pJoystick) SDL_CloseJoystick(pPad->pJoystick);
+        if (pPad->id) SDL_DetachVirtualJoystick(pPad->id);
+        *pPad = {};
+    }
+
+    // t[Ƃ̓̓p^[i{^ 2 ̐؂ւESEZT[E^b`j
+    void DrivePad(const VirtualPad& pad, int index, int frame) {
+        int phase = frame + index * 7;
+
+        int button = phase % (SDL_GAMEPAD_BUTTON_MISC1 + 1);
+        SDL_SetJoystickVirtualButton(pad.pJoystick, button, (phase / 16) % 2 == 0);
+        SDL_SetJoystickVirtualButton(pad.pJoystick, SDL_GAMEPAD_BUTTON_SOUTH, (phase % 4) < 2);
+
+        for (int axis = 0; axis < SDL_GAMEPAD_AXIS_COUNT; axis++) {
+            int value = ((phase * 1031 + axis * 8191) % 65536) - 32768;
+            SDL_SetJoystickVirtualAxis(pad.pJoystick, axis, static_cast<Sint16>(value));
+        }
+
+        Uint64 timestampNS = SDL_GetTicksNS();
+        float gyro[3] = { 0.01f * (phase % 100), -0.02f, 0.03f };
+        float accel[3] = { 0.0f, -SDL_STANDARD_GRAVITY, 0.1f * (phase % 10) };
+        SDL_SendJoystickVirtualSensorData(pad.pJoystick, SDL_SENSOR_GYRO, timestampNS, gyro, 3);
+        SDL_SendJoystickVirtualSensorData(pad.pJoystick, SDL_SENSOR_ACCEL, timestampNS, accel, 3);
+
+        float x = (phase % 100) / 100.0f;
+        SDL_SetJoystickVirtualTouchpad(pad.pJoystick, 0, 0, (phase % 30) < 20, x, 0.5f, 1.0f);
+    }
+}
+
+//==============================================================================
+// vwp[
+//==============================================================================
+namespace {
+    Result* AddResult(const char* pName, int pads) {
+        Result* pResult = &g_results[g_resultCount++];
+        *pResult = {};
+        SDL_snprintf(pResult->name, sizeof(pResult->name), "%s", pName);
+        pResult->pads = pads;
+        return pResult;
+    }
+
+    void Summarize(Result* pResult, int frames, Uint64 totalEvents, Uint64 allocs) {
+        Uint64 total = 0;
+        for (int i = 0; i < frames; i++) total += g_frameTimes[i];
+
+        std::sort(g_frameTimes, g_frameTimes + frames);
+        pResult->nsPerFrameAvg = static_cast<double>(total) / frames;
+        pResult->nsPerFrameP99 = static_cast<double>(g_frameTimes[(frames * 99) / 100]);
+        pResult->nsPerFrameMax = static_cast<double>(g_frameTimes[frames - 1]);
+        pResult->eventsPerSec = total ? static_cast<double>(totalEvents) * 1e9 / static_cast<double>(total) : 0.0;
+        pResult->allocsPerFrame = static_cast<double>(allocs) / frames;
+    }
+}
+
+//==============================================================================
+// GameController::Update()i1 ڂ̃pbĥ݂j
+//==============================================================================
+static void BenchGameController(const Options& options, int pads, InputMode mode, const char* pName) {
+    if (!GameController::Initialize()) return;
+    GameController::SetInputMode(mode);
+
+    VirtualPad virtualPads[MAX_PADS];
+    for (int i = 0; i < pads; i++) AttachPad(&virtualPads[i], i);
+
+    for (int frame = 0; frame < WARMUP_FRAMES; frame++) {
+        for (int i = 0; i < pads; i++) DrivePad(virtualPads[i], i, frame);
+        GameController::Update();
+    }
+
+    Uint64 totalEvents = 0;
+    Uint64 allocStart = GetAllocCount();
+    for (int frame = 0; frame < options.frames; frame++) {
+        for (int i = 0; i < pads; i++) DrivePad(virtualPads[i], i, WARMUP_FRAMES + frame);
+
+        Uint64 start = SDL_GetTicksNS();
+        GameController::Update();
+        g_frameTimes[frame] = SDL_GetTicksNS() - start;
+
+        totalEvents += GameController::GetFrameSampleCount();
+    }
+    Uint64 allocs = GetAllocCount() - allocStart;
+
+    Summarize(AddResult(pName, pads), options.frames, totalEvents, allocs);
+
+    for (int i = 0; i < pads; i++) DetachPad(&virtualPads[i]);
+    GameController::Finalize();
+}
+
+//==============================================================================
+// GamepadManager::Update()iSpbhj
+//==============================================================================
+static void BenchGamepadManager(const Options& options, int pads) {
+    if (!GamepadManager::Initialize()) return;
+
+    VirtualPad virtualPads[MAX_PADS];
+    for (int i = 0; i < pads; i++) AttachPad(&virtualPads[i], i);
+
+    for (int frame = 0; frame < WARMUP_FRAMES; frame++) {
+        for (int i = 0; i < pads; i++) DrivePad(virtualPads[i], i, frame);
+        GamepadManager::Update();
+    }
+
+    Uint64 allocStart = GetAllocCount();
+    for (int frame = 0; frame < options.frames; frame++) {
+        for (int i = 0; i < pads; i++) DrivePad(virtualPads[i], i, WARMUP_FRAMES + frame);
+
+        Uint64 start = SDL_GetTicksNS();
+        GamepadManager::Update();
+        g_frameTimes[frame] = SDL_GetTicksNS() - start;
+    }
+    Uint64 allocs = GetAllocCount() - allocStart;
+
+    Summarize(AddResult("GamepadManager::Update", pads), options.frames, 0, allocs);
+
+    for (int i = 0; i < pads; i++) DetachPad(&virtualPads[i]);
+    GamepadManager::Finalize();
+}
+
+//==============================================================================
+// ʐMpGR[_[i͂St[GR[hĂfR[hj
+//==============================================================================
+namespace {
+    // ۂ̑ɋ߂́iXeBbN͂񂵁A{^͎Xj
+    void MakeCodecFrame(RecordedFrame* pFrame, int frame, bool withSensor, bool withTouchpad) {
+        *pFrame = {};
+        pFrame->timestampNS = 1000000000ull + static_cast<Uint64>(frame) * 16666667ull;
+        pFrame->frame = static_cast<Uint32>(frame);
+
+        GamepadState& state = pFrame->state;
+        float t = frame / 60.0f;
+        state.connected = true;
+        state.leftStickX = 0.8f * std::sin(t);
+        state.leftStickY = 0.8f * std::cos(t * 0.7f);
+        state.rightStickX = ((frame / 90) % 2) ? 0.3f * std::sin(t * 3.0f) : 0.0f;
+        state.leftTrigger = ((frame / 40) % 3 == 0) ? 1.0f : 0.0f;
+        if ((frame / 12) % 5 == 0) state.buttons |= BUTTON_MASK_DOWN;
+        if ((frame / 30) % 4 == 1) state.buttons |= BUTTON_MASK_R1;
+        Uint32 prevButtons = 0;
+        if (frame > 0) {
+            if (((frame - 1) / 12) % 5 == 0) prevButtons |= BUTTON_MASK_DOWN;
+            if (((frame - 1) / 30) % 4 == 1) prevButtons |= BUTTON_MASK_R1;
+        }
+        state.UpdateEdges(prevButtons);
+
+        if (withSensor) {
+            pFrame->hasSensor = true;
+            SensorData& sensor = pFrame->sensor;
+            sensor.hasGyro = true;
+            sensor.hasAccel = true;
+            sensor.gyroX = 0.5f * std::sin(t * 2.0f);
+            sensor.gyroY = 0.01f * ((frame * 7919) % 13 - 6);
+            sensor.gyroZ = 0.002f;
+            sensor.accelX = 0.2f * std::sin(t);
+            sensor.accelY = -SDL_STANDARD_GRAVITY;
+            sensor.accelZ = 0.05f * ((frame * 104729) % 7 - 3);
+        }
+
+        if (withTouchpad) {
+            pFrame->hasTouchpad = true;
+            TouchpadData& touchpad = pFrame->touchpad;
+            touchpad.hasTouchpad = true;
+            touchpad.numTouchpads = 1;
+            TouchpadData::Finger& finger = touchpad.fingers[0][0];
+            finger.down = (frame % 120) < 45;
+            if (finger.down) {
+                finger.x = 0.2f + 0.01f * (frame % 120);
+                finger.y = 0.5f;
+                finger.pressure = 0.8f;
+            }
+        }
+    }
+}
+
+static void BenchInputCodec(const Options& options, const char* pName, bool withSensor, bool withTouchpad) {
+    for (int frame = 0; frame < options.frames; frame++) {
+        MakeCodecFrame(&g_codecFrames[frame], frame, withSensor, withTouchpad);
+    }
+
+    InputEncoder encoder;
+    InputDecoder decoder;
+    Uint64 totalBytes = 0;
+    size_t maxBytes = 0;
+
+    Uint64 allocStart = GetAllocCount();
+    Uint64 start = SDL_GetTicksNS();
+    for (int frame = 0; frame < options.frames; frame++) {
+        g_packetSizes[frame] = encoder.Encode(g_codecFrames[frame], g_packets[frame], sizeof(g_packets[frame]));
+    }
+    Uint64 encodeNS = SDL_GetTicksNS() - start;
+
+    RecordedFrame decoded;
+    start = SDL_GetTicksNS();
+    for (int frame = 0; frame < options.frames; frame++) {
+        if (decoder.Decode(g_packets[frame], g_packetSizes[frame], &decoded)) g_sink += decoded.state.buttons;
+    }
+    Uint64 decodeNS = SDL_GetTicksNS() - start;
+    Uint64 allocs = GetAllocCount() - allocStart;
+
+    for (int frame = 0; frame < options.frames; frame++) {
+        totalBytes += g_packetSizes[frame];
+        maxBytes = std::max(maxBytes, g_packetSizes[frame]);
+    }
+
+    CodecResult* pResult = &g_codecResults[g_codecResultCount++];
+    *pResult = {};
+    SDL_snprintf(pResult->name, sizeof(pResult->name), "%s", pName);
+    pResult->encodeNsPerFrame = static_cast<double>(encodeNS) / options.frames;
+    pResult->decodeNsPerFrame = static_cast<double>(decodeNS) / options.frames;
+    pResult->bytesPerFrameAvg = static_cast<double>(totalBytes) / options.frames;
+    pResult->bytesPerFrameMax = static_cast<int>(maxBytes);
+    pResult->rawBytesPerFrame = static_cast<int>(sizeof(GamepadState) +
+        (withSensor ? sizeof(SensorData) : 0) + (withTouchpad ? sizeof(TouchpadData) : 0));
+    pResult->allocsPerFrame = static_cast<double>(allocs) / (2.0 * options.frames);
+}
+
+//==============================================================================
+// R}h͂̔Fio^Ƃ Update() 𑪂j
+//==============================================================================
+namespace {
+    // o^p̃R}hi4 菇A̕тƎtԂԍςj
+    void MakeMotionCommand(int index, MotionStep* pSteps, MotionWindow* pWindow) {
+        static const Uint16 DIRECTIONS[] = {
+            MotionDir::DOWN, MotionDir::DOWN_FORWARD, MotionDir::FORWARD, MotionDir::UP_FORWARD,
+            MotionDir::UP, MotionDir::UP_BACK, MotionDir::BACK, MotionDir::DOWN_BACK,
+        };
+        static const uint32_t BUTTONS[] = { BUTTON_MASK_DOWN, BUTTON_MASK_RIGHT, BUTTON_MASK_LEFT, BUTTON_MASK_UP };
+
+        int first = index % 8;
+        int turn = (index / 8) % 2 ? 7 : 1;
+        if (index % 16 == 15) {
+            pSteps[0] = MotionStep::Charge(MotionDir::ANY_BACK, 30);
+        }
+        else {
+            pSteps[0] = MotionStep::Dir(DIRECTIONS[first]);
+        }
+        pSteps[1] = MotionStep::Dir(DIRECTIONS[(first + turn) % 8]);
+        pSteps[2] = MotionStep::Dir(DIRECTIONS[(first + turn * 2) % 8]);
+        pSteps[3] = MotionStep::Button(BUTTONS[index % 4]);
+        *pWindow = (index % 3 == 2) ? MotionWindow::Nanoseconds(400000000) : MotionWindow::Frames(20 + index % 20);
+    }
+
+    // XeBbN 4 t[Ƃ 45 x񂵁i64 t[Ƃɋt]AX߂jA
+    // {^ 8 t[Ƃɏɉ
+    void MakeMotionFrame(GamepadState* pState, int frame) {
+        *pState = {};
+        int sector = ((frame / 64) % 2 ? -1 : 1) * (frame / 4);
+        if ((frame / 4) % 9 != 8) {
+            float angle = sector * 0.785398f;
+            pState->leftStickX = std::cos(angle);
+            pState->leftStickY = std::sin(angle);
+        }
+
+        static const uint32_t BUTTONS[] = { BUTTON_MASK_DOWN, BUTTON_MASK_RIGHT, BUTTON_MASK_LEFT, BUTTON_MASK_UP };
+        if (frame % 8 == 0) pState->buttons = BUTTONS[(frame / 8) % 4];
+        pState->UpdateEdges((frame % 8 == 1) ? BUTTONS[(frame / 8) % 4] : 0);
+    }
+}
+
+static void BenchMotionCommands(const Options& options, int commands) {
+    MotionCommandRecognizer recognizer;
+    for (int i = 0; i < commands; i++) {
+        MotionStep steps[4];
+        MotionWindow window;
+        MakeMotionCommand(i, steps, &window);
+        recognizer.Register(i, steps, 4, window);
+    }
+
+    int triggered = 0;
+    Uint64 allocStart = GetAllocCount();
+    for (int frame = 0; frame < options.frames; frame++) {
+        GamepadState state;
+        MakeMotionFrame(&state, frame);
+        Uint64 timestampNS = 1000000000ull + static_cast<Uint64>(frame) * 16666667ull;
+
+        Uint64 start = SDL_GetTicksNS();
+        recognizer.Update(state, timestampNS);
+        g_frameTimes[frame] = SDL_GetTicksNS() - start;
+        triggered += SDL_CountOneBits(static_cast<Uint32>(recognizer.GetTriggered())) +
+            SDL_CountOneBits(static_cast<Uint32>(recognizer.GetTriggered() >> 32));
+    }
+    Uint64 allocs = GetAllocCount() - allocStart;
+
+    Uint64 total = 0;
+    for (int frame = 0; frame < options.frames; frame++) total += g_frameTimes[frame];
+    std::sort(g_frameTimes, g_frameTimes + options.frames);
+
+    MotionResult* pResult = &g_motionResults[g_motionResultCount++];
+    *pResult = {};
+    pResult->commands = commands;
+    pResult->nsPerFrameAvg = static_cast<double>(total) / options.frames;
+    pResult->nsPerFrameP99 = static_cast<double>(g_frameTimes[(options.frames - 1) * 99 / 100]);
+    pResult->allocsPerFrame = static_cast<double>(allocs) / options.frames;
+    pResult->triggered = triggered;
+}
+
+//==============================================================================
+// NԁǐĂяoubN鎞ԁA}bsO̎荞ݍ݁j
+//==============================================================================
+namespace {
+    constexpr int GENERATED_MAPPING_COUNT = 3000;
+    const char* const GENERATED_MAPPINGS_PATH = "benchmark_mappings.txt";
+    const char* const MAPPING_CACHE_PATH = "benchmark_mappings.cache";
+    const char* const MAPPING_PLATFORMS[] = { "Windows", "macOS", "Linux" };
+
+    // ɂqgƂĒu}bsOi GUID Ƃ͏dȂȂj
+    const char* const SENTINEL_GUID = "03000000ffff0000ffff000000000000";
+    const char* const SENTINEL_MAPPING = "03000000ffff0000ffff000000000000,Benchmark Sentinel,a:b0,b:b1,";
+
+    Uint64 g_readyTimes[MAX_FRAMES];
+    bool g_mappingCheckFailed = false;
+
+    // 3 vbgtH[̍sƁA1 قǂ̓ GUID ̏㏑
+    bool GenerateMappings(const char* pPath) {
+        SDL_IOStream* pStream = SDL_IOFromFile(pPath, "wb");
+        if (!pStream) return false;
+
+        SDL_IOprintf(pStream, "# Benchmark mappings\n");
+        for (int i = 0; i < GENERATED_MAPPING_COUNT; i++) {
+            int device = (i % 10 == 9) ? i / 2 : i;
+            SDL_IOprintf(pStream,
+                "03000000%04x0000%04x0000%08x,Benchmark Pad %d,a:b0,b:b1,x:b2,y:b3,back:b6,guide:b8,start:b7,"
+                "leftstick:b9,rightstick:b10,leftshoulder:b4,rightshoulder:b5,dpup:h0.1,dpdown:h0.4,dpleft:h0.8,"
+                "dpright:h0.2,leftx:a0,lefty:a1,rightx:a3,righty:a4,lefttrigger:a2,righttrigger:a5,platform:%s,\n",
+                0x2000 + device % 64, 0x3000 + device / 64, device, device,
+                MAPPING_PLATFORMS[device % SDL_arraysize(MAPPING_PLATFORMS)]);
+        }
+        return SDL_CloseIO(pStream);
+    }
+
+    int CountGamepadMappings() {
+        int count = 0;
+        char** ppMappings = SDL_GetGamepadMappings(&count);
+        SDL_free(ppMappings);
+        return ppMappings ? count : 0;
+    }
+
+    bool HasGamepadMapping(const char* pGUID) {
+        char* pMapping = SDL_GetGamepadMappingForGUID(SDL_StringToGUID(pGUID));
+        SDL_free(pMapping);
+        return pMapping != nullptr;
+    }
+
+    // LbVOÊǂł荞܂邩m߂B
+    // }bsO GUID dȂȂ̂ŁALbV̐ƈv
+    void CheckMappingCache(const char* pTextPath, int expected, bool exact,
+                           StartupResult* pBeforeInit, StartupResult* pAfterInit) {
+        // ɂqgƂĒuiϐĂu悤 OVERRIDEj
+        SDL_SetHintWithPriority(SDL_HINT_GAMECONTROLLERCONFIG, SENTINEL_MAPPING, SDL_HINT_OVERRIDE);
+        SDL_Init(SDL_INIT_GAMEPAD);
+        int baseline = CountGamepadMappings();
+        SDL_QuitSubSystem(SDL_INIT_GAMEPAD);
+
+        // OFqgc܂ܑ
+        MappingCache::Apply(MAPPING_CACHE_PATH, pTextPath);
+        SDL_Init(SDL_INIT_GAMEPAD);
+        bool hintKept = HasGamepadMapping(SENTINEL_GUID);
+        pBeforeInit->loaded = CountGamepadMappings() - baseline + (hintKept ? 0 : 1);
+        SDL_QuitSubSystem(SDL_INIT_GAMEPAD);
+        SDL_SetHintWithPriority(SDL_HINT_GAMECONTROLLERCONFIG, SENTINEL_MAPPING, SDL_HINT_OVERRIDE);
+
+        // FǉƂēo^
+        SDL_Init(SDL_INIT_GAMEPAD);
+        MappingCache::Apply(MAPPING_CACHE_PATH, pTextPath);
+        pAfterInit->loaded = CountGamepadMappings() - baseline;
+        SDL_QuitSubSystem(SDL_INIT_GAMEPAD);
+        SDL_ResetHint(SDL_HINT_GAMECONTROLLERCONFIG);
+
+        bool ok = hintKept && pBeforeInit->loaded > 0 && pAfterInit->loaded > 0;
+        if (exact) {
+            ok = ok && pBeforeInit->loaded == expected && pAfterInit->loaded == expected;
+        }
+        if (!ok) {
+            fprintf(stderr, "mapping cache check failed: expected %d, before init %d (hint %s), after init %d\n",
+                expected, pBeforeInit->loaded, hintKept ? "kept" : "lost", pAfterInit->loaded);
+            g_mappingCheckFailed = true;
+        }
+    }
+
+    StartupResult* AddStartupResult(const char* pName, int iterations, int mappings) {
+        StartupResult* pResult = &g_startupResults[g_startupResultCount++];
+        *pResult = {};
+        SDL_snprintf(pResult->name, sizeof(pResult->name), "%s", pName);
+        pResult->iterations = iterations;
+        pResult->mappings = mappings;
+
+        Uint64 total = 0;
+        Uint64 maxNS = 0;
+        for (int i = 0; i < iterations; i++) {
+            total += g_frameTimes[i];
+            maxNS = std::max(maxNS, g_frameTimes[i]);
+        }
+        pResult->nsAvg = static_cast<double>(total) / iterations;
+        pResult->nsMax = static_cast<double>(maxNS);
+        return pResult;
+    }
+}
+
+static void BenchStartup(const Options& options) {
+    const int iterations = options.startupIterations;
+
+    // 
+    for (int i = 0; i < iterations; i++) {
+        Uint64 start = SDL_GetTicksNS();
+        GameController::Initialize();
+        g_frameTimes[i] = SDL_GetTicksNS() - start;
+        GameController::Finalize();
+    }
+    AddStartupResult("Startup/Initialize", iterations, 0);
+
+    // 񓯊iĂяo߂܂ / Update() Ŋ󂯎܂Łj
+    for (int i = 0; i < iterations; i++) {
+        Uint64 start = SDL_GetTicksNS();
+        GameController::InitializeAsync();
+        g_frameTimes[i] = SDL_GetTicksNS() - start;
+
+        while (GameController::GetInitStatus() == InitStatus::Pending) {
+            GameController::Update();
+            SDL_DelayNS(100 * SDL_NS_PER_US);
+        }
+        g_readyTimes[i] = SDL_GetTicksNS() - start;
+        GameController::Finalize();
+    }
+    AddStartupResult("Startup/InitializeAsync/call", iterations, 0);
+    std::copy(g_readyTimes, g_readyTimes + iterations, g_frameTimes);
+    AddStartupResult("Startup/InitializeAsync/ready", iterations, 0);
+
+    // }bsOieLXg͂ / LbVnj
+    const char* pTextPath = options.pMappingsPath;
+    if (!pTextPath) {
+        if (!GenerateMappings(GENERATED_MAPPINGS_PATH)) return;
+        pTextPath = GENERATED_MAPPINGS_PATH;
+    }
+
+    int textMappings = 0;
+    for (int i = 0; i < iterations; i++) {
+        Uint64 start = SDL_GetTicksNS();
+        SDL_Init(SDL_INIT_GAMEPAD);
+        textMappings = SDL_AddGamepadMappingsFromFile(pTextPath);
+        g_frameTimes[i] = SDL_GetTicksNS() - start;
+        SDL_QuitSubSystem(SDL_INIT_GAMEPAD);
+    }
+    AddStartupResult("Startup/SDL_Init+mappings(text)", iterations, textMappings);
+
+    int cacheMappings = 0;
+    for (int i = 0; i < iterations; i++) {
+        SDL_RemovePath(MAPPING_CACHE_PATH);
+        Uint64 start = SDL_GetTicksNS();
+        cacheMappings = MappingCache::Build(pTextPath, MAPPING_CACHE_PATH);
+        g_frameTimes[i] = SDL_GetTicksNS() - start;
+    }
+    AddStartupResult("Startup/MappingCache::Build", iterations, cacheMappings);
+
+    for (int i = 0; i < iterations; i++) {
+        Uint64 start = SDL_GetTicksNS();
+        MappingCache::Apply(MAPPING_CACHE_PATH, pTextPath);
+        SDL_Init(SDL_INIT_GAMEPAD);
+        g_frameTimes[i] = SDL_GetTicksNS() - start;
+        SDL_QuitSubSystem(SDL_INIT_GAMEPAD);
+        SDL_ResetHint(SDL_HINT_GAMECONTROLLERCONFIG);
+    }
+    StartupResult* pBeforeInit = AddStartupResult("Startup/SDL_Init+mappings(cache)", iterations, cacheMappings);
+
+    // ɓniǉƂēo^j
+    for (int i = 0; i < iterations; i++) {
+        SDL_Init(SDL_INIT_GAMEPAD);
+        Uint64 start = SDL_GetTicksNS();
+        MappingCache::Apply(MAPPING_CACHE_PATH, pTextPath);
+        g_frameTimes[i] = SDL_GetTicksNS() - start;
+        SDL_QuitSubSystem(SDL_INIT_GAMEPAD);
+    }
+    StartupResult* pAfterInit = AddStartupResult("Startup/mappings(cache, after init)", iterations, cacheMappings);
+
+    CheckMappingCache(pTextPath, cacheMappings, !options.pMappingsPath, pBeforeInit, pAfterInit);
+
+    SDL_RemovePath(MAPPING_CACHE_PATH);
+    if (!options.pMappingsPath) SDL_RemovePath(GENERATED_MAPPINGS_PATH);
+}
+
+//==============================================================================
+// ANZTiIsPressed_* / IsTrigger_* / IsRelease_*j
+//==============================================================================
+#define BENCH_ACCESSORS(KIND) \
+    GameController::KIND##_ButtonDown() + GameController::KIND##_ButtonRight() + \
+    GameController::KIND##_ButtonLeft() + GameController::KIND##_ButtonUp() + \
+    GameController::KIND##_L1() + GameController::KIND##_R1() + \
+    GameController::KIND##_L2() + GameController::KIND##_R2() + \
+    GameController::KIND##_L3() + GameController::KIND##_R3() + \
+    GameController::KIND##_Start() + GameController::KIND##_Select() + \
+    GameController::KIND##_Guide() + GameController::KIND##_Misc() + \
+    GameController::KIND##_DpadUp() + GameController::KIND##_DpadDown() + \
+    GameController::KIND##_DpadLeft() + GameController::KIND##_DpadRight()
+
+static double BenchAccessors() {
+    constexpr int ACCESSORS_PER_ITERATION = 18 * 3 + 1;
+
+    Uint64 start = SDL_GetTicksNS();
+    int sum = 0;
+    for (int i = 0; i < ACCESSOR_ITERATIONS; i++) {
+        sum += BENCH_ACCESSORS(IsPressed);
+        sum += BENCH_ACCESSORS(IsTrigger);
+        sum += BENCH_ACCESSORS(IsRelease);
+        sum += GameController::IsAnyButtonPressed();
+        g_sink = sum;
+    }
+    Uint64 elapsed = SDL_GetTicksNS() - start;
+
+    return static_cast<double>(elapsed) / (static_cast<double>(ACCESSOR_ITERATIONS) * ACCESSORS_PER_ITERATION);
+}
+
+//==============================================================================
+// JSON o
+//==============================================================================
+static void WriteJson(FILE* pFile, double nsPerAccessor) {
+    fprintf(pFile, "{\n");
+    fprintf(pFile, "  \"platform\": \"%s\",\n", SDL_GetPlatform());
+    fprintf(pFile, "  \"ns_per_accessor\": %.3f,\n", nsPerAccessor);
+    fprintf(pFile, "  \"results\": [\n");
+    for (int i = 0; i < g_resultCount; i++) {
+        const Result& r = g_results[i];
+        fprintf(pFile,
+            "    { \"name\": \"%s\", \"pads\": %d, \"ns_per_frame_avg\": %.1f, \"ns_per_frame_p99\": %.1f, "
+            "\"ns_per_frame_max\": %.1f, \"events_per_sec\": %.1f, \"allocs_per_frame\": %.3f }%s\n",
+            r.name, r.pads, r.nsPerFrameAvg, r.nsPerFrameP99, r.nsPerFrameMax,
+            r.eventsPerSec, r.allocsPerFrame, (i + 1 < g_resultCount) ? "," : "");
+    }
+    fprintf(pFile, "  ],\n");
+    fprintf(pFile, "  \"codec\": [\n");
+    for (int i = 0; i < g_codecResultCount; i++) {
+        const CodecResult& r = g_codecResults[i];
+        fprintf(pFile,
+            "    { \"name\": \"%s\", \"encode_ns_per_frame\": %.1f, \"decode_ns_per_frame\": %.1f, "
+            "\"bytes_per_frame_avg\": %.2f, \"bytes_per_frame_max\": %d, \"raw_bytes_per_frame\": %d, "
+            "\"allocs_per_frame\": %.3f }%s\n",
+            r.name, r.encodeNsPerFrame, r.decodeNsPerFrame, r.bytesPerFrameAvg, r.bytesPerFrameMax,
+            r.rawBytesPerFrame, r.allocsPerFrame, (i + 1 < g_codecResultCount) ? "," : "");
+    }
+    fprintf(pFile, "  ],\n");
+    fprintf(pFile, "  \"startup\": [\n");
+    for (int i = 0; i < g_startupResultCount; i++) {
+        const StartupResult& r = g_startupResults[i];
+        fprintf(pFile,
+            "    { \"name\": \"%s\", \"iterations\": %d, \"ns_avg\": %.1f, \"ns_max\": %.1f, \"mappings\": %d, \"loaded\": %d }%s\n",
+            r.name, r.iterations, r.nsAvg, r.nsMax, r.mappings, r.loaded, (i + 1 < g_startupResultCount) ? "," : "");
+    }
+    fprintf(pFile, "  ],\n");
+    fprintf(pFile, "  \"motion\": [\n");
+    for (int i = 0; i < g_motionResultCount; i++) {
+        const MotionResult& r = g_motionResults[i];
+        fprintf(pFile,
+            "    { \"name\": \"MotionCommandRecognizer::Update\", \"commands\": %d, \"ns_per_frame_avg\": %.1f, "
+            "\"ns_per_frame_p99\": %.1f, \"allocs_per_frame\": %.3f, \"triggered\": %d }%s\n",
+            r.commands, r.nsPerFrameAvg, r.nsPerFrameP99, r.allocsPerFrame, r.triggered,
+            (i + 1 < g_motionResultCount) ? "," : "");
+    }
+    fprintf(pFile, "  ]\n");
+    fprintf(pFile, "}\n");
+}
+
+//==============================================================================
+// Gg|Cg
+//==============================================================================
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--pads") && i + 1 < argc) {
+            options.maxPads = std::max(1, std::min(MAX_PADS, atoi(argv[++i])));
+        } else if (!strcmp(argv[i], "--frames") && i + 1 < argc) {
+            options.frames = std::max(1, std::min(MAX_FRAMES, atoi(argv[++i])));
+        } else if (!strcmp(argv[i], "--startup") && i + 1 < argc) {
+            options.startupIterations = std::max(1, std::min(MAX_FRAMES, atoi(argv[++i])));
+        } else if (!strcmp(argv[i], "--mappings") && i + 1 < argc) {
+            options.pMappingsPath = argv[++i];
+        } else if (!strcmp(argv[i], "--json") && i + 1 < argc) {
+            options.pJsonPath = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--pads N] [--frames N] [--startup N] [--mappings PATH] [--json PATH]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // SDL ̊mۂ𐔂邽߁AOɍւ
+    InstallAllocCounter();
+
+    // ̌v SDL ς݂ɂȂȂ悤Aŏɑ
+    BenchStartup(options);
+
+    // 1, 2, 4, ... Ɣ{ɂĂAŌ maxPads Ōv
+    for (int pads = 1; ; pads = std::min(pads * 2, options.maxPads)) {
+        BenchGameController(options, pads, InputMode::Polling, "GameController::Update/polling");
+        BenchGameController(options, pads, InputMode::Event, "GameController::Update/event");
+        BenchGamepadManager(options, pads);
+        if (pads == options.maxPads) break;
+    }
+
+    double nsPerAccessor = BenchAccessors();
+
+    BenchInputCodec(options, "InputCodec/state", false, false);
+    BenchInputCodec(options, "InputCodec/state+sensor", true, false);
+    BenchInputCodec(options, "InputCodec/state+sensor+touch", true, true);
+
+    for (int commands = 1; commands <= MotionCommandRecognizer::MAX_COMMANDS; commands *= 4) {
+        BenchMotionCommands(options, commands);
+    }
+
+    FILE* pFile = stdout;
+    if (options.pJsonPath) {
+        pFile = fopen(options.pJsonPath, "w");
+        if (!pFile) {
+            fprintf(stderr, "cannot open %s\n", options.pJsonPath);
+            return 1;
+        }
+    }
+    WriteJson(pFile, nsPerAccessor);
+    if (pFile != stdout) fclose(pFile);
+
+    SDL_Quit();
+    return g_mappingCheckFailed ? 1 : 0;
+}
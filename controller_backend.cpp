@@ -0,0 +1,698 @@
+/*********************************************************************
+ * \file   controller_backend.cpp
+ * \brief  ControllerCore ̃obNGhiSDL foCX /  / vCj
+ *********************************************************************/
+#include "controller_backend.h"
+#include "mapping_cache.h"
+#include "output_writer.h"
+
+//==============================================================================
+// 萔`
+//==============================================================================
+namespace {
+    constexpr int PEEP_BATCH_SIZE = 64;
+
+    //  WaitForInput() m߂Ԋu
+    constexpr Sint32 INIT_WAIT_SLICE_MS = 1;
+
+    // ̓Xbh쒆 WaitForInput() Om߂ŒZ̊Ԋu
+    constexpr Uint64 MIN_WAIT_SLICE_NS = 250 * SDL_NS_PER_US;
+
+    // |[O{^iSOUTH ` MISC1j
+    constexpr int BUTTON_POLL_COUNT = ButtonAxisState::BUTTON_POLL_COUNT;
+
+    ControllerType ToControllerType(SDL_GamepadType type) {
+        switch (type) {
+        case SDL_GAMEPAD_TYPE_XBOX360:
+            return ControllerType::Xbox360;
+        case SDL_GAMEPAD_TYPE_XBOXONE:
+            return ControllerType::XboxOne;
+        case SDL_GAMEPAD_TYPE_PS4:
+            return ControllerType::PS4;
+        case SDL_GAMEPAD_TYPE_PS5:
+            return ControllerType::PS5;
+        case SDL_GAMEPAD_TYPE_NINTENDO_SWITCH_PRO:
+            return ControllerType::NintendoSwitch;
+        case SDL_GAMEPAD_TYPE_NINTENDO_SWITCH_JOYCON_LEFT:
+            return ControllerType::NintendoSwitchJoyconLeft;
+        case SDL_GAMEPAD_TYPE_NINTENDO_SWITCH_JOYCON_RIGHT:
+            return ControllerType::NintendoSwitchJoyconRight;
+        case SDL_GAMEPAD_TYPE_NINTENDO_SWITCH_JOYCON_PAIR:
+            return ControllerType::NintendoSwitchJoyconPair;
+        default:
+            return ControllerType::Other;
+        }
+    }
+
+    BatteryInfo MakeBatteryInfo(SDL_PowerState state, int percent) {
+        BatteryInfo info = {};
+        info.hasBatteryInfo = (state != SDL_POWERSTATE_UNKNOWN);
+        info.percent = percent;
+
+        switch (state) {
+        case SDL_POWERSTATE_ON_BATTERY:
+            info.isWired = false;
+            if (percent > 70) info.levelText = "Full";
+            else if (percent > 40) info.levelText = "Medium";
+            else if (percent > 10) info.levelText = "Low";
+            else info.levelText = "Empty";
+            break;
+        case SDL_POWERSTATE_CHARGING:
+            info.isWired = true;
+            info.levelText = "Charging";
+            break;
+        case SDL_POWERSTATE_CHARGED:
+            info.isWired = true;
+            info.percent = 100;
+            info.levelText = "Charged";
+            break;
+        case SDL_POWERSTATE_NO_BATTERY:
+            info.isWired = true;
+            info.percent = 100;
+            info.levelText = "Wired";
+            break;
+        default:
+            info.levelText = "Unknown";
+            break;
+        }
+
+        return info;
+    }
+
+    // iSDL_GetTicksNS j܂ł̑҂ԁi~bA؂グj
+    Sint32 ToTimeoutMS(Uint64 deadlineNS) {
+        Uint64 nowNS = SDL_GetTicksNS();
+        if (deadlineNS <= nowNS) return 0;
+
+        Uint64 timeoutMS = (deadlineNS - nowNS + SDL_NS_PER_MS - 1) / SDL_NS_PER_MS;
+        return static_cast<Sint32>(SDL_min(timeoutMS, static_cast<Uint64>(SDL_MAX_SINT32)));
+    }
+}
+
+//==============================================================================
+// SDLFEI
+//==============================================================================
+bool SdlControllerBackend::Initialize() {
+    if (!InitializeSubsystem()) {
+        return false;
+    }
+
+    FinishInitialize();
+    return true;
+}
+
+// }bsO͗񋓂ɓnĂiNɌfoCXւ̂܂܎gj
+bool SdlControllerBackend::InitializeSubsystem() {
+    if (m_mappingCachePath[0]) {
+        MappingCache::Apply(m_mappingCachePath, m_mappingTextPath[0] ? m_mappingTextPath : nullptr);
+    }
+    return SDL_Init(SDL_INIT_GAMEPAD);
+}
+
+void SdlControllerBackend::FinishInitialize() {
+    // LEDEȔ݃XbhisĂ݂œj
+    OutputWriter::Initialize();
+
+    // ڑς݂̃foCXo^\Ɏ荞݁A擪̃XbgJ
+    m_registry.Clear();
+    m_registry.ScanConnected();
+    OpenFirstConnected();
+}
+
+void SdlControllerBackend::Finalize() {
+    // ȂƃXbh҂Aςł SDL ̏߂
+    if (m_pInitThread) {
+        SDL_WaitThread(m_pInitThread, nullptr);
+        m_pInitThread = nullptr;
+        if (m_initStatus.exchange(InitStatus::NotStarted, std::memory_order_acq_rel) == InitStatus::Ready) {
+            SDL_QuitSubSystem(SDL_INIT_GAMEPAD);
+        }
+        return;
+    }
+
+    m_initStatus.store(InitStatus::NotStarted, std::memory_order_release);
+    StopInputThread();
+    Close();
+    m_registry.Clear();
+    OutputWriter::Finalize();
+    SDL_QuitSubSystem(SDL_INIT_GAMEPAD);
+}
+
+void SdlControllerBackend::SetMappingCache(const char* pCachePath, const char* pTextPath) {
+    SDL_strlcpy(m_mappingCachePath, pCachePath ? pCachePath : "", MAPPING_PATH_SIZE);
+    SDL_strlcpy(m_mappingTextPath, pTextPath ? pTextPath : "", MAPPING_PATH_SIZE);
+}
+
+//==============================================================================
+// SDLF񓯊
+//==============================================================================
+bool SdlControllerBackend::BeginInitialize() {
+    if (m_pInitThread) return true;
+
+    m_initStatus.store(InitStatus::Pending, std::memory_order_release);
+    m_pInitThread = SDL_CreateThread(InitThreadMain, "GameControllerInit", this);
+    if (!m_pInitThread) {
+        m_initStatus.store(InitStatus::NotStarted, std::memory_order_release);
+        return false;
+    }
+    return true;
+}
+
+int SDLCALL SdlControllerBackend::InitThreadMain(void* pUserData) {
+    SdlControllerBackend* pBackend = static_cast<SdlControllerBackend*>(pUserData);
+    bool ok = pBackend->InitializeSubsystem();
+    pBackend->m_initStatus.store(ok ? InitStatus::Ready : InitStatus::Failed, std::memory_order_release);
+    return 0;
+}
+
+InitStatus SdlControllerBackend::PollInitialize() {
+    InitStatus status = m_initStatus.load(std::memory_order_acquire);
+    if (!m_pInitThread || status == InitStatus::Pending) return status;
+
+    SDL_WaitThread(m_pInitThread, nullptr);
+    m_pInitThread = nullptr;
+    if (status == InitStatus::Ready) {
+        FinishInitialize();
+    }
+    return status;
+}
+
+//==============================================================================
+// SDLFQ[pbhJE
+//==============================================================================
+bool SdlControllerBackend::Open(SDL_JoystickID id) {
+    if (m_pGamepad) return false;
+
+    m_pGamepad = SDL_OpenGamepad(id);
+    if (!m_pGamepad) return false;
+
+    m_gamepadId = id;
+    m_outputSlot = OutputWriter::Register(m_pGamepad);
+    RefreshDeviceInfo();
+
+    // vC[ԍ͓o^\̃XbgiĐڑĂςȂj
+    int slot = m_registry.FindSlot(id);
+    if (slot >= 0) {
+        SDL_SetGamepadPlayerIndex(m_pGamepad, slot);
+    }
+    return true;
+}
+
+// o^\̐擪ĴTBREMOVED ܂͂ĂȂؒfς݂
+// foCX͊JȂ̂ŁÃXbg
+bool SdlControllerBackend::OpenFirstConnected() {
+    for (int slot = 0; slot < DeviceRegistry::MAX_SLOTS; slot++) {
+        if (m_registry.IsConnected(slot) && Open(m_registry.GetId(slot))) return true;
+    }
+    return false;
+}
+
+void SdlControllerBackend::Close() {
+    if (!m_pGamepad) return;
+
+    OutputWriter::Unregister(m_outputSlot);
+    m_outputSlot = -1;
+    SDL_CloseGamepad(m_pGamepad);
+    m_pGamepad = nullptr;
+    m_gamepadId = 0;
+    m_deviceInfo = DeviceInfo();
+}
+
+//==============================================================================
+// SDLFڑnTv
+//==============================================================================
+Uint32 SdlControllerBackend::HandleDeviceSample(const InputSample& sample) {
+    switch (sample.type) {
+    case SDL_EVENT_GAMEPAD_ADDED:
+        m_registry.OnAdded(sample.which);
+        if (!m_pGamepad && (Open(sample.which) || OpenFirstConnected())) {
+            return DEVICE_CHANGE_OPENED;
+        }
+        break;
+
+    case SDL_EVENT_GAMEPAD_REMOVED: {
+        m_registry.OnRemoved(sample.which);
+
+        Uint32 change = DEVICE_CHANGE_NONE;
+        if (m_pGamepad && sample.which == m_gamepadId) {
+            Close();
+            change |= DEVICE_CHANGE_CLOSED;
+        }
+
+        // o^\ɎcĂʂ̃foCX֐؂ւimۂȂjB
+        // O̐؂ւŊJȂꍇł蒼
+        if (!m_pGamepad && OpenFirstConnected()) {
+            change |= DEVICE_CHANGE_OPENED;
+        }
+        return change;
+    }
+
+    case SDL_EVENT_GAMEPAD_REMAPPED:
+        if (m_pGamepad && sample.which == m_gamepadId) {
+            RefreshDeviceInfo();
+        }
+        break;
+
+    case SDL_EVENT_JOYSTICK_BATTERY_UPDATED:
+        if (m_pGamepad && sample.which == m_gamepadId) {
+            // index  SDL_PowerStateiERROR = -1 ܂ށj Uint8 ɋl߂
+            m_deviceInfo.battery = MakeBatteryInfo(
+                static_cast<SDL_PowerState>(static_cast<Sint8>(sample.index)), sample.value);
+        }
+        break;
+    }
+    return DEVICE_CHANGE_NONE;
+}
+
+//==============================================================================
+// SDLFfoCX̎擾iڑE}bv̂݁j
+//==============================================================================
+void SdlControllerBackend::RefreshDeviceInfo() {
+    DeviceInfo info;
+
+    const char* name = SDL_GetGamepadName(m_pGamepad);
+    SDL_strlcpy(info.name, name ? name : "Unknown", sizeof(info.name));
+    info.type = ToControllerType(SDL_GetGamepadType(m_pGamepad));
+
+    info.hasLED = SDL_GetBooleanProperty(
+        SDL_GetGamepadProperties(m_pGamepad),
+        SDL_PROP_GAMEPAD_CAP_RGB_LED_BOOLEAN, false);
+    info.hasGyro = SDL_GamepadHasSensor(m_pGamepad, SDL_SENSOR_GYRO);
+    info.hasAccel = SDL_GamepadHasSensor(m_pGamepad, SDL_SENSOR_ACCEL);
+    info.numTouchpads = SDL_GetNumGamepadTouchpads(m_pGamepad);
+    info.hasTouchpad = (info.numTouchpads > 0);
+
+    int percent = 0;
+    SDL_PowerState state = SDL_GetGamepadPowerInfo(m_pGamepad, &percent);
+    info.battery = MakeBatteryInfo(state, percent);
+
+    m_deviceInfo = info;
+}
+
+int SdlControllerBackend::GetPlayerIndex() const {
+    if (!m_pGamepad) return -1;
+    return SDL_GetGamepadPlayerIndex(m_pGamepad);
+}
+
+//==============================================================================
+// SDLFfoCX璼ړǂݎ
+//==============================================================================
+void SdlControllerBackend::Poll(uint32_t* pButtons, Sint16* pAxes) const {
+    uint32_t buttons = 0;
+    for (int i = 0; i < BUTTON_POLL_COUNT; i++) {
+        buttons |= static_cast<uint32_t>(
+            SDL_GetGamepadButton(m_pGamepad, static_cast<SDL_GamepadButton>(i))) << i;
+    }
+    *pButtons = buttons;
+
+    for (int i = 0; i < SDL_GAMEPAD_AXIS_COUNT; i++) {
+        pAxes[i] = SDL_GetGamepadAxis(m_pGamepad, static_cast<SDL_GamepadAxis>(i));
+    }
+}
+
+void SdlControllerBackend::PollTouchpad(TouchpadData* pOut) const {
+    *pOut = {};
+    pOut->numTouchpads = m_deviceInfo.numTouchpads;
+    pOut->hasTouchpad = m_deviceInfo.hasTouchpad;
+
+    Uint64 nowNS = SDL_GetTicksNS();
+    int numTouchpads = SDL_min(m_deviceInfo.numTouchpads, TouchpadData::MAX_TOUCHPADS);
+    for (int pad = 0; pad < numTouchpads; pad++) {
+        int numFingers = SDL_min(SDL_GetNumGamepadTouchpadFingers(m_pGamepad, pad), TouchpadData::MAX_FINGERS);
+        for (int i = 0; i < numFingers; i++) {
+            TouchpadData::Finger& finger = pOut->fingers[pad][i];
+            SDL_GetGamepadTouchpadFinger(m_pGamepad, pad, i, &finger.down, &finger.x, &finger.y, &finger.pressure);
+            finger.timestampNS = nowNS;
+        }
+    }
+}
+
+//==============================================================================
+// SDLFZT[ELED
+//==============================================================================
+SensorData SdlControllerBackend::ReadSensorData() const {
+    SensorData data = {};
+    if (!m_pGamepad) return data;
+
+    data.hasGyro = m_deviceInfo.hasGyro;
+    data.hasAccel = m_deviceInfo.hasAccel;
+
+    float gyro[3] = {};
+    float accel[3] = {};
+
+    if (data.hasGyro) {
+        SDL_GetGamepadSensorData(m_pGamepad, SDL_SENSOR_GYRO, gyro, 3);
+        data.gyroX = gyro[0];
+        data.gyroY = gyro[1];
+        data.gyroZ = gyro[2];
+    }
+
+    if (data.hasAccel) {
+        SDL_GetGamepadSensorData(m_pGamepad, SDL_SENSOR_ACCEL, accel, 3);
+        data.accelX = accel[0];
+        data.accelY = accel[1];
+        data.accelZ = accel[2];
+    }
+
+    return data;
+}
+
+bool SdlControllerBackend::EnableSensor(SDL_SensorType type, bool enable) {
+    if (!m_pGamepad) return false;
+    return SDL_SetGamepadSensorEnabled(m_pGamepad, type, enable);
+}
+
+float SdlControllerBackend::GetSensorDataRate(SDL_SensorType type) const {
+    if (!m_pGamepad) return 0.0f;
+    return SDL_GetGamepadSensorDataRate(m_pGamepad, type);
+}
+
+// o̓XbhɓnŃubNȂiĂȂΓ݁j
+bool SdlControllerBackend::SetLED(uint8_t r, uint8_t g, uint8_t b) {
+    if (!m_pGamepad) return false;
+    if (OutputWriter::SubmitLED(m_outputSlot, r, g, b)) return true;
+    return SDL_SetGamepadLED(m_pGamepad, r, g, b);
+}
+
+//==============================================================================
+// SDLFxb`Eҋ@
+//==============================================================================
+// m_pGamepad ͕ʃXbhŕtւ̂Ŏg킸AbN̓ id 
+bool SdlControllerBackend::Latch(SDL_JoystickID id, bool refresh, Sint16* pAxes, SensorData* pSensor) const {
+    if (id == 0) return false;
+    if (refresh) {
+        SDL_UpdateGamepads();
+    }
+
+    SDL_LockJoysticks();
+    SDL_Gamepad* pGamepad = SDL_GetGamepadFromID(id);
+    if (pGamepad) {
+        for (int i = 0; i < SDL_GAMEPAD_AXIS_COUNT; i++) {
+            pAxes[i] = SDL_GetGamepadAxis(pGamepad, static_cast<SDL_GamepadAxis>(i));
+        }
+
+        if (pSensor) {
+            *pSensor = {};
+            float data[3] = {};
+            if (SDL_GamepadSensorEnabled(pGamepad, SDL_SENSOR_GYRO) &&
+                SDL_GetGamepadSensorData(pGamepad, SDL_SENSOR_GYRO, data, 3)) {
+                pSensor->hasGyro = true;
+                pSensor->gyroX = data[0];
+                pSensor->gyroY = data[1];
+                pSensor->gyroZ = data[2];
+            }
+            if (SDL_GamepadSensorEnabled(pGamepad, SDL_SENSOR_ACCEL) &&
+                SDL_GetGamepadSensorData(pGamepad, SDL_SENSOR_ACCEL, data, 3)) {
+                pSensor->hasAccel = true;
+                pSensor->accelX = data[0];
+                pSensor->accelY = data[1];
+                pSensor->accelZ = data[2];
+            }
+        }
+    }
+    SDL_UnlockJoysticks();
+
+    return pGamepad != nullptr;
+}
+
+bool SdlControllerBackend::WaitForInput(Uint64 deadlineNS) const {
+    //  SDL ̃L[gȂ̂ŁA邩܂ŏ҂
+    if (m_pInitThread) {
+        while (m_initStatus.load(std::memory_order_acquire) == InitStatus::Pending) {
+            Sint32 timeoutMS = ToTimeoutMS(deadlineNS);
+            if (timeoutMS == 0) return false;
+            SDL_Delay(static_cast<Uint32>(SDL_min(timeoutMS, INIT_WAIT_SLICE_MS)));
+        }
+        return true;
+    }
+
+    if (!m_pInputThread) {
+        // oɑ҂i͂Cxg͎ Update()  Pump() ŏj
+        return SDL_WaitEventTimeout(nullptr, ToTimeoutMS(deadlineNS));
+    }
+
+    // ̓XbhL[ôŁAOɓ͂܂ōXVQB
+    // L[͌Ȃi̓XbhoȂEBhẼCxgŋNĂ܂j
+    Uint64 sliceNS = SDL_max(m_pollIntervalNS, static_cast<Uint64>(MIN_WAIT_SLICE_NS));
+    for (;;) {
+        if (!m_sampleRing.IsEmpty() || !m_sensorRing.IsEmpty() || !m_touchRing.IsEmpty()) return true;
+
+        Uint64 nowNS = SDL_GetTicksNS();
+        if (nowNS >= deadlineNS) return false;
+        SDL_DelayNS(SDL_min(deadlineNS - nowNS, sliceNS));
+    }
+}
+
+//==============================================================================
+// SDLF̓Xbh
+//==============================================================================
+bool SdlControllerBackend::StartInputThread(Uint32 pollIntervalUS) {
+    if (m_pInputThread) return true;
+
+    m_sampleRing.Clear();
+    m_sensorRing.Clear();
+    m_touchRing.Clear();
+    m_droppedSamples.store(0, std::memory_order_relaxed);
+    m_pollIntervalNS = static_cast<Uint64>(pollIntervalUS) * 1000;
+    m_inputThreadRunning.store(true, std::memory_order_release);
+
+    m_pInputThread = SDL_CreateThread(InputThreadMain, "GameControllerInput", this);
+    if (!m_pInputThread) {
+        m_inputThreadRunning.store(false, std::memory_order_release);
+        return false;
+    }
+    return true;
+}
+
+void SdlControllerBackend::StopInputThread() {
+    if (!m_pInputThread) return;
+
+    m_inputThreadRunning.store(false, std::memory_order_release);
+    SDL_WaitThread(m_pInputThread, nullptr);
+    m_pInputThread = nullptr;
+}
+
+int SDLCALL SdlControllerBackend::InputThreadMain(void* pUserData) {
+    static_cast<SdlControllerBackend*>(pUserData)->RunInputThread();
+    return 0;
+}
+
+// foCX̍XVŃWCXeBbNEQ[pbh̃CxgoB
+// ȊÕCxgiEBhEj̓L[ɎĉŃCXbhŏłB
+void SdlControllerBackend::RunInputThread() {
+    SDL_SetCurrentThreadPriority(SDL_THREAD_PRIORITY_HIGH);
+
+    SDL_Event events[PEEP_BATCH_SIZE];
+    while (m_inputThreadRunning.load(std::memory_order_acquire)) {
+        SDL_UpdateGamepads();
+
+        int count = SDL_PeepEvents(events, PEEP_BATCH_SIZE, SDL_GETEVENT,
+            SDL_EVENT_JOYSTICK_AXIS_MOTION, SDL_EVENT_GAMEPAD_STEAM_HANDLE_UPDATED);
+        for (int i = 0; i < count; i++) {
+            InputSample sample;
+            SensorSample sensorSample;
+            TouchSample touchSample;
+            if (ControllerEvent::MakeSample(events[i], &sample)) {
+                if (!m_sampleRing.Push(sample)) {
+                    m_droppedSamples.fetch_add(1, std::memory_order_relaxed);
+                }
+            } else if (ControllerEvent::MakeSensorSample(events[i], &sensorSample)) {
+                if (!m_sensorRing.Push(sensorSample)) {
+                    m_droppedSamples.fetch_add(1, std::memory_order_relaxed);
+                }
+            } else if (ControllerEvent::MakeTouchSample(events[i], &touchSample)) {
+                if (!m_touchRing.Push(touchSample)) {
+                    m_droppedSamples.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        if (count < PEEP_BATCH_SIZE) {
+            SDL_DelayNS(m_pollIntervalNS);
+        }
+    }
+}
+
+//==============================================================================
+// ́F
+//==============================================================================
+bool SyntheticControllerBackend::PushEvent(const SDL_Event& event) {
+    if (m_eventCount >= EVENT_CAPACITY) return false;
+
+    m_events[(m_eventHead + m_eventCount) % EVENT_CAPACITY] = event;
+    m_eventCount++;
+    return true;
+}
+
+bool SyntheticControllerBackend::Connect(SDL_JoystickID id, const DeviceInfo& info) {
+    SDL_Event event = {};
+    event.type = SDL_EVENT_GAMEPAD_ADDED;
+    event.common.timestamp = m_timestampNS;
+    event.gdevice.which = id;
+    if (!PushEvent(event)) return false;
+
+    m_pendingId = id;
+    m_pendingInfo = info;
+    m_buttons = 0;
+    for (Sint16& axis : m_axes) axis = 0;
+    m_touchpad = {};
+    m_touchpad.numTouchpads = info.numTouchpads;
+    m_touchpad.hasTouchpad = info.hasTouchpad;
+    m_sensor = {};
+    return true;
+}
+
+bool SyntheticControllerBackend::Disconnect() {
+    SDL_Event event = {};
+    event.type = SDL_EVENT_GAMEPAD_REMOVED;
+    event.common.timestamp = m_timestampNS;
+    event.gdevice.which = m_pendingId;
+    return PushEvent(event);
+}
+
+bool SyntheticControllerBackend::SetButton(SDL_GamepadButton button, bool down) {
+    if (button < 0 || button >= ButtonAxisState::BUTTON_POLL_COUNT) return false;
+
+    SDL_Event event = {};
+    event.type = down ? SDL_EVENT_GAMEPAD_BUTTON_DOWN : SDL_EVENT_GAMEPAD_BUTTON_UP;
+    event.common.timestamp = m_timestampNS;
+    event.gbutton.which = m_pendingId;
+    event.gbutton.button = static_cast<Uint8>(button);
+    event.gbutton.down = down;
+    if (!PushEvent(event)) return false;
+
+    uint32_t mask = 1u << button;
+    m_buttons = down ? (m_buttons | mask) : (m_buttons & ~mask);
+    return true;
+}
+
+bool SyntheticControllerBackend::SetAxis(SDL_GamepadAxis axis, Sint16 value) {
+    if (axis < 0 || axis >= SDL_GAMEPAD_AXIS_COUNT) return false;
+
+    SDL_Event event = {};
+    event.type = SDL_EVENT_GAMEPAD_AXIS_MOTION;
+    event.common.timestamp = m_timestampNS;
+    event.gaxis.which = m_pendingId;
+    event.gaxis.axis = static_cast<Uint8>(axis);
+    event.gaxis.value = value;
+    if (!PushEvent(event)) return false;
+
+    m_axes[axis] = value;
+    return true;
+}
+
+bool SyntheticControllerBackend::PushSensor(SDL_SensorType type, float x, float y, float z) {
+    SDL_Event event = {};
+    event.type = SDL_EVENT_GAMEPAD_SENSOR_UPDATE;
+    event.common.timestamp = m_timestampNS;
+    event.gsensor.which = m_pendingId;
+    event.gsensor.sensor = type;
+    event.gsensor.data[0] = x;
+    event.gsensor.data[1] = y;
+    event.gsensor.data[2] = z;
+    event.gsensor.sensor_timestamp = m_timestampNS;
+    if (!PushEvent(event)) return false;
+
+    if (type == SDL_SENSOR_GYRO) {
+        m_sensor.hasGyro = true;
+        m_sensor.gyroX = x;
+        m_sensor.gyroY = y;
+        m_sensor.gyroZ = z;
+    } else if (type == SDL_SENSOR_ACCEL) {
+        m_sensor.hasAccel = true;
+        m_sensor.accelX = x;
+        m_sensor.accelY = y;
+        m_sensor.accelZ = z;
+    }
+    return true;
+}
+
+bool SyntheticControllerBackend::SetTouch(int touchpad, int finger, bool down, float x, float y, float pressure) {
+    if (touchpad < 0 || touchpad >= TouchpadData::MAX_TOUCHPADS ||
+        finger < 0 || finger >= TouchpadData::MAX_FINGERS) return false;
+
+    TouchpadData::Finger& state = m_touchpad.fingers[touchpad][finger];
+    SDL_Event event = {};
+    event.type = !down ? SDL_EVENT_GAMEPAD_TOUCHPAD_UP
+        : state.down ? SDL_EVENT_GAMEPAD_TOUCHPAD_MOTION : SDL_EVENT_GAMEPAD_TOUCHPAD_DOWN;
+    event.common.timestamp = m_timestampNS;
+    event.gtouchpad.which = m_pendingId;
+    event.gtouchpad.touchpad = touchpad;
+    event.gtouchpad.finger = finger;
+    event.gtouchpad.x = x;
+    event.gtouchpad.y = y;
+    event.gtouchpad.pressure = pressure;
+    if (!PushEvent(event)) return false;
+
+    state.down = down;
+    state.x = x;
+    state.y = y;
+    state.pressure = down ? pressure : 0.0f;
+    state.timestampNS = m_timestampNS;
+    return true;
+}
+
+bool SyntheticControllerBackend::SetLED(uint8_t r, uint8_t g, uint8_t b) {
+    if (!m_open) return false;
+    m_led = (static_cast<Uint32>(r) << 16) | (static_cast<Uint32>(g) << 8) | b;
+    return true;
+}
+
+//==============================================================================
+// ́FfoCX
+//==============================================================================
+Uint32 SyntheticControllerBackend::HandleDeviceSample(const InputSample& sample) {
+    switch (sample.type) {
+    case SDL_EVENT_GAMEPAD_ADDED:
+        if (!m_open && sample.which == m_pendingId) {
+            m_open = true;
+            m_gamepadId = sample.which;
+            m_deviceInfo = m_pendingInfo;
+            return DEVICE_CHANGE_OPENED;
+        }
+        break;
+
+    case SDL_EVENT_GAMEPAD_REMOVED:
+        if (m_open && sample.which == m_gamepadId) {
+            m_open = false;
+            m_gamepadId = 0;
+            m_deviceInfo = DeviceInfo();
+            return DEVICE_CHANGE_CLOSED;
+        }
+        break;
+    }
+    return DEVICE_CHANGE_NONE;
+}
+
+void SyntheticControllerBackend::Poll(uint32_t* pButtons, Sint16* pAxes) const {
+    *pButtons = m_buttons;
+    for (int i = 0; i < SDL_GAMEPAD_AXIS_COUNT; i++) {
+        pAxes[i] = m_axes[i];
+    }
+}
+
+void SyntheticControllerBackend::PollTouchpad(TouchpadData* pOut) const {
+    *pOut = m_touchpad;
+}
+
+bool SyntheticControllerBackend::Latch(SDL_JoystickID id, bool, Sint16* pAxes, SensorData* pSensor) const {
+    if (!m_open || id != m_gamepadId) return false;
+
+    for (int i = 0; i < SDL_GAMEPAD_AXIS_COUNT; i++) {
+        pAxes[i] = m_axes[i];
+    }
+    if (pSensor) {
+        *pSensor = m_sensor;
+    }
+    return true;
+}
+
+//==============================================================================
+// vC
+//==============================================================================
+void ReplayControllerBackend::Poll(uint32_t* pButtons, Sint16* pAxes) const {
+    *pButtons = 0;
+    for (int i = 0; i < SDL_GAMEPAD_AXIS_COUNT; i++) {
+        pAxes[i] = 0;
+    }
+}
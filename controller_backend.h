@@ -0,0 +1,295 @@
+/*********************************************************************
+ * \file   controller_backend.h
+ * \brief  ControllerCore ̃obNGhiSDL foCX /  / vCj
+ *********************************************************************/
+#pragma once
+#include "controller_core.h"
+#include "device_registry.h"
+#include "spsc_ring.h"
+#include <atomic>
+
+//==============================================================================
+// obNGh̗viControllerCore ĂԂ́j
+//------------------------------------------------------------------------------
+//  IS_FRAME_SOURCE                true Ȃ ReadFrame()Afalse Ȃ Pump() œ͂n
+//  Initialize() / Finalize()
+//  BeginInitialize() / PollInitialize()  񓯊i܂ł PollInitialize()  Pendingj
+//  IsOpen() / GetId() / GetGamepad() / GetOutputSlot() / GetDeviceInfo()
+//  HandleDeviceSample(sample)     ڑnTv ControllerDeviceChange Ԃ
+//  Poll(pButtons, pAxes)          ݂̃{^irbgʒu = SDL_GamepadButtonjƎ
+//  PollTouchpad(pOut)             ݂̎w̏
+//  ReadSensorData() / EnableSensor() / GetSensorDataRate() / SetLED()
+//  Latch(id, refresh, pAxes, pSensor)   id ̃foCX̎EZT[ǂݒi`XbhĂ΂j
+//  WaitForInput(deadlineNS)       ͂͂܂ő҂iCxg͎oȂj
+//  StartInputThread() / StopInputThread() / IsInputThreadRunning()
+//  Pump(core) / DrainInputThread(core)   ܂͂ core.Apply*() ֓n
+//  ReadFrame(pOut)                IS_FRAME_SOURCE ̂
+//==============================================================================
+
+//==============================================================================
+// SDL foCX
+//------------------------------------------------------------------------------
+// SDL ̃CxgL[̓vZX 1 Ȃ̂ŁAPump()iSDL_PollEventj
+// ̓Xbh𓮂̂ 1 ̃ReLXgɂ邱ƁB
+// ̃ReLXgւ́A󂯎Cxg ProcessEvent() œnBn{^
+// ÉAt[ŉė̂܂߂Ď Update() ̃GbWɎcB
+//==============================================================================
+class SdlControllerBackend {
+public:
+    static constexpr bool IS_FRAME_SOURCE = false;
+    static constexpr int SAMPLE_RING_CAPACITY = 4096;
+    static constexpr int MAPPING_PATH_SIZE = 260;
+
+    SdlControllerBackend() = default;
+    SdlControllerBackend(const SdlControllerBackend&) = delete;
+    SdlControllerBackend& operator=(const SdlControllerBackend&) = delete;
+
+    // EIiSDL  OutputWriter ͎QƃJEgtj
+    bool Initialize();
+    void Finalize();
+
+    // 񓯊FSDL ̏ifoCX̗񋓁E}bsO̎荞݁jƃXbhōsA
+    // ɌĂ΂ꂽ PollInitialize() cio^\EfoCXJj̃Xbhōs
+    bool BeginInitialize();
+    InitStatus PollInitialize();
+
+    // JX^}bsÕLbVimapping_cache.hȂOɐݒ肷BpX̓Rs[j
+    void SetMappingCache(const char* pCachePath, const char* pTextPath = nullptr);
+
+    // foCX
+    bool IsOpen() const { return m_pGamepad != nullptr; }
+    SDL_JoystickID GetId() const { return m_gamepadId; }
+    SDL_Gamepad* GetGamepad() const { return m_pGamepad; }
+    int GetOutputSlot() const { return m_outputSlot; }
+    const DeviceInfo& GetDeviceInfo() const { return m_deviceInfo; }
+    const DeviceRegistry& GetRegistry() const { return m_registry; }
+    int GetSlot() const { return m_registry.FindSlot(m_gamepadId); }
+    int GetPlayerIndex() const;
+
+    Uint32 HandleDeviceSample(const InputSample& sample);
+    void Poll(uint32_t* pButtons, Sint16* pAxes) const;
+    void PollTouchpad(TouchpadData* pOut) const;
+
+    // ZT[ELED
+    SensorData ReadSensorData() const;
+    bool EnableSensor(SDL_SensorType type, bool enable);
+    float GetSensorDataRate(SDL_SensorType type) const;
+    bool SetLED(uint8_t r, uint8_t g, uint8_t b);
+
+    // xb`iSDL ̃WCXeBbNbNœǂނ̂ŁAUpdate() ƕsČĂׂj
+    // refresh  SDL_UpdateGamepads() ɌĂԁBCxgXbĥݎw肷邱
+    bool Latch(SDL_JoystickID id, bool refresh, Sint16* pAxes, SensorData* pSensor) const;
+
+    // ͂͂ deadlineNSiSDL_GetTicksNS j߂܂ő҂B͂ true
+    bool WaitForInput(Uint64 deadlineNS) const;
+
+    // ̓XbhifoCX̍XVŃCxgoăOɐςށj
+    bool StartInputThread(Uint32 pollIntervalUS);
+    void StopInputThread();
+    bool IsInputThreadRunning() const { return m_pInputThread != nullptr; }
+    Uint32 GetDroppedSampleCount() const { return m_droppedSamples.load(std::memory_order_relaxed); }
+
+    // ̓XbhĂ΃OAȊO SDL ̃CxgL[荞
+    template<typename Core>
+    void Pump(Core& core) {
+        if (m_pInputThread) {
+            DrainInputThread(core);
+            return;
+        }
+
+        SDL_Event event;
+        while (SDL_PollEvent(&event)) {
+            core.ProcessEvent(event);
+        }
+    }
+
+    // ̓Xbhς񂾃TvׂĎoibNȂj
+    template<typename Core>
+    void DrainInputThread(Core& core) {
+        InputSample sample;
+        while (m_sampleRing.Pop(sample)) {
+            core.ApplySample(sample);
+        }
+        SensorSample sensorSample;
+        while (m_sensorRing.Pop(sensorSample)) {
+            core.ApplySensorSample(sensorSample);
+        }
+        TouchSample touchSample;
+        while (m_touchRing.Pop(touchSample)) {
+            core.ApplyTouchSample(touchSample);
+        }
+    }
+
+private:
+    static int SDLCALL InputThreadMain(void* pUserData);
+    void RunInputThread();
+    static int SDLCALL InitThreadMain(void* pUserData);
+    bool InitializeSubsystem();
+    void FinishInitialize();
+
+    bool Open(SDL_JoystickID id);
+    bool OpenFirstConnected();
+    void Close();
+    void RefreshDeviceInfo();
+
+    SDL_Gamepad* m_pGamepad = nullptr;
+    SDL_JoystickID m_gamepadId = 0;
+    int m_outputSlot = -1;
+    DeviceRegistry m_registry;
+    DeviceInfo m_deviceInfo;
+
+    SpscRing<InputSample, SAMPLE_RING_CAPACITY> m_sampleRing;
+    SpscRing<SensorSample, SAMPLE_RING_CAPACITY> m_sensorRing;
+    SpscRing<TouchSample, SAMPLE_RING_CAPACITY> m_touchRing;
+    SDL_Thread* m_pInputThread = nullptr;
+    std::atomic<bool> m_inputThreadRunning{ false };
+    std::atomic<Uint32> m_droppedSamples{ 0 };
+    Uint64 m_pollIntervalNS = 0;
+
+    char m_mappingCachePath[MAPPING_PATH_SIZE] = {};
+    char m_mappingTextPath[MAPPING_PATH_SIZE] = {};
+    SDL_Thread* m_pInitThread = nullptr;
+    std::atomic<InitStatus> m_initStatus{ InitStatus::NotStarted };
+};
+
+//==============================================================================
+// ́ifoCXgȂc[EeXgpj
+//------------------------------------------------------------------------------
+//  SDL_Event ɂăL[ɐς݁AUpdate()  Pump() ł܂Ƃ߂ēnB
+// Cxg̎ SetTime() Ŏw肵lɂȂB
+//==============================================================================
+class SyntheticControllerBackend {
+public:
+    static constexpr bool IS_FRAME_SOURCE = false;
+    static constexpr int EVENT_CAPACITY = 256;
+
+    bool Initialize() { return true; }
+    void Finalize() { m_open = false; m_gamepadId = 0; m_eventCount = 0; }
+    bool BeginInitialize() { return Initialize(); }
+    InitStatus PollInitialize() { return InitStatus::Ready; }
+
+    // iL[tȂ falsej
+    bool Connect(SDL_JoystickID id, const DeviceInfo& info = DeviceInfo());
+    bool Disconnect();
+    bool SetButton(SDL_GamepadButton button, bool down);
+    bool SetAxis(SDL_GamepadAxis axis, Sint16 value);
+    bool PushSensor(SDL_SensorType type, float x, float y, float z);
+    bool SetTouch(int touchpad, int finger, bool down, float x, float y, float pressure);
+    void SetTime(Uint64 timestampNS) { m_timestampNS = timestampNS; }
+
+    // foCX
+    bool IsOpen() const { return m_open; }
+    SDL_JoystickID GetId() const { return m_gamepadId; }
+    SDL_Gamepad* GetGamepad() const { return nullptr; }
+    int GetOutputSlot() const { return -1; }
+    const DeviceInfo& GetDeviceInfo() const { return m_deviceInfo; }
+
+    Uint32 HandleDeviceSample(const InputSample& sample);
+    void Poll(uint32_t* pButtons, Sint16* pAxes) const;
+    void PollTouchpad(TouchpadData* pOut) const;
+
+    // ZT[ELEDil͕ێ邾j
+    SensorData ReadSensorData() const { return m_sensor; }
+    bool EnableSensor(SDL_SensorType, bool) { return m_open; }
+    float GetSensorDataRate(SDL_SensorType) const { return 0.0f; }
+    bool SetLED(uint8_t r, uint8_t g, uint8_t b);
+    Uint32 GetLED() const { return m_led; }
+
+    // xb`i삵l̂܂ܕԂjEҋ@iL[ɑ삪 trueA҂Ȃj
+    bool Latch(SDL_JoystickID id, bool refresh, Sint16* pAxes, SensorData* pSensor) const;
+    bool WaitForInput(Uint64) const { return m_eventCount > 0; }
+
+    // ̓Xbh͎Ȃ
+    bool StartInputThread(Uint32) { return false; }
+    void StopInputThread() {}
+    bool IsInputThreadRunning() const { return false; }
+
+    template<typename Core>
+    void Pump(Core& core) {
+        // ɐς܂ꂽCxg͎̃t[ɉ
+        int count = m_eventCount;
+        for (int i = 0; i < count; i++) {
+            core.ProcessEvent(m_events[(m_eventHead + i) % EVENT_CAPACITY]);
+        }
+        m_eventHead = (m_eventHead + count) % EVENT_CAPACITY;
+        m_eventCount -= count;
+    }
+
+    template<typename Core>
+    void DrainInputThread(Core&) {}
+
+private:
+    bool PushEvent(const SDL_Event& event);
+
+    bool m_open = false;
+    SDL_JoystickID m_gamepadId = 0;
+    SDL_JoystickID m_pendingId = 0;
+    DeviceInfo m_deviceInfo;
+    DeviceInfo m_pendingInfo;
+    Uint64 m_timestampNS = 0;
+
+    // Connect() ȍ~ɑ삵liPoll() Ԃj
+    uint32_t m_buttons = 0;
+    Sint16 m_axes[SDL_GAMEPAD_AXIS_COUNT] = {};
+    TouchpadData m_touchpad;
+    SensorData m_sensor;
+    Uint32 m_led = 0;
+
+    SDL_Event m_events[EVENT_CAPACITY];
+    int m_eventHead = 0;
+    int m_eventCount = 0;
+};
+
+//==============================================================================
+// vCiL^t[̂܂ܓnj
+//==============================================================================
+class ReplayControllerBackend {
+public:
+    static constexpr bool IS_FRAME_SOURCE = true;
+
+    void SetReplay(InputReplay* pReplay) { m_pReplay = (pReplay && pReplay->IsOpen()) ? pReplay : nullptr; }
+    bool IsPlaying() const { return m_pReplay != nullptr; }
+
+    // I[ falseiȍ~͖ڑ̂܂܁j
+    bool ReadFrame(RecordedFrame* pOut) {
+        if (m_pReplay && m_pReplay->ReadNext(pOut)) return true;
+        m_pReplay = nullptr;
+        return false;
+    }
+
+    bool Initialize() { return true; }
+    void Finalize() { m_pReplay = nullptr; }
+    bool BeginInitialize() { return Initialize(); }
+    InitStatus PollInitialize() { return InitStatus::Ready; }
+
+    // foCX͎Ȃ
+    bool IsOpen() const { return false; }
+    SDL_JoystickID GetId() const { return 0; }
+    SDL_Gamepad* GetGamepad() const { return nullptr; }
+    int GetOutputSlot() const { return -1; }
+    const DeviceInfo& GetDeviceInfo() const { return m_deviceInfo; }
+
+    Uint32 HandleDeviceSample(const InputSample&) { return DEVICE_CHANGE_NONE; }
+    void Poll(uint32_t* pButtons, Sint16* pAxes) const;
+    void PollTouchpad(TouchpadData* pOut) const { *pOut = {}; }
+
+    SensorData ReadSensorData() const { return SensorData{}; }
+    bool EnableSensor(SDL_SensorType, bool) { return false; }
+    float GetSensorDataRate(SDL_SensorType) const { return 0.0f; }
+    bool SetLED(uint8_t, uint8_t, uint8_t) { return false; }
+
+    // ǂݒfoCX͖B̃t[͏ɗpӂłĂ
+    bool Latch(SDL_JoystickID, bool, Sint16*, SensorData*) const { return false; }
+    bool WaitForInput(Uint64) const { return true; }
+
+    bool StartInputThread(Uint32) { return false; }
+    void StopInputThread() {}
+    bool IsInputThreadRunning() const { return false; }
+
+    template<typename Core>
+    void DrainInputThread(Core&) {}
+
+private:
+    InputReplay* m_pReplay = nullptr;
+    DeviceInfo m_deviceInfo;
+};
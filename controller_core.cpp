@@ -0,0 +1,398 @@
+/*********************************************************************
+ * \file   controller_core.cpp
+ * \brief  CX^XPʂ̃Rg[[͏iobNGhɈˑȂj
+ *********************************************************************/
+#include "controller_core.h"
+
+//==============================================================================
+// 萔`
+//==============================================================================
+namespace {
+    constexpr float TRIGGER_DIGITAL_THRESHOLD = 0.5f;
+
+    // L2/R2 ̃rbgʒu
+    constexpr int BUTTON_BIT_L2 = SDL_GAMEPAD_BUTTON_COUNT;
+    constexpr int BUTTON_BIT_R2 = SDL_GAMEPAD_BUTTON_COUNT + 1;
+
+    // [g̕W
+    constexpr float SENSOR_RATE_SMOOTHING = 0.05f;
+
+    template<typename T>
+    T Clamp(T value, T minVal, T maxVal) {
+        if (value < minVal) return minVal;
+        if (value > maxVal) return maxVal;
+        return value;
+    }
+
+    float NormalizeTrigger(Sint16 value) {
+        return Clamp(static_cast<float>(value) / 32767.0f, 0.0f, 1.0f);
+    }
+
+    bool IsTriggerDown(Sint16 value) {
+        return NormalizeTrigger(value) > TRIGGER_DIGITAL_THRESHOLD;
+    }
+
+    // WC = 0, x = 1, ȊO = -1
+    int SensorSlot(SDL_SensorType type) {
+        if (type == SDL_SENSOR_GYRO) return 0;
+        if (type == SDL_SENSOR_ACCEL) return 1;
+        return -1;
+    }
+
+    // mask ̃rbgɑΉJEg̍v
+    int SumCounts(const Uint8* pCounts, uint32_t mask) {
+        int total = 0;
+        for (int i = 0; mask; i++, mask >>= 1) {
+            if (mask & 1u) total += pCounts[i];
+        }
+        return total;
+    }
+}
+
+//==============================================================================
+// CxgTvւ̕ϊ
+//==============================================================================
+bool ControllerEvent::MakeSample(const SDL_Event& event, InputSample* pSample) {
+    switch (event.type) {
+    case SDL_EVENT_GAMEPAD_ADDED:
+    case SDL_EVENT_GAMEPAD_REMOVED:
+    case SDL_EVENT_GAMEPAD_REMAPPED:
+        pSample->which = event.gdevice.which;
+        pSample->value = 0;
+        pSample->index = 0;
+        break;
+
+    case SDL_EVENT_JOYSTICK_BATTERY_UPDATED:
+        pSample->which = event.jbattery.which;
+        pSample->value = static_cast<Sint16>(event.jbattery.percent);
+        pSample->index = static_cast<Uint8>(event.jbattery.state);
+        break;
+
+    case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+    case SDL_EVENT_GAMEPAD_BUTTON_UP:
+        pSample->which = event.gbutton.which;
+        pSample->value = event.gbutton.down ? 1 : 0;
+        pSample->index = event.gbutton.button;
+        break;
+
+    case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+        pSample->which = event.gaxis.which;
+        pSample->value = event.gaxis.value;
+        pSample->index = event.gaxis.axis;
+        break;
+
+    default:
+        return false;
+    }
+
+    pSample->type = event.type;
+    pSample->timestampNS = event.common.timestamp;
+    return true;
+}
+
+bool ControllerEvent::MakeSensorSample(const SDL_Event& event, SensorSample* pSample) {
+    if (event.type != SDL_EVENT_GAMEPAD_SENSOR_UPDATE) return false;
+
+    pSample->timestampNS = event.common.timestamp;
+    pSample->sensorTimestampNS = event.gsensor.sensor_timestamp
+        ? event.gsensor.sensor_timestamp : event.common.timestamp;
+    pSample->which = event.gsensor.which;
+    pSample->type = static_cast<SDL_SensorType>(event.gsensor.sensor);
+    pSample->data[0] = event.gsensor.data[0];
+    pSample->data[1] = event.gsensor.data[1];
+    pSample->data[2] = event.gsensor.data[2];
+    return true;
+}
+
+bool ControllerEvent::MakeTouchSample(const SDL_Event& event, TouchSample* pSample) {
+    if (event.type != SDL_EVENT_GAMEPAD_TOUCHPAD_DOWN &&
+        event.type != SDL_EVENT_GAMEPAD_TOUCHPAD_MOTION &&
+        event.type != SDL_EVENT_GAMEPAD_TOUCHPAD_UP) return false;
+    if (event.gtouchpad.touchpad < 0 || event.gtouchpad.touchpad >= TOUCHPAD_MAX_COUNT ||
+        event.gtouchpad.finger < 0 || event.gtouchpad.finger >= TOUCHPAD_MAX_FINGERS) return false;
+
+    pSample->timestampNS = event.common.timestamp;
+    pSample->type = event.type;
+    pSample->which = event.gtouchpad.which;
+    pSample->touchpad = static_cast<Uint8>(event.gtouchpad.touchpad);
+    pSample->finger = static_cast<Uint8>(event.gtouchpad.finger);
+    pSample->x = event.gtouchpad.x;
+    pSample->y = event.gtouchpad.y;
+    pSample->pressure = event.gtouchpad.pressure;
+    return true;
+}
+
+//==============================================================================
+// {^E
+//==============================================================================
+void ButtonAxisState::Reset() {
+    m_liveButtons = 0;
+    for (int i = 0; i < SDL_GAMEPAD_AXIS_COUNT; i++) {
+        m_rawAxes[i] = 0;
+        m_processedAxes[i] = 0;
+    }
+    m_axesDirty = true;
+}
+
+void ButtonAxisState::ApplyButton(int bit, bool down) {
+    uint32_t mask = 1u << bit;
+
+    if (down) {
+        if (m_liveButtons & mask) return;
+        m_liveButtons |= mask;
+        m_frameTriggered |= mask;
+        if (m_pressCount[bit] < 0xFF) m_pressCount[bit]++;
+    } else {
+        if (!(m_liveButtons & mask)) return;
+        m_liveButtons &= ~mask;
+        m_frameReleased |= mask;
+        if (m_releaseCount[bit] < 0xFF) m_releaseCount[bit]++;
+    }
+}
+
+void ButtonAxisState::ApplyAxis(int axis, Sint16 value) {
+    m_rawAxes[axis] = value;
+    m_axesDirty = true;
+
+    // gK[̃fW^{^CxgƂĈ
+    if (axis == SDL_GAMEPAD_AXIS_LEFT_TRIGGER) {
+        ApplyButton(BUTTON_BIT_L2, IsTriggerDown(value));
+    } else if (axis == SDL_GAMEPAD_AXIS_RIGHT_TRIGGER) {
+        ApplyButton(BUTTON_BIT_R2, IsTriggerDown(value));
+    }
+}
+
+void ButtonAxisState::SetPolled(uint32_t buttons, const Sint16* pAxes) {
+    for (int i = 0; i < SDL_GAMEPAD_AXIS_COUNT; i++) {
+        m_rawAxes[i] = pAxes[i];
+    }
+    m_axesDirty = true;
+
+    // gK[̃fW^
+    buttons |= IsTriggerDown(m_rawAxes[SDL_GAMEPAD_AXIS_LEFT_TRIGGER]) ? BUTTON_MASK_L2 : 0u;
+    buttons |= IsTriggerDown(m_rawAxes[SDL_GAMEPAD_AXIS_RIGHT_TRIGGER]) ? BUTTON_MASK_R2 : 0u;
+
+    m_liveButtons = buttons;
+}
+
+void ButtonAxisState::ClearFrameEvents() {
+    m_frameTriggered = 0;
+    m_frameReleased = 0;
+    for (int i = 0; i < BUTTON_BIT_COUNT; i++) {
+        m_pressCount[i] = 0;
+        m_releaseCount[i] = 0;
+        m_lastPressCount[i] = 0;
+        m_lastReleaseCount[i] = 0;
+    }
+    m_hasLastCounts = false;
+}
+
+// Wv̉񐔂𒼑Õt[̉񐔂ֈڂiǂȂ牽Ȃj
+void ButtonAxisState::EndFrame() {
+    bool hasEvents = HasFrameEvents();
+    if (!hasEvents && !m_hasLastCounts) return;
+
+    for (int i = 0; i < BUTTON_BIT_COUNT; i++) {
+        m_lastPressCount[i] = m_pressCount[i];
+        m_lastReleaseCount[i] = m_releaseCount[i];
+        m_pressCount[i] = 0;
+        m_releaseCount[i] = 0;
+    }
+    m_frameTriggered = 0;
+    m_frameReleased = 0;
+    m_hasLastCounts = hasEvents;
+}
+
+int ButtonAxisState::GetPressCount(uint32_t mask) const {
+    return SumCounts(m_lastPressCount, mask);
+}
+
+int ButtonAxisState::GetReleaseCount(uint32_t mask) const {
+    return SumCounts(m_lastReleaseCount, mask);
+}
+
+void ButtonAxisState::Build(GamepadState* pState, uint32_t prevButtons) {
+    // XeBbNEgK[iCxg[hł͕ωƂ̂݁j
+    if (m_axesDirty) {
+        m_curves.Process(m_rawAxes, m_processedAxes);
+        pState->leftStickX = ResponseCurve::ToFloat(m_processedAxes[SDL_GAMEPAD_AXIS_LEFTX]);
+        pState->leftStickY = ResponseCurve::ToFloat(m_processedAxes[SDL_GAMEPAD_AXIS_LEFTY]);
+        pState->rightStickX = ResponseCurve::ToFloat(m_processedAxes[SDL_GAMEPAD_AXIS_RIGHTX]);
+        pState->rightStickY = ResponseCurve::ToFloat(m_processedAxes[SDL_GAMEPAD_AXIS_RIGHTY]);
+        pState->leftTrigger = ResponseCurve::ToFloat(m_processedAxes[SDL_GAMEPAD_AXIS_LEFT_TRIGGER]);
+        pState->rightTrigger = ResponseCurve::ToFloat(m_processedAxes[SDL_GAMEPAD_AXIS_RIGHT_TRIGGER]);
+        m_axesDirty = false;
+    }
+
+    // {^it[ŉė̂GbWƂĎcj
+    pState->buttons = m_liveButtons;
+    pState->UpdateEdges(prevButtons);
+    pState->triggered |= m_frameTriggered;
+    pState->released |= m_frameReleased;
+}
+
+// ւV[PXbNň͂ށie[u͌ĂяoōĂj
+template<typename Assign>
+void ButtonAxisState::WriteCurves(Assign assign) {
+    Uint32 sequence = m_curveSequence.load(std::memory_order_relaxed);
+    m_curveSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    assign(m_curves);
+    m_curveSequence.store(sequence + 2, std::memory_order_release);
+    m_axesDirty = true;
+}
+
+void ButtonAxisState::SetLeftStickCurve(const ResponseCurveSettings& settings) {
+    ResponseCurve curve(settings);
+    WriteCurves([&](ResponseCurveSet& curves) { curves.leftStick = curve; });
+}
+
+void ButtonAxisState::SetRightStickCurve(const ResponseCurveSettings& settings) {
+    ResponseCurve curve(settings);
+    WriteCurves([&](ResponseCurveSet& curves) { curves.rightStick = curve; });
+}
+
+void ButtonAxisState::SetTriggerCurve(const ResponseCurveSettings& settings) {
+    ResponseCurve curve(settings);
+    WriteCurves([&](ResponseCurveSet& curves) { curves.triggers = curve; });
+}
+
+// ݒ̃e[uǂ񂾌ʂ͎̂ĂiY͔͈͓Ɏ܂̂œǂނƎ͈̂Sj
+bool ButtonAxisState::ProcessConcurrent(const Sint16* pRaw, Sint16* pOut) const {
+    for (int attempt = 0; attempt < MAX_CURVE_RETRY; attempt++) {
+        Uint32 before = m_curveSequence.load(std::memory_order_acquire);
+        if (before & 1u) continue;
+
+        m_curves.Process(pRaw, pOut);
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (m_curveSequence.load(std::memory_order_relaxed) == before) return true;
+    }
+    return false;
+}
+
+//==============================================================================
+// ZT[Xg[
+//==============================================================================
+void SensorStream::Apply(const SensorSample& sample) {
+    int slot = SensorSlot(sample.type);
+    if (slot >= 0) {
+        // [gifoCX̊Ԋuj
+        Uint64 prevNS = m_lastTimestampNS[slot];
+        m_lastTimestampNS[slot] = sample.sensorTimestampNS;
+        if (prevNS && sample.sensorTimestampNS > prevNS) {
+            float rate = 1e9f / static_cast<float>(sample.sensorTimestampNS - prevNS);
+            float& observed = m_observedRate[slot];
+            observed = (observed > 0.0f) ? observed + (rate - observed) * SENSOR_RATE_SMOOTHING : rate;
+        }
+
+        // p͊ԈɑSTvŐi߂
+        if (slot == 0) {
+            m_orientation.ProcessGyro(sample.data, sample.sensorTimestampNS);
+        } else {
+            m_orientation.ProcessAccel(sample.data);
+        }
+
+        // Ԉ
+        if (m_decimationCounter[slot]++ % m_decimation != 0) return;
+    }
+
+    m_samples[m_writeCount % RING_CAPACITY] = sample;
+    m_writeCount++;
+}
+
+void SensorStream::BeginFrame() {
+    m_frameBegin = m_frameEnd;
+    m_frameEnd = m_writeCount;
+    m_orientation.TakeAimDelta(&m_worldGyroDelta, &m_playerGyroDelta);
+
+    // ǂ܂Oɏ㏑ꂽ
+    if (m_frameEnd - m_frameBegin > RING_CAPACITY) {
+        Uint64 lost = m_frameEnd - m_frameBegin - RING_CAPACITY;
+        m_droppedSamples += static_cast<Uint32>(lost);
+        m_frameBegin = m_frameEnd - RING_CAPACITY;
+    }
+}
+
+void SensorStream::Reset() {
+    m_frameBegin = m_frameEnd = m_writeCount;
+    m_lastTimestampNS[0] = m_lastTimestampNS[1] = 0;
+    m_observedRate[0] = m_observedRate[1] = 0.0f;
+    m_orientation.Reset();
+    m_worldGyroDelta = GyroAim();
+    m_playerGyroDelta = GyroAim();
+}
+
+int SensorStream::Copy(SensorSample* pOut, int maxCount) const {
+    int count = 0;
+    for (Uint64 i = m_frameBegin; i < m_frameEnd && count < maxCount; i++) {
+        pOut[count++] = m_samples[i % RING_CAPACITY];
+    }
+    return count;
+}
+
+float SensorStream::GetObservedRate(SDL_SensorType type) const {
+    int slot = SensorSlot(type);
+    return (slot >= 0) ? m_observedRate[slot] : 0.0f;
+}
+
+void SensorStream::SetDecimation(int factor) {
+    m_decimation = (factor < 1) ? 1 : factor;
+    m_decimationCounter[0] = m_decimationCounter[1] = 0;
+}
+
+//==============================================================================
+// ^b`Xg[
+//==============================================================================
+void TouchStream::Apply(const TouchSample& sample) {
+    TouchpadData::Finger& finger = m_touchpad.fingers[sample.touchpad][sample.finger];
+    finger.down = (sample.type != SDL_EVENT_GAMEPAD_TOUCHPAD_UP);
+    finger.x = sample.x;
+    finger.y = sample.y;
+    finger.pressure = finger.down ? sample.pressure : 0.0f;
+    finger.timestampNS = sample.timestampNS;
+
+    m_samples.Push(sample);
+
+    TouchGesture gesture;
+    if (m_recognizer.Process(sample, &gesture)) {
+        m_gestures.Push(gesture);
+    }
+}
+
+void TouchStream::BeginFrame() {
+    m_samples.BeginFrame();
+    m_gestures.BeginFrame();
+}
+
+void TouchStream::Reset() {
+    m_touchpad = {};
+    m_recognizer.Reset();
+    m_samples.Skip();
+    m_gestures.Skip();
+}
+
+//==============================================================================
+// U
+//==============================================================================
+void ControllerHaptics::Reset() {
+    m_scheduler.Reset();
+    m_rumbleHandle = -1;
+    m_triggerHandle = -1;
+}
+
+void ControllerHaptics::StartRumble(float leftMotor, float rightMotor, float duration, Uint64 nowNS) {
+    m_scheduler.Stop(m_rumbleHandle);
+    m_rumbleHandle = m_scheduler.Play(HapticEffect::Rumble(leftMotor, rightMotor, duration), nowNS);
+}
+
+void ControllerHaptics::StartTriggerRumble(float left, float right, float duration, Uint64 nowNS) {
+    m_scheduler.Stop(m_triggerHandle);
+    m_triggerHandle = m_scheduler.Play(HapticEffect::Trigger(left, right, duration), nowNS);
+}
+
+void ControllerHaptics::StopAll() {
+    m_scheduler.StopAll();
+    m_rumbleHandle = -1;
+    m_triggerHandle = -1;
+}
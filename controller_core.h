@@ -0,0 +1,1014 @@
+/*********************************************************************
+ * \file   controller_core.h
+ * \brief  CX^XPʂ̃Rg[[͏iobNGhƋ@\ev[gŎwj
+ *********************************************************************/
+#pragma once
+#include "controller_types.h"
+#include "response_curve.h"
+#include "haptics.h"
+#include "orientation.h"
+#include "touch_gesture.h"
+#include "input_recorder.h"
+#include "input_profiler.h"
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+//==============================================================================
+// @\tOiControllerCore  FEATURES ɑgݍ킹Ďw肷j
+//------------------------------------------------------------------------------
+// ɂ@\͏ԂAUpdate() Ă΂ȂiR[hȂjB
+// ȋ@\̎擾֐ĂԂƃRpCG[ɂȂB
+//==============================================================================
+namespace ControllerFeature {
+    constexpr Uint32 NONE = 0;
+    constexpr Uint32 SENSOR = 1u << 0;     // ZT[Xg[Ep
+    constexpr Uint32 TOUCHPAD = 1u << 1;   // ^b`pbhEWFX`[
+    constexpr Uint32 HAPTICS = 1u << 2;    // U
+    constexpr Uint32 LED = 1u << 3;        // LED
+    constexpr Uint32 ALL = SENSOR | TOUCHPAD | HAPTICS | LED;
+}
+
+//==============================================================================
+// foCX̕tւʒmiobNGh HandleDeviceSample() Ԃj
+//==============================================================================
+enum ControllerDeviceChange : Uint32 {
+    DEVICE_CHANGE_NONE = 0,
+    DEVICE_CHANGE_CLOSED = 1u << 0,     // JĂfoCX
+    DEVICE_CHANGE_OPENED = 1u << 1,     // foCXJiCLOSED ƓȂtւj
+};
+
+//==============================================================================
+// SDL CxgTvւ̕ϊiKvȂ̂ truej
+//==============================================================================
+namespace ControllerEvent {
+    bool MakeSample(const SDL_Event& event, InputSample* pSample);
+    bool MakeSensorSample(const SDL_Event& event, SensorSample* pSample);
+    bool MakeTouchSample(const SDL_Event& event, TouchSample* pSample);
+}
+
+//==============================================================================
+// t[PʂœǂݏoOiCfbNX͒ʎŽj
+//==============================================================================
+template<typename T, int N>
+struct FrameStream {
+    T items[N];
+    Uint64 writeCount = 0;
+    Uint64 frameBegin = 0;
+    Uint64 frameEnd = 0;
+
+    void Push(const T& item) {
+        items[writeCount % N] = item;
+        writeCount++;
+    }
+
+    void BeginFrame() {
+        frameBegin = frameEnd;
+        frameEnd = writeCount;
+
+        // ǂ܂Oɏ㏑ꂽ͎̂Ă
+        if (frameEnd - frameBegin > N) {
+            frameBegin = frameEnd - N;
+        }
+    }
+
+    void Skip() {
+        frameBegin = frameEnd = writeCount;
+    }
+
+    int GetCount() const {
+        return static_cast<int>(frameEnd - frameBegin);
+    }
+
+    int Copy(T* pOut, int maxCount) const {
+        int count = 0;
+        for (Uint64 i = frameBegin; i < frameEnd && count < maxCount; i++) {
+            pOut[count++] = items[i % N];
+        }
+        return count;
+    }
+};
+
+//==============================================================================
+// {^E̎荞݁i|[O / CxgʁAɗLj
+//==============================================================================
+class ButtonAxisState {
+public:
+    static constexpr int BUTTON_BIT_COUNT = 32;
+
+    // |[O{^iSOUTH ` MISC1j
+    static constexpr int BUTTON_POLL_COUNT = SDL_GAMEPAD_BUTTON_MISC1 + 1;
+
+    // ؒf
+    void Reset();
+
+    // Cxg̔figK[̓fW^{^ƂĈj
+    void ApplyButton(int bit, bool down);
+    void ApplyAxis(int axis, Sint16 value);
+
+    // |[O̔fibuttons ̃rbgʒu = SDL_GamepadButtonj
+    void SetPolled(uint32_t buttons, const Sint16* pAxes);
+
+    // t[ɔ{^CxgBBuild() ŏԂ֔f EndFrame() Œ߁A
+    // 񐔂͎̃t[܂ GetPressCount() / GetReleaseCount() œǂ߂悤ɂ
+    void ClearFrameEvents();
+    void EndFrame();
+    bool HasFrameEvents() const { return (m_frameTriggered | m_frameReleased) != 0; }
+    int GetPressCount(uint32_t mask) const;
+    int GetReleaseCount(uint32_t mask) const;
+
+    // 荞񂾒lԂit[ŉė̂GbWƂĎcj
+    void Build(GamepadState* pState, uint32_t prevButtons);
+
+    Sint16 GetRawAxis(int axis) const { return m_rawAxes[axis]; }
+    Sint16 GetProcessedAxis(int axis) const { return m_processedAxes[axis]; }
+
+    // J[uiݒ莞Ƀe[u𐶐j
+    void SetLeftStickCurve(const ResponseCurveSettings& settings);
+    void SetRightStickCurve(const ResponseCurveSettings& settings);
+    void SetTriggerCurve(const ResponseCurveSettings& settings);
+    const ResponseCurveSet& GetCurves() const { return m_curves; }
+
+    // ʃXbh牞J[uKpiݒ̕ύXƏdȂ蒼jB
+    // MAX_CURVE_RETRY 蒼Ăǂ߂Ȃ false
+    static constexpr int MAX_CURVE_RETRY = 64;
+    bool ProcessConcurrent(const Sint16* pRaw, Sint16* pOut) const;
+
+private:
+    // J[u̍ւiݒ m_curveSequence ɂj
+    template<typename Assign>
+    void WriteCurves(Assign assign);
+
+    uint32_t m_liveButtons = 0;
+    Sint16 m_rawAxes[SDL_GAMEPAD_AXIS_COUNT] = {};
+    Sint16 m_processedAxes[SDL_GAMEPAD_AXIS_COUNT] = {};
+    bool m_axesDirty = true;
+    ResponseCurveSet m_curves;
+    std::atomic<Uint32> m_curveSequence{ 0 };
+
+    // WviO Update() ̂Ƃɓ͂́j
+    uint32_t m_frameTriggered = 0;
+    uint32_t m_frameReleased = 0;
+    Uint8 m_pressCount[BUTTON_BIT_COUNT] = {};
+    Uint8 m_releaseCount[BUTTON_BIT_COUNT] = {};
+
+    // Õt[̉
+    Uint8 m_lastPressCount[BUTTON_BIT_COUNT] = {};
+    Uint8 m_lastReleaseCount[BUTTON_BIT_COUNT] = {};
+    bool m_hasLastCounts = false;
+};
+
+//==============================================================================
+// ZT[Xg[iControllerFeature::SENSORj
+//==============================================================================
+class SensorStream {
+public:
+    static constexpr int RING_CAPACITY = 2048;
+
+    // [gEp͊ԈȎSTvōXV
+    void Apply(const SensorSample& sample);
+    void BeginFrame();
+    void Reset();
+
+    // Õt[ɓ͂Tv
+    int GetCount() const { return static_cast<int>(m_frameEnd - m_frameBegin); }
+    int Copy(SensorSample* pOut, int maxCount) const;
+    Uint32 GetDroppedCount() const { return m_droppedSamples; }
+
+    float GetObservedRate(SDL_SensorType type) const;
+    void SetDecimation(int factor);
+
+    OrientationEstimator& GetOrientation() { return m_orientation; }
+    const OrientationEstimator& GetOrientation() const { return m_orientation; }
+    GyroAim GetWorldGyroDelta() const { return m_worldGyroDelta; }
+    GyroAim GetPlayerGyroDelta() const { return m_playerGyroDelta; }
+
+    // t[Pʂ̓͌ivCj󂯎l
+    void SetFrameData(const SensorData& data) { m_frameData = data; }
+    const SensorData& GetFrameData() const { return m_frameData; }
+
+private:
+    SensorSample m_samples[RING_CAPACITY];
+    Uint64 m_writeCount = 0;
+    Uint64 m_frameBegin = 0;
+    Uint64 m_frameEnd = 0;
+    Uint32 m_droppedSamples = 0;
+    int m_decimation = 1;
+    Uint32 m_decimationCounter[2] = {};
+    Uint64 m_lastTimestampNS[2] = {};
+    float m_observedRate[2] = {};
+
+    OrientationEstimator m_orientation;
+    GyroAim m_worldGyroDelta;
+    GyroAim m_playerGyroDelta;
+
+    SensorData m_frameData;
+};
+
+//==============================================================================
+// ^b`Xg[iControllerFeature::TOUCHPADj
+//==============================================================================
+class TouchStream {
+public:
+    static constexpr int SAMPLE_CAPACITY = 512;
+    static constexpr int GESTURE_CAPACITY = 64;
+
+    // ڑɈx݂̎w̏Ԃǂށiȍ~̓CxgōXVj
+    template<typename Backend>
+    void Open(Backend& backend) { backend.PollTouchpad(&m_touchpad); }
+
+    void Apply(const TouchSample& sample);
+    void BeginFrame();
+    void Reset();
+
+    const TouchpadData& GetTouchpad() const { return m_touchpad; }
+
+    // Õt[ɓ͂TvEFWFX`[
+    int GetSampleCount() const { return m_samples.GetCount(); }
+    int CopySamples(TouchSample* pOut, int maxCount) const { return m_samples.Copy(pOut, maxCount); }
+    int GetGestureCount() const { return m_gestures.GetCount(); }
+    int CopyGestures(TouchGesture* pOut, int maxCount) const { return m_gestures.Copy(pOut, maxCount); }
+    void SetGestureSettings(const TouchGestureSettings& settings) { m_recognizer.SetSettings(settings); }
+
+    // t[Pʂ̓͌ivCj󂯎l
+    void SetFrameData(const TouchpadData& data) { m_frameData = data; }
+    const TouchpadData& GetFrameData() const { return m_frameData; }
+
+private:
+    TouchpadData m_touchpad;
+    TouchGestureRecognizer m_recognizer;
+    FrameStream<TouchSample, SAMPLE_CAPACITY> m_samples;
+    FrameStream<TouchGesture, GESTURE_CAPACITY> m_gestures;
+
+    TouchpadData m_frameData;
+};
+
+//==============================================================================
+// UiControllerFeature::HAPTICSAStartRumble n͒ǑĂяõGtFNguj
+//==============================================================================
+class ControllerHaptics {
+public:
+    // ăobNGh̃foCX֏ށifoCX΍̂݁j
+    template<typename Backend>
+    void Update(Backend& backend, Uint64 nowNS) { m_scheduler.Update(backend.GetGamepad(), nowNS); }
+
+    template<typename Backend>
+    void Silence(Backend& backend) { m_scheduler.Silence(backend.GetGamepad()); }
+
+    void Reset();
+    void SetOutputSlot(int slot) { m_scheduler.SetOutputSlot(slot); }
+
+    int Play(const HapticEffect& effect, Uint64 nowNS) { return m_scheduler.Play(effect, nowNS); }
+    void Stop(int handle) { m_scheduler.Stop(handle); }
+    void StartRumble(float leftMotor, float rightMotor, float duration, Uint64 nowNS);
+    void StartTriggerRumble(float left, float right, float duration, Uint64 nowNS);
+    void StopAll();
+
+    bool IsActive() const { return m_scheduler.IsActive(); }
+    const HapticScheduler& GetScheduler() const { return m_scheduler; }
+
+private:
+    HapticScheduler m_scheduler;
+    int m_rumbleHandle = -1;
+    int m_triggerHandle = -1;
+};
+
+//==============================================================================
+// ȋ@\̑iȂj
+//==============================================================================
+struct NoSensorStream {
+    void Apply(const SensorSample&) {}
+    void BeginFrame() {}
+    void Reset() {}
+    void SetFrameData(const SensorData&) {}
+    SensorData GetFrameData() const { return SensorData{}; }
+};
+
+struct NoTouchStream {
+    template<typename Backend>
+    void Open(Backend&) {}
+    void Apply(const TouchSample&) {}
+    void BeginFrame() {}
+    void Reset() {}
+    void SetFrameData(const TouchpadData&) {}
+};
+
+struct NoControllerHaptics {
+    template<typename Backend>
+    void Update(Backend&, Uint64) {}
+    template<typename Backend>
+    void Silence(Backend&) {}
+    void Reset() {}
+    void SetOutputSlot(int) {}
+};
+
+//==============================================================================
+// Rg[[͂̃RA
+//------------------------------------------------------------------------------
+// 1 CX^X 1 ̃Rg[[Ɨ̓ReLXgB
+// Q[pƃGfB^pȂǕ𓯎ɎĂB
+//
+// Backendicontroller_backend.hj͂̎荞݂ƃfoCXւ̏o͂SA
+// RA̓obNGhɈˑȂiJ[uEGbWEXg[EU̍jsB
+// Backend::IS_FRAME_SOURCE  true ̃obNGhivCj ReadFrame() 
+// 1 t[̏Ԃ܂Ƃ߂ēnAȊO̓Tv Apply*() ֓nB
+//
+// Ԃ傫iZT[L 100KB ĵŁAÓIɒuq[vɊmۂ邱ƁB
+//==============================================================================
+template<typename Backend, Uint32 FEATURES = ControllerFeature::ALL>
+class ControllerCore {
+public:
+    static constexpr bool HAS_SENSOR = (FEATURES & ControllerFeature::SENSOR) != 0;
+    static constexpr bool HAS_TOUCHPAD = (FEATURES & ControllerFeature::TOUCHPAD) != 0;
+    static constexpr bool HAS_HAPTICS = (FEATURES & ControllerFeature::HAPTICS) != 0;
+    static constexpr bool HAS_LED = (FEATURES & ControllerFeature::LED) != 0;
+    static constexpr int FRAME_SAMPLE_CAPACITY = 1024;
+    static constexpr int LATCH_MAX_RETRY = 64;     // xb`Jlǂݒ
+
+    ControllerCore() = default;
+    ControllerCore(const ControllerCore&) = delete;
+    ControllerCore& operator=(const ControllerCore&) = delete;
+
+    // EIEXV
+    bool Initialize();
+    void Finalize();
+    void Update();
+
+    // ŎoCxgniO Update() ̂Ƃɓn̂́Aė̂
+    // ܂߂Ď Update() ̃GbWɂȂj
+    bool ProcessEvent(const SDL_Event& event);
+
+    // 񓯊iԂ̂镔obNGh̍ƃXbhōsjB
+    // ܂ Update() ͖ڑ̂܂܉A Update() ̒
+    // pCallback ĂԁBfalseiƃXbhȂjȂR[obN͌Ă΂Ȃ
+    bool InitializeAsync(InitCallback pCallback = nullptr, void* pUserData = nullptr);
+    InitStatus GetInitStatus() const { return m_initStatus; }
+
+    Backend& GetBackend() { return m_backend; }
+    const Backend& GetBackend() const { return m_backend; }
+
+    // ͎荞݃[h
+    void SetInputMode(InputMode mode);
+    InputMode GetInputMode() const { return m_inputMode; }
+
+    // ̓XbhiobNGhΉĂꍇ̂݁j
+    bool StartInputThread(Uint32 pollIntervalUS);
+    void StopInputThread();
+    bool IsInputThreadRunning() const { return m_backend.IsInputThreadRunning(); }
+
+    // vCiĐ̓obNGhg킸AL^t[ 1 i߂j
+    void StartReplay(InputReplay* pReplay);
+    void StopReplay();
+    bool IsReplaying() const { return m_pReplay != nullptr; }
+
+    // O Update() Ŏ荞񂾃Tv
+    const InputSample* GetFrameSamples() const { return m_frameSamples; }
+    int GetFrameSampleCount() const { return m_frameSampleCount; }
+
+    // Ԏ擾
+    const GamepadState& GetCurrentState() const { return m_currentState; }
+    const GamepadState& GetPrevState() const { return m_prevState; }
+    const DeviceInfo& GetDeviceInfo() const { return m_backend.GetDeviceInfo(); }
+    bool IsConnected() const { return m_currentState.connected; }
+
+    // xb`FgOɃXeBbNEZT[foCXǂݒi`XbhĂׂjB
+    // J[u͓Kp邪AGetCurrentState() GbWEXg[͕ςȂB
+    // refresh  SDL_UpdateGamepads() ōXVĂǂށi̓XbhAUpdate() 
+    // XbhĂԏꍇ̂݁jB̓Xbh쒆̓foCX̍XV̒lǂ߂B
+    // vC͒O Update() ŌJt[̒lԂBUpdate() ≞J[u
+    // ύXƂ̓V[PXbNŕĂAǂ߂ȂƂ valid  false ɂȂB
+    LateLatchState LatchLate(bool refresh = false) const;
+
+    // ͂͂ deadlineNSiSDL_GetTicksNS j߂܂ő҂B͂ trueB
+    // Cxg͎oȂ̂ŁA Update() ĂԂ
+    bool WaitForInput(Uint64 deadlineNS) const { return m_backend.WaitForInput(deadlineNS); }
+
+    // Õt[ɉꂽ / ꂽ񐔁iCxg[ĥ݁j
+    int GetPressCount(uint32_t mask) const { return m_input.GetPressCount(mask); }
+    int GetReleaseCount(uint32_t mask) const { return m_input.GetReleaseCount(mask); }
+
+    // Œ菬_̒lil / J[uKpA-32768 ` 32767j
+    Sint16 GetRawAxis(SDL_GamepadAxis axis) const { return IsValidAxis(axis) ? m_input.GetRawAxis(axis) : 0; }
+    Sint16 GetProcessedAxis(SDL_GamepadAxis axis) const { return IsValidAxis(axis) ? m_input.GetProcessedAxis(axis) : 0; }
+
+    // J[u
+    void SetLeftStickCurve(const ResponseCurveSettings& settings) { m_input.SetLeftStickCurve(settings); }
+    void SetRightStickCurve(const ResponseCurveSettings& settings) { m_input.SetRightStickCurve(settings); }
+    void SetTriggerCurve(const ResponseCurveSettings& settings) { m_input.SetTriggerCurve(settings); }
+    const ResponseCurveSet& GetResponseCurves() const { return m_input.GetCurves(); }
+
+    // UiControllerFeature::HAPTICSj
+    void StartVibrationEx(float leftMotor, float rightMotor, float duration);
+    void StartTriggerVibration(float left, float right, float duration);
+    void StopVibration();
+    bool IsVibrating() const { RequireHaptics(); return m_haptics.IsActive(); }
+    int PlayHapticEffect(const HapticEffect& effect);
+    void StopHapticEffect(int handle) { RequireHaptics(); m_haptics.Stop(handle); }
+    const HapticScheduler& GetHaptics() const { RequireHaptics(); return m_haptics.GetScheduler(); }
+
+    // LEDiControllerFeature::LEDj
+    bool SetLED(uint8_t r, uint8_t g, uint8_t b);
+
+    // ZT[iControllerFeature::SENSORj
+    bool EnableSensor(SDL_SensorType type, bool enable);
+    SensorData GetSensorData() const;
+    int GetSensorSampleCount() const { RequireSensor(); return m_sensor.GetCount(); }
+    int GetSensorSamples(SensorSample* pOut, int maxCount) const { RequireSensor(); return m_sensor.Copy(pOut, maxCount); }
+    float GetSensorDataRate(SDL_SensorType type) const { RequireSensor(); return m_backend.GetSensorDataRate(type); }
+    float GetObservedSensorRate(SDL_SensorType type) const { RequireSensor(); return m_sensor.GetObservedRate(type); }
+    void SetSensorDecimation(int factor) { RequireSensor(); m_sensor.SetDecimation(factor); }
+    Uint32 GetDroppedSensorSampleCount() const { RequireSensor(); return m_sensor.GetDroppedCount(); }
+
+    // piControllerFeature::SENSORj
+    const OrientationEstimator& GetOrientation() const { RequireSensor(); return m_sensor.GetOrientation(); }
+    void SetOrientationSettings(const OrientationSettings& settings) { RequireSensor(); m_sensor.GetOrientation().SetSettings(settings); }
+    void ResetOrientationYaw() { RequireSensor(); m_sensor.GetOrientation().ResetYaw(); }
+    GyroAim GetWorldGyroDelta() const { RequireSensor(); return m_sensor.GetWorldGyroDelta(); }
+    GyroAim GetPlayerGyroDelta() const { RequireSensor(); return m_sensor.GetPlayerGyroDelta(); }
+
+    // ^b`pbhiControllerFeature::TOUCHPADj
+    const TouchpadData& GetTouchpadData() const;
+    int GetTouchSampleCount() const { RequireTouchpad(); return m_touch.GetSampleCount(); }
+    int GetTouchSamples(TouchSample* pOut, int maxCount) const { RequireTouchpad(); return m_touch.CopySamples(pOut, maxCount); }
+    int GetTouchGestureCount() const { RequireTouchpad(); return m_touch.GetGestureCount(); }
+    int GetTouchGestures(TouchGesture* pOut, int maxCount) const { RequireTouchpad(); return m_touch.CopyGestures(pOut, maxCount); }
+    void SetTouchGestureSettings(const TouchGestureSettings& settings) { RequireTouchpad(); m_touch.SetGestureSettings(settings); }
+
+    // obNGhĂԁi܂͂ 1 fj
+    void ApplySample(const InputSample& sample);
+    void ApplySensorSample(const SensorSample& sample);
+    void ApplyTouchSample(const TouchSample& sample);
+
+private:
+    using SensorStorage = typename std::conditional<HAS_SENSOR, SensorStream, NoSensorStream>::type;
+    using TouchStorage = typename std::conditional<HAS_TOUCHPAD, TouchStream, NoTouchStream>::type;
+    using HapticsStorage = typename std::conditional<HAS_HAPTICS, ControllerHaptics, NoControllerHaptics>::type;
+    using FrameSourceTag = std::integral_constant<bool, Backend::IS_FRAME_SOURCE>;
+
+    // xb` Update() ̃Xbh̏ԂǂޒliUpdate() ̏IɌJj
+    struct LatchFrame {
+        float leftStickX;
+        float leftStickY;
+        float rightStickX;
+        float rightStickY;
+        SensorData sensor;
+        bool connected;
+        bool frameDriven;       // t[Pʂ̓́ifoCXǂݒȂj
+        bool inputThread;       // ̓Xbh쒆irefresh Ȃj
+    };
+
+    static bool IsValidAxis(SDL_GamepadAxis axis) { return axis >= 0 && axis < SDL_GAMEPAD_AXIS_COUNT; }
+
+    static void RequireSensor() { static_assert(HAS_SENSOR, "ControllerFeature::SENSOR is disabled"); }
+    static void RequireTouchpad() { static_assert(HAS_TOUCHPAD, "ControllerFeature::TOUCHPAD is disabled"); }
+    static void RequireHaptics() { static_assert(HAS_HAPTICS, "ControllerFeature::HAPTICS is disabled"); }
+    static void RequireLED() { static_assert(HAS_LED, "ControllerFeature::LED is disabled"); }
+
+    // t[Pʂ̓́iobNGht[PʂAvCj
+    bool IsFrameDriven() const { return Backend::IS_FRAME_SOURCE || m_pReplay; }
+
+    void ClearState();
+    bool PollInitialize();
+    void UpdateFromBackend(std::false_type);
+    void UpdateFromBackend(std::true_type);
+    void UpdateReplay();
+    void ApplyFrame(const RecordedFrame& frame);
+    void EndFrames();
+    void UpdateState();
+    void PollDevice();
+    void HandleDeviceChange(Uint32 change);
+    void PublishLatchFrame();
+    bool ReadLatchFrame(LatchFrame* pOut) const;
+    void OnDeviceOpened();
+    void ResetDeviceState();
+
+    Backend m_backend;
+    InputMode m_inputMode = InputMode::Polling;
+
+    InitStatus m_initStatus = InitStatus::NotStarted;
+    InitCallback m_pInitCallback = nullptr;
+    void* m_pInitUserData = nullptr;
+
+    GamepadState m_currentState;
+    GamepadState m_prevState;
+    ButtonAxisState m_input;
+
+    InputSample m_frameSamples[FRAME_SAMPLE_CAPACITY];
+    int m_frameSampleCount = 0;
+
+    SensorStorage m_sensor;
+    TouchStorage m_touch;
+    HapticsStorage m_haptics;
+
+    InputReplay* m_pReplay = nullptr;
+
+    // xb`œǂރfoCXiJĂԂ 0 ȊOj
+    std::atomic<SDL_JoystickID> m_latchId{ 0 };
+
+    // xb`pɌJliݒ m_latchSequence ɂj
+    LatchFrame m_latchFrame = {};
+    std::atomic<Uint32> m_latchSequence{ 0 };
+};
+
+//==============================================================================
+// EI
+//==============================================================================
+template<typename Backend, Uint32 FEATURES>
+bool ControllerCore<Backend, FEATURES>::Initialize() {
+    ClearState();
+
+    if (!m_backend.Initialize()) {
+        m_initStatus = InitStatus::Failed;
+        return false;
+    }
+    m_initStatus = InitStatus::Ready;
+
+    if (m_backend.IsOpen()) {
+        OnDeviceOpened();
+    }
+    return true;
+}
+
+template<typename Backend, Uint32 FEATURES>
+bool ControllerCore<Backend, FEATURES>::InitializeAsync(InitCallback pCallback, void* pUserData) {
+    ClearState();
+    m_pInitCallback = pCallback;
+    m_pInitUserData = pUserData;
+
+    if (!m_backend.BeginInitialize()) {
+        m_initStatus = InitStatus::Failed;
+        return false;
+    }
+    m_initStatus = InitStatus::Pending;
+    return true;
+}
+
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::Finalize() {
+    StopInputThread();
+    m_haptics.Silence(m_backend);
+    m_backend.Finalize();
+    ResetDeviceState();
+    m_initStatus = InitStatus::NotStarted;
+}
+
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::ClearState() {
+    m_currentState = {};
+    m_prevState = {};
+    m_input.Reset();
+    m_input.ClearFrameEvents();
+    m_haptics.Reset();
+}
+
+// ƃXbhIĂΎcς܂Ēʒmi܂Ȃ falsej
+template<typename Backend, Uint32 FEATURES>
+bool ControllerCore<Backend, FEATURES>::PollInitialize() {
+    InitStatus status = m_backend.PollInitialize();
+    if (status == InitStatus::Pending) return false;
+
+    m_initStatus = status;
+    if (status == InitStatus::Ready && m_backend.IsOpen()) {
+        OnDeviceOpened();
+    }
+
+    InitCallback pCallback = m_pInitCallback;
+    m_pInitCallback = nullptr;
+    if (pCallback) {
+        pCallback(status == InitStatus::Ready, m_pInitUserData);
+    }
+    return status == InitStatus::Ready;
+}
+
+//==============================================================================
+// XV
+//==============================================================================
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::Update() {
+    GC_PROFILE_SCOPE(PROFILE_UPDATE_TOTAL);
+
+    // 񓯊̊҂i܂ł͖ڑ̂܂܁j
+    if (m_initStatus == InitStatus::Pending && !PollInitialize()) return;
+
+    m_frameSampleCount = 0;
+
+    if (m_pReplay) {
+        UpdateReplay();
+    } else {
+        UpdateFromBackend(FrameSourceTag());
+    }
+
+    // ԂIĂCxgWv߂iO Update() ̂Ƃ ProcessEvent() 
+    // nꂽėÃt[̃GbWɎcj
+    m_input.EndFrame();
+    PublishLatchFrame();
+
+    // UGtFNgAω΃foCX 1 񂾂
+    GC_PROFILE_SCOPE(PROFILE_UPDATE_HAPTICS);
+    m_haptics.Update(m_backend, SDL_GetTicksNS());
+}
+
+// TvPʂ̃obNGh
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::UpdateFromBackend(std::false_type) {
+    {
+        GC_PROFILE_SCOPE(PROFILE_UPDATE_POLL);
+        m_backend.Pump(*this);
+    }
+    {
+        GC_PROFILE_SCOPE(PROFILE_UPDATE_SENSOR);
+        m_sensor.BeginFrame();
+    }
+    m_touch.BeginFrame();
+    {
+        GC_PROFILE_SCOPE(PROFILE_UPDATE_STATE);
+        UpdateState();
+    }
+}
+
+// t[Pʂ̃obNGh
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::UpdateFromBackend(std::true_type) {
+    RecordedFrame frame;
+    if (m_backend.ReadFrame(&frame)) {
+        ApplyFrame(frame);
+    } else {
+        EndFrames();
+    }
+}
+
+//==============================================================================
+// Cxg
+//==============================================================================
+template<typename Backend, Uint32 FEATURES>
+bool ControllerCore<Backend, FEATURES>::ProcessEvent(const SDL_Event& event) {
+    InputSample sample;
+    if (ControllerEvent::MakeSample(event, &sample)) {
+        ApplySample(sample);
+        return true;
+    }
+
+    SensorSample sensorSample;
+    if (ControllerEvent::MakeSensorSample(event, &sensorSample)) {
+        ApplySensorSample(sensorSample);
+        return true;
+    }
+
+    TouchSample touchSample;
+    if (ControllerEvent::MakeTouchSample(event, &touchSample)) {
+        ApplyTouchSample(touchSample);
+        return true;
+    }
+    return false;
+}
+
+//==============================================================================
+// ͎荞݃[hݒ
+//==============================================================================
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::SetInputMode(InputMode mode) {
+    if (m_inputMode == mode || m_backend.IsInputThreadRunning()) return;
+
+    m_inputMode = mode;
+    m_input.ClearFrameEvents();
+
+    // ؂ւ_̏Ԃɍ킹
+    if (m_backend.IsOpen()) {
+        PollDevice();
+    }
+}
+
+//==============================================================================
+// ̓XbhJnE~i쒆̓Cxg[hŒj
+//==============================================================================
+template<typename Backend, Uint32 FEATURES>
+bool ControllerCore<Backend, FEATURES>::StartInputThread(Uint32 pollIntervalUS) {
+    if (m_backend.IsInputThreadRunning()) return true;
+    if (m_initStatus == InitStatus::Pending) return false;
+
+    SetInputMode(InputMode::Event);
+    bool started = m_backend.StartInputThread(pollIntervalUS);
+    PublishLatchFrame();
+    return started;
+}
+
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::StopInputThread() {
+    if (!m_backend.IsInputThreadRunning()) return;
+
+    // cTv𔽉fĂ
+    m_backend.StopInputThread();
+    m_backend.DrainInputThread(*this);
+}
+
+//==============================================================================
+// vC
+//==============================================================================
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::StartReplay(InputReplay* pReplay) {
+    m_pReplay = (pReplay && pReplay->IsOpen()) ? pReplay : nullptr;
+    m_currentState = {};
+    m_prevState = {};
+    m_sensor.SetFrameData(SensorData{});
+    m_touch.SetFrameData(TouchpadData{});
+    PublishLatchFrame();
+}
+
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::StopReplay() {
+    if (!m_pReplay) return;
+
+    m_pReplay = nullptr;
+    m_currentState = {};
+    m_prevState = {};
+    PublishLatchFrame();
+}
+
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::UpdateReplay() {
+    RecordedFrame frame;
+    if (m_pReplay->ReadNext(&frame)) {
+        ApplyFrame(frame);
+    } else {
+        m_pReplay = nullptr;
+        EndFrames();
+    }
+}
+
+// L^̃GbWit[̒Z܂ށĵ܂܎g
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::ApplyFrame(const RecordedFrame& frame) {
+    m_prevState = m_currentState;
+    m_currentState = frame.state;
+    m_sensor.SetFrameData(frame.hasSensor ? frame.sensor : SensorData{});
+    m_touch.SetFrameData(frame.hasTouchpad ? frame.touchpad : TouchpadData{});
+}
+
+// I[FڑƂĎ~߂
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::EndFrames() {
+    m_prevState = m_currentState;
+    m_currentState = {};
+    m_currentState.UpdateEdges(m_prevState.buttons);
+}
+
+//==============================================================================
+// Tv̔f
+//==============================================================================
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::ApplySample(const InputSample& sample) {
+    GC_PROFILE_ONLY(if (!m_pReplay) GC_PROFILE_EVENT(sample.which, sample.timestampNS);)
+    if (m_frameSampleCount < FRAME_SAMPLE_CAPACITY) {
+        m_frameSamples[m_frameSampleCount++] = sample;
+    }
+
+    switch (sample.type) {
+    case SDL_EVENT_GAMEPAD_ADDED:
+    case SDL_EVENT_GAMEPAD_REMOVED:
+    case SDL_EVENT_GAMEPAD_REMAPPED:
+    case SDL_EVENT_JOYSTICK_BATTERY_UPDATED:
+        HandleDeviceChange(m_backend.HandleDeviceSample(sample));
+        break;
+
+    case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+    case SDL_EVENT_GAMEPAD_BUTTON_UP:
+        if (m_inputMode == InputMode::Event && m_backend.IsOpen() &&
+            sample.which == m_backend.GetId() && sample.index < ButtonAxisState::BUTTON_POLL_COUNT) {
+            m_input.ApplyButton(sample.index, sample.value != 0);
+        }
+        break;
+
+    case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+        if (m_inputMode == InputMode::Event && m_backend.IsOpen() &&
+            sample.which == m_backend.GetId() && sample.index < SDL_GAMEPAD_AXIS_COUNT) {
+            m_input.ApplyAxis(sample.index, sample.value);
+        }
+        break;
+    }
+}
+
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::ApplySensorSample(const SensorSample& sample) {
+    if (!HAS_SENSOR || !m_backend.IsOpen() || sample.which != m_backend.GetId()) return;
+    GC_PROFILE_ONLY(if (!m_pReplay) GC_PROFILE_EVENT(sample.which, sample.timestampNS);)
+
+    m_sensor.Apply(sample);
+}
+
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::ApplyTouchSample(const TouchSample& sample) {
+    if (!HAS_TOUCHPAD || !m_backend.IsOpen() || sample.which != m_backend.GetId()) return;
+    GC_PROFILE_ONLY(if (!m_pReplay) GC_PROFILE_EVENT(sample.which, sample.timestampNS);)
+
+    m_touch.Apply(sample);
+}
+
+//==============================================================================
+// foCX̕tւ
+//==============================================================================
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::HandleDeviceChange(Uint32 change) {
+    if (change & DEVICE_CHANGE_CLOSED) {
+        ResetDeviceState();
+    }
+    if (change & DEVICE_CHANGE_OPENED) {
+        OnDeviceOpened();
+    }
+}
+
+// ڑ_ŉĂ{^EGĂw荞
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::OnDeviceOpened() {
+    m_haptics.SetOutputSlot(m_backend.GetOutputSlot());
+    PollDevice();
+    m_touch.Open(m_backend);
+    m_latchId.store(m_backend.GetId(), std::memory_order_release);
+}
+
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::ResetDeviceState() {
+    m_latchId.store(0, std::memory_order_release);
+    m_currentState = {};
+    m_input.Reset();
+    m_input.ClearFrameEvents();
+    m_sensor.Reset();
+    m_touch.Reset();
+    m_haptics.Reset();
+    m_haptics.SetOutputSlot(-1);
+    PublishLatchFrame();
+}
+
+//==============================================================================
+// ԍXV
+//==============================================================================
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::PollDevice() {
+    uint32_t buttons = 0;
+    Sint16 axes[SDL_GAMEPAD_AXIS_COUNT];
+    m_backend.Poll(&buttons, axes);
+    m_input.SetPolled(buttons, axes);
+}
+
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::UpdateState() {
+    m_prevState = m_currentState;
+
+    if (!m_backend.IsOpen()) {
+        m_currentState.connected = false;
+        m_currentState.UpdateEdges(m_prevState.buttons);
+        return;
+    }
+
+    m_currentState.connected = true;
+
+    if (m_inputMode == InputMode::Polling) {
+        PollDevice();
+    }
+
+    m_input.Build(&m_currentState, m_prevState.buttons);
+}
+
+//==============================================================================
+// xb`
+//==============================================================================
+// Update() ̃Xbh̏ԂJiݒ sequence ɂj
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::PublishLatchFrame() {
+    LatchFrame frame;
+    frame.leftStickX = m_currentState.leftStickX;
+    frame.leftStickY = m_currentState.leftStickY;
+    frame.rightStickX = m_currentState.rightStickX;
+    frame.rightStickY = m_currentState.rightStickY;
+    frame.sensor = IsFrameDriven() ? m_sensor.GetFrameData() : SensorData{};
+    frame.connected = m_currentState.connected;
+    frame.frameDriven = IsFrameDriven();
+    frame.inputThread = m_backend.IsInputThreadRunning();
+
+    Uint32 sequence = m_latchSequence.load(std::memory_order_relaxed);
+    m_latchSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&m_latchFrame, &frame, sizeof(LatchFrame));
+    m_latchSequence.store(sequence + 2, std::memory_order_release);
+}
+
+template<typename Backend, Uint32 FEATURES>
+bool ControllerCore<Backend, FEATURES>::ReadLatchFrame(LatchFrame* pOut) const {
+    for (int attempt = 0; attempt < LATCH_MAX_RETRY; attempt++) {
+        Uint32 before = m_latchSequence.load(std::memory_order_acquire);
+        if (before & 1u) continue;
+
+        std::memcpy(pOut, &m_latchFrame, sizeof(LatchFrame));
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (m_latchSequence.load(std::memory_order_relaxed) == before) return true;
+    }
+    return false;
+}
+
+template<typename Backend, Uint32 FEATURES>
+LateLatchState ControllerCore<Backend, FEATURES>::LatchLate(bool refresh) const {
+    LateLatchState latch;
+    latch.timestampNS = SDL_GetTicksNS();
+
+    // Update() ̓r̒l͓ǂ܂ȂiJς݂̒lgj
+    LatchFrame frame;
+    if (!ReadLatchFrame(&frame)) return latch;
+
+    // L^t[Vl͖
+    if (frame.frameDriven) {
+        latch.leftStickX = frame.leftStickX;
+        latch.leftStickY = frame.leftStickY;
+        latch.rightStickX = frame.rightStickX;
+        latch.rightStickY = frame.rightStickY;
+        latch.sensor = frame.sensor;
+        latch.valid = frame.connected;
+        return latch;
+    }
+
+    Sint16 rawAxes[SDL_GAMEPAD_AXIS_COUNT];
+    refresh = refresh && !frame.inputThread;
+    if (!m_backend.Latch(m_latchId.load(std::memory_order_acquire), refresh,
+            rawAxes, HAS_SENSOR ? &latch.sensor : nullptr)) {
+        return latch;
+    }
+
+    Sint16 processedAxes[SDL_GAMEPAD_AXIS_COUNT];
+    if (!m_input.ProcessConcurrent(rawAxes, processedAxes)) {
+        latch.sensor = SensorData{};
+        return latch;
+    }
+    latch.leftStickX = ResponseCurve::ToFloat(processedAxes[SDL_GAMEPAD_AXIS_LEFTX]);
+    latch.leftStickY = ResponseCurve::ToFloat(processedAxes[SDL_GAMEPAD_AXIS_LEFTY]);
+    latch.rightStickX = ResponseCurve::ToFloat(processedAxes[SDL_GAMEPAD_AXIS_RIGHTX]);
+    latch.rightStickY = ResponseCurve::ToFloat(processedAxes[SDL_GAMEPAD_AXIS_RIGHTY]);
+    latch.valid = true;
+    return latch;
+}
+
+//==============================================================================
+// U
+//==============================================================================
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::StartVibrationEx(float leftMotor, float rightMotor, float duration) {
+    RequireHaptics();
+    if (!m_backend.IsOpen()) return;
+    m_haptics.StartRumble(leftMotor, rightMotor, duration, SDL_GetTicksNS());
+}
+
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::StartTriggerVibration(float left, float right, float duration) {
+    RequireHaptics();
+    if (!m_backend.IsOpen()) return;
+    m_haptics.StartTriggerRumble(left, right, duration, SDL_GetTicksNS());
+}
+
+//  Update()  0 
+template<typename Backend, Uint32 FEATURES>
+void ControllerCore<Backend, FEATURES>::StopVibration() {
+    RequireHaptics();
+    m_haptics.StopAll();
+}
+
+template<typename Backend, Uint32 FEATURES>
+int ControllerCore<Backend, FEATURES>::PlayHapticEffect(const HapticEffect& effect) {
+    RequireHaptics();
+    if (!m_backend.IsOpen()) return -1;
+    return m_haptics.Play(effect, SDL_GetTicksNS());
+}
+
+//==============================================================================
+// LED
+//==============================================================================
+template<typename Backend, Uint32 FEATURES>
+bool ControllerCore<Backend, FEATURES>::SetLED(uint8_t r, uint8_t g, uint8_t b) {
+    RequireLED();
+    if (!m_backend.IsOpen()) return false;
+    return m_backend.SetLED(r, g, b);
+}
+
+//==============================================================================
+// ZT[
+//==============================================================================
+template<typename Backend, Uint32 FEATURES>
+bool ControllerCore<Backend, FEATURES>::EnableSensor(SDL_SensorType type, bool enable) {
+    RequireSensor();
+    if (!m_backend.IsOpen()) return false;
+    return m_backend.EnableSensor(type, enable);
+}
+
+template<typename Backend, Uint32 FEATURES>
+SensorData ControllerCore<Backend, FEATURES>::GetSensorData() const {
+    RequireSensor();
+    if (IsFrameDriven()) return m_sensor.GetFrameData();
+    if (!m_backend.IsOpen()) return SensorData{};
+    return m_backend.ReadSensorData();
+}
+
+//==============================================================================
+// ^b`pbh
+//==============================================================================
+template<typename Backend, Uint32 FEATURES>
+const TouchpadData& ControllerCore<Backend, FEATURES>::GetTouchpadData() const {
+    RequireTouchpad();
+    return IsFrameDriven() ? m_touch.GetFrameData() : m_touch.GetTouchpad();
+}
@@ -0,0 +1,256 @@
+/*********************************************************************
+ * \file   controller_types.h
+ * \brief  Rg[[͂̋ʂ̌^iԁEZT[E^b`EfoCXj
+ *********************************************************************/
+#pragma once
+#include <SDL3/SDL.h>
+#include <cmath>
+#include <cstdint>
+
+//==============================================================================
+// {^rbg}XN
+//==============================================================================
+// rbgʒu SDL_GamepadButton ̒lɍ킹ĂiL2/R2 ̓gK[̃fW^j
+enum GamepadButtonMask : uint32_t {
+    BUTTON_MASK_DOWN = 1u << SDL_GAMEPAD_BUTTON_SOUTH,      // A / ~ / B(Switch)
+    BUTTON_MASK_RIGHT = 1u << SDL_GAMEPAD_BUTTON_EAST,      // B /  / A(Switch)
+    BUTTON_MASK_LEFT = 1u << SDL_GAMEPAD_BUTTON_WEST,       // X /  / Y(Switch)
+    BUTTON_MASK_UP = 1u << SDL_GAMEPAD_BUTTON_NORTH,        // Y /  / X(Switch)
+    BUTTON_MASK_SELECT = 1u << SDL_GAMEPAD_BUTTON_BACK,     // Back / Share / -
+    BUTTON_MASK_GUIDE = 1u << SDL_GAMEPAD_BUTTON_GUIDE,     // Xbox{^ / PS{^ / Home{^
+    BUTTON_MASK_START = 1u << SDL_GAMEPAD_BUTTON_START,     // Start / Options / +
+    BUTTON_MASK_L3 = 1u << SDL_GAMEPAD_BUTTON_LEFT_STICK,
+    BUTTON_MASK_R3 = 1u << SDL_GAMEPAD_BUTTON_RIGHT_STICK,
+    BUTTON_MASK_L1 = 1u << SDL_GAMEPAD_BUTTON_LEFT_SHOULDER,
+    BUTTON_MASK_R1 = 1u << SDL_GAMEPAD_BUTTON_RIGHT_SHOULDER,
+    BUTTON_MASK_DPAD_UP = 1u << SDL_GAMEPAD_BUTTON_DPAD_UP,
+    BUTTON_MASK_DPAD_DOWN = 1u << SDL_GAMEPAD_BUTTON_DPAD_DOWN,
+    BUTTON_MASK_DPAD_LEFT = 1u << SDL_GAMEPAD_BUTTON_DPAD_LEFT,
+    BUTTON_MASK_DPAD_RIGHT = 1u << SDL_GAMEPAD_BUTTON_DPAD_RIGHT,
+    BUTTON_MASK_MISC = 1u << SDL_GAMEPAD_BUTTON_MISC1,      // Share / Mic / Capture
+    BUTTON_MASK_L2 = 1u << SDL_GAMEPAD_BUTTON_COUNT,
+    BUTTON_MASK_R2 = 1u << (SDL_GAMEPAD_BUTTON_COUNT + 1),
+
+    // O[v
+    BUTTON_MASK_FACE = BUTTON_MASK_DOWN | BUTTON_MASK_RIGHT | BUTTON_MASK_LEFT | BUTTON_MASK_UP,
+    BUTTON_MASK_DPAD = BUTTON_MASK_DPAD_UP | BUTTON_MASK_DPAD_DOWN | BUTTON_MASK_DPAD_LEFT | BUTTON_MASK_DPAD_RIGHT,
+    BUTTON_MASK_ALL = BUTTON_MASK_FACE | BUTTON_MASK_DPAD |
+        BUTTON_MASK_SELECT | BUTTON_MASK_GUIDE | BUTTON_MASK_START |
+        BUTTON_MASK_L1 | BUTTON_MASK_R1 | BUTTON_MASK_L2 | BUTTON_MASK_R2 |
+        BUTTON_MASK_L3 | BUTTON_MASK_R3 | BUTTON_MASK_MISC,
+};
+
+//==============================================================================
+// Q[pbhԍ\
+//==============================================================================
+struct GamepadState {
+    // XeBbNi-1.0 ~ 1.0j
+    float leftStickX = 0.0f;
+    float leftStickY = 0.0f;
+
+    // EXeBbNi-1.0 ~ 1.0j
+    float rightStickX = 0.0f;
+    float rightStickY = 0.0f;
+
+    // gK[i0.0 ~ 1.0j
+    float leftTrigger = 0.0f;
+    float rightTrigger = 0.0f;
+
+    // {^iGamepadButtonMask ̑gݍ킹j
+    uint32_t buttons = 0;     // ݉Ă
+    uint32_t triggered = 0;   // ̃t[ŉꂽ
+    uint32_t released = 0;    // ̃t[ŗꂽ
+    uint32_t held = 0;        // Ot[牟ꑱĂ
+
+    // ڑ
+    bool connected = false;
+
+    // Ot[̃{^GbW߂iȂj
+    void UpdateEdges(uint32_t prevButtons) {
+        uint32_t changed = buttons ^ prevButtons;
+        triggered = changed & buttons;
+        released = changed & prevButtons;
+        held = buttons & prevButtons;
+    }
+
+    // mask ̂ꂩĂ邩
+    bool IsPressed(uint32_t mask) const { return (buttons & mask) != 0; }
+    bool IsTrigger(uint32_t mask) const { return (triggered & mask) != 0; }
+    bool IsRelease(uint32_t mask) const { return (released & mask) != 0; }
+    bool IsHeld(uint32_t mask) const { return (held & mask) != 0; }
+
+    // mask ׂ̂ĂĂ邩ij
+    bool IsPressedAll(uint32_t mask) const { return (buttons & mask) == mask; }
+
+    // ̃t[Ő
+    bool IsTriggerChord(uint32_t mask) const {
+        return (buttons & mask) == mask && (triggered & mask) != 0;
+    }
+
+    // ꂩ̃{^Ă邩
+    bool IsAnyButtonPressed() const { return (buttons & BUTTON_MASK_ALL) != 0; }
+
+    // fbh][KpiJ[u ResponseCurve QƁj
+    static float ApplyDeadzone(float value, float deadzone = 0.15f) {
+        if (std::fabs(value) < deadzone) return 0.0f;
+        float sign = (value > 0) ? 1.0f : -1.0f;
+        return sign * (std::fabs(value) - deadzone) / (1.0f - deadzone);
+    }
+};
+
+//==============================================================================
+// oCu[Vݒ\
+//==============================================================================
+struct VibrationSettings {
+    float leftMotor = 0.0f;
+    float rightMotor = 0.0f;
+    float duration = 0.0f;
+};
+
+//==============================================================================
+// obe[\
+//==============================================================================
+struct BatteryInfo {
+    bool isWired = false;
+    bool hasBatteryInfo = false;
+    int percent = -1;
+    const char* levelText = "";
+};
+
+//==============================================================================
+// ZT[f[^\
+//==============================================================================
+struct SensorData {
+    float gyroX = 0.0f;
+    float gyroY = 0.0f;
+    float gyroZ = 0.0f;
+
+    float accelX = 0.0f;
+    float accelY = 0.0f;
+    float accelZ = 0.0f;
+
+    bool hasGyro = false;
+    bool hasAccel = false;
+};
+
+//==============================================================================
+// xb`\́i`撼OɓǂݒXeBbNEZT[j
+//==============================================================================
+struct LateLatchState {
+    // XeBbNiJ[uKpA-1.0 ~ 1.0j
+    float leftStickX = 0.0f;
+    float leftStickY = 0.0f;
+    float rightStickX = 0.0f;
+    float rightStickY = 0.0f;
+
+    // ZT[̍ŐVliControllerFeature::SENSOR Ȃj
+    SensorData sensor;
+
+    Uint64 timestampNS = 0;     // ǂݏoiSDL_GetTicksNS j
+    bool valid = false;         // foCXǂ߂ifalse Ȃ GetCurrentState() gj
+};
+
+//==============================================================================
+// ZT[Tv\́iSDL_EVENT_GAMEPAD_SENSOR_UPDATE 1 j
+//==============================================================================
+struct SensorSample {
+    Uint64 sensorTimestampNS = 0;   // foCX̌viꍇ̓Cxgj
+    Uint64 timestampNS = 0;         // CxgiSDL_GetTicksNS j
+    SDL_JoystickID which = 0;
+    SDL_SensorType type = SDL_SENSOR_INVALID;
+    float data[3] = {};
+};
+
+//==============================================================================
+// ^b`pbh̒萔
+//==============================================================================
+constexpr int TOUCHPAD_MAX_COUNT = 2;       // ^b`pbh̐
+constexpr int TOUCHPAD_MAX_FINGERS = 4;     // 1 ^b`pbh̎w̐
+
+//==============================================================================
+// ^b`pbhf[^\
+//------------------------------------------------------------------------------
+// fingers  [^b`pbh][w]  2 ziȑO fingers[2] ̓^b`pbh 0 
+// w 0E1 jBȑO fingers[i]  fingers[0][i] ɓǂݑւ邱
+//==============================================================================
+struct TouchpadData {
+    static constexpr int MAX_TOUCHPADS = TOUCHPAD_MAX_COUNT;
+    static constexpr int MAX_FINGERS = TOUCHPAD_MAX_FINGERS;
+
+    bool hasTouchpad = false;
+    int numTouchpads = 0;
+
+    struct Finger {
+        bool down = false;
+        float x = 0.0f;
+        float y = 0.0f;
+        float pressure = 0.0f;
+        Uint64 timestampNS = 0;     // ŌɕωCxg̎
+    };
+    Finger fingers[MAX_TOUCHPADS][MAX_FINGERS];
+};
+
+//==============================================================================
+// Rg[[^Cv񋓌^
+//==============================================================================
+enum class ControllerType {
+    Unknown,
+    Xbox360,
+    XboxOne,
+    PS4,
+    PS5,
+    NintendoSwitch,
+    NintendoSwitchJoyconLeft,
+    NintendoSwitchJoyconRight,
+    NintendoSwitchJoyconPair,
+    Other
+};
+
+//==============================================================================
+// foCX\́iڑɈx擾ăLbVj
+//==============================================================================
+struct DeviceInfo {
+    char name[128] = "Not Connected";
+    ControllerType type = ControllerType::Unknown;
+
+    bool hasLED = false;
+    bool hasGyro = false;
+    bool hasAccel = false;
+    bool hasTouchpad = false;
+    int numTouchpads = 0;
+
+    // SDL_EVENT_JOYSTICK_BATTERY_UPDATED ł̂ݍXV
+    BatteryInfo battery;
+};
+
+//==============================================================================
+// ̓Tv\́i^CX^vt̃{^EEڑCxgj
+//==============================================================================
+struct InputSample {
+    Uint64 timestampNS = 0;     // CxgiSDL_GetTicksNS j
+    Uint32 type = 0;            // SDL_EventType
+    SDL_JoystickID which = 0;
+    Sint16 value = 0;           // ̒l / {^̉i1 or 0j / obe[c
+    Uint8 index = 0;            // SDL_GamepadButton / SDL_GamepadAxis / SDL_PowerState
+};
+
+//==============================================================================
+// ͎荞݃[h񋓌^
+//==============================================================================
+enum class InputMode {
+    Polling,    // t[S{^ES₢킹
+    Event       // {^ECxg𒼐ڏԂ֔fit[̒ZEj
+};
+
+//==============================================================================
+// ԗ񋓌^
+//==============================================================================
+enum class InitStatus {
+    NotStarted,
+    Pending,    // ƃXbhŏiUpdate() ͖ڑ̂܂܉Ȃj
+    Ready,
+    Failed
+};
+
+// 񓯊̊ʒmiUpdate() Ă񂾃XbhŌĂ΂j
+using InitCallback = void(*)(bool success, void* pUserData);
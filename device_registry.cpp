@@ -0,0 +1,154 @@
+/*********************************************************************
+ * \file   device_registry.cpp
+ * \brief  ڑfoCX̓o^\iŒ蒷 / JoystickID  GUID ōĐڑ𔻒j
+ *********************************************************************/
+#include "device_registry.h"
+
+//==============================================================================
+// ڑ
+//==============================================================================
+DeviceRegistry::Binding DeviceRegistry::OnAdded(SDL_JoystickID id) {
+    Binding binding;
+    if (id == 0) return binding;
+
+    //  ID  ADDED dē͂ƂiȂǁj
+    binding.slot = FindSlot(id);
+    if (binding.slot >= 0) {
+        binding.reconnected = true;
+        return binding;
+    }
+
+    SDL_GUID guid = SDL_GetGamepadGUIDForID(id);
+
+    // 1.  GUID ̗\iؒf̂́j
+    // 2. \̖Xbg
+    // 3. łÂ\
+    int reserved = -1;
+    int freeSlot = -1;
+    int oldest = -1;
+    for (int i = 0; i < MAX_SLOTS; i++) {
+        if (m_connectedSlots & (1u << i)) continue;
+
+        const Entry& entry = m_entries[i];
+        if (!entry.used) {
+            if (freeSlot < 0) freeSlot = i;
+            continue;
+        }
+        if (IsSameGUID(entry.guid, guid)) {
+            if (reserved < 0 || entry.disconnectedNS > m_entries[reserved].disconnectedNS) {
+                reserved = i;
+            }
+        }
+        if (oldest < 0 || entry.disconnectedNS < m_entries[oldest].disconnectedNS) {
+            oldest = i;
+        }
+    }
+
+    binding.reconnected = (reserved >= 0);
+    binding.slot = (reserved >= 0) ? reserved : (freeSlot >= 0) ? freeSlot : oldest;
+    if (binding.slot < 0) return binding;
+
+    Entry& entry = m_entries[binding.slot];
+    m_undoEntry = entry;
+    m_undoId = id;
+    m_undoSlot = binding.slot;
+    entry.guid = guid;
+    entry.id = id;
+    entry.disconnectedNS = 0;
+    entry.used = true;
+    m_connectedSlots |= (1u << binding.slot);
+    return binding;
+}
+
+//==============================================================================
+// ؒfiGUID ͗\ƂĎcj
+//==============================================================================
+int DeviceRegistry::OnRemoved(SDL_JoystickID id) {
+    int slot = FindSlot(id);
+    if (slot < 0) return -1;
+
+    m_entries[slot].id = 0;
+    m_entries[slot].disconnectedNS = SDL_GetTicksNS();
+    m_connectedSlots &= ~(1u << slot);
+    return slot;
+}
+
+//==============================================================================
+// ڑ̎
+//==============================================================================
+void DeviceRegistry::CancelAdded(SDL_JoystickID id) {
+    int slot = FindSlot(id);
+    if (slot < 0) return;
+
+    // O OnAdded() XbgȂ猳̗\i܂͋󂫁j֖߂B
+    // d ADDED ȂǂŋL^΁AJȂfoCX̗\񂲂Ə
+    if (slot == m_undoSlot && id == m_undoId) {
+        m_entries[slot] = m_undoEntry;
+    } else {
+        m_entries[slot] = {};
+    }
+    m_connectedSlots &= ~(1u << slot);
+    m_undoSlot = -1;
+    m_undoId = 0;
+}
+
+//==============================================================================
+// ڑς݃foCX̎荞
+//==============================================================================
+int DeviceRegistry::ScanConnected() {
+    int count = 0;
+    SDL_JoystickID* gamepads = SDL_GetGamepads(&count);
+    if (gamepads) {
+        for (int i = 0; i < count; i++) {
+            OnAdded(gamepads[i]);
+        }
+    }
+    SDL_free(gamepads);
+    return count;
+}
+
+//==============================================================================
+// 
+//==============================================================================
+void DeviceRegistry::Clear() {
+    for (int i = 0; i < MAX_SLOTS; i++) {
+        m_entries[i] = {};
+    }
+    m_connectedSlots = 0;
+    m_undoSlot = -1;
+    m_undoId = 0;
+}
+
+void DeviceRegistry::Forget(int slot) {
+    if (!IsValidSlot(slot)) return;
+    m_entries[slot] = {};
+    m_connectedSlots &= ~(1u << slot);
+    if (slot == m_undoSlot) m_undoSlot = -1;
+}
+
+//==============================================================================
+// Q
+//==============================================================================
+int DeviceRegistry::FindSlot(SDL_JoystickID id) const {
+    if (id == 0) return -1;
+    for (int i = 0; i < MAX_SLOTS; i++) {
+        if ((m_connectedSlots & (1u << i)) && m_entries[i].id == id) return i;
+    }
+    return -1;
+}
+
+int DeviceRegistry::FindFirstConnected() const {
+    for (int i = 0; i < MAX_SLOTS; i++) {
+        if (m_connectedSlots & (1u << i)) return i;
+    }
+    return -1;
+}
+
+SDL_GUID DeviceRegistry::GetGUID(int slot) const {
+    if (!IsReserved(slot)) return SDL_GUID{};
+    return m_entries[slot].guid;
+}
+
+bool DeviceRegistry::IsSameGUID(const SDL_GUID& a, const SDL_GUID& b) {
+    return SDL_memcmp(a.data, b.data, sizeof(a.data)) == 0;
+}
@@ -0,0 +1,67 @@
+/*********************************************************************
+ * \file   device_registry.h
+ * \brief  ڑfoCX̓o^\iŒ蒷 / JoystickID  GUID ōĐڑ𔻒j
+ *********************************************************************/
+#pragma once
+#include <SDL3/SDL.h>
+
+//==============================================================================
+// foCXo^\NX
+//------------------------------------------------------------------------------
+// ADDED / REMOVED Cxg󂯂邽тɕ\XVimۂȂjB
+// ؒfꂽXbg GUID o܂ܗ\ƂĎcA GUID ̃foCX
+// Đڑ瓯Xbg֖߂iBluetooth ̃X[vAȂǁjB
+// VfoCX͗\̖XbgD悵A󂫂΍łÂ\̂ĂB
+//==============================================================================
+class DeviceRegistry {
+public:
+    static constexpr int MAX_SLOTS = 16;
+
+    // o^
+    struct Binding {
+        int slot = -1;
+        bool reconnected = false;   // ȑO̗\֖߂iݒpj
+    };
+
+    // Cxg
+    Binding OnAdded(SDL_JoystickID id);
+    int OnRemoved(SDL_JoystickID id);
+
+    // O OnAdded() ifoCXJȂƂBXbg̗\֖߂j
+    void CancelAdded(SDL_JoystickID id);
+
+    // Nɐڑς݂̃foCX荞ށiSDL_GetGamepads ĝŖt[Ă΂ȂƁj
+    int ScanConnected();
+
+    // \܂߂Ăׂď
+    void Clear();
+    void Forget(int slot);
+
+    // Q
+    int FindSlot(SDL_JoystickID id) const;
+    int FindFirstConnected() const;
+    bool IsConnected(int slot) const { return IsValidSlot(slot) && (m_connectedSlots & (1u << slot)) != 0; }
+    bool IsReserved(int slot) const { return IsValidSlot(slot) && m_entries[slot].used; }
+    Uint32 GetConnectedSlots() const { return m_connectedSlots; }
+    SDL_JoystickID GetId(int slot) const { return IsConnected(slot) ? m_entries[slot].id : 0; }
+    SDL_GUID GetGUID(int slot) const;
+
+private:
+    struct Entry {
+        SDL_GUID guid;
+        SDL_JoystickID id;          // ؒf 0
+        Uint64 disconnectedNS;      // \̂Ă鏇ԂɎg
+        bool used;                  // GUID oĂ
+    };
+
+    static bool IsValidSlot(int slot) { return slot >= 0 && slot < MAX_SLOTS; }
+    static bool IsSameGUID(const SDL_GUID& a, const SDL_GUID& b);
+
+    Entry m_entries[MAX_SLOTS] = {};
+    Uint32 m_connectedSlots = 0;
+
+    // O OnAdded() ŏXbǧ̓eiCancelAdded() pj
+    Entry m_undoEntry = {};
+    SDL_JoystickID m_undoId = 0;
+    int m_undoSlot = -1;
+};
@@ -3,269 +3,220 @@
  * \brief  Q[Rg[[͊ǗiSDL3SŁj
  *********************************************************************/
 #pragma once
-#include <SDL3/SDL.h>
-#include <cmath>
-#include <cstdint>
-
-//==============================================================================
-// Q[pbhԍ\
-//==============================================================================
-struct GamepadState {
-    // XeBbNi-1.0 ~ 1.0j
-    float leftStickX = 0.0f;
-    float leftStickY = 0.0f;
-
-    // EXeBbNi-1.0 ~ 1.0j
-    float rightStickX = 0.0f;
-    float rightStickY = 0.0f;
-
-    // gK[i0.0 ~ 1.0j
-    float leftTrigger = 0.0f;
-    float rightTrigger = 0.0f;
-
-    // \L[
-    bool dpadUp = false;
-    bool dpadDown = false;
-    bool dpadLeft = false;
-    bool dpadRight = false;
-
-    // C{^iʒux[Xj
-    bool buttonDown = false;   // A / ~ / B(Switch)
-    bool buttonRight = false;  // B /  / A(Switch)
-    bool buttonLeft = false;   // X /  / Y(Switch)
-    bool buttonUp = false;     // Y /  / X(Switch)
-
-    // V_[{^iLB/RB / L1/R1 / L/Rj
-    bool buttonL1 = false;
-    bool buttonR1 = false;
-
-    // gK[{^iLT/RT / L2/R2 / ZL/ZRj- fW^
-    bool buttonL2 = false;
-    bool buttonR2 = false;
-
-    // XeBbN݁iLS/RS / L3/R3j
-    bool buttonL3 = false;
-    bool buttonR3 = false;
-
-    // VXe{^
-    bool buttonStart = false;   // Start / Options / +
-    bool buttonSelect = false;  // Back / Share / -
-
-    // ǉ{^
-    bool buttonGuide = false;   // Xbox{^ / PS{^ / Home{^
-    bool buttonMisc = false;    // Share / Mic / Capture
-
-    // ڑ
-    bool connected = false;
-
-    // ꂩ̃{^Ă邩
-    bool IsAnyButtonPressed() const {
-        return buttonDown || buttonRight || buttonLeft || buttonUp ||
-            buttonL1 || buttonR1 || buttonL2 || buttonR2 ||
-            buttonL3 || buttonR3 || buttonStart || buttonSelect ||
-            buttonGuide || buttonMisc ||
-            dpadUp || dpadDown || dpadLeft || dpadRight;
-    }
-
-    // fbh][Kp
-    static float ApplyDeadzone(float value, float deadzone = 0.15f) {
-        if (std::fabs(value) < deadzone) return 0.0f;
-        float sign = (value > 0) ? 1.0f : -1.0f;
-        return sign * (std::fabs(value) - deadzone) / (1.0f - deadzone);
-    }
-};
-
-//==============================================================================
-// oCu[Vݒ\
-//==============================================================================
-struct VibrationSettings {
-    float leftMotor = 0.0f;
-    float rightMotor = 0.0f;
-    float duration = 0.0f;
-};
-
-//==============================================================================
-// obe[\
-//==============================================================================
-struct BatteryInfo {
-    bool isWired = false;
-    bool hasBatteryInfo = false;
-    int percent = -1;
-    const char* levelText = "";
-};
-
-//==============================================================================
-// ZT[f[^\
-//==============================================================================
-struct SensorData {
-    float gyroX = 0.0f;
-    float gyroY = 0.0f;
-    float gyroZ = 0.0f;
-
-    float accelX = 0.0f;
-    float accelY = 0.0f;
-    float accelZ = 0.0f;
-
-    bool hasGyro = false;
-    bool hasAccel = false;
-};
-
-//==============================================================================
-// ^b`pbhf[^\
-//==============================================================================
-struct TouchpadData {
-    bool hasTouchpad = false;
-    int numTouchpads = 0;
-
-    struct Finger {
-        bool down = false;
-        float x = 0.0f;
-        float y = 0.0f;
-    };
-    Finger fingers[2];
-};
-
-//==============================================================================
-// Rg[[^Cv񋓌^
-//==============================================================================
-enum class ControllerType {
-    Unknown,
-    Xbox360,
-    XboxOne,
-    PS4,
-    PS5,
-    NintendoSwitch,
-    NintendoSwitchJoyconLeft,
-    NintendoSwitchJoyconRight,
-    NintendoSwitchJoyconPair,
-    Other
-};
+#include "controller_backend.h"
 
 //==============================================================================
 // Q[Rg[[NXiSDL3SŁj
+//------------------------------------------------------------------------------
+// ̓̓ReLXgiSDL foCXES@\jւ̐ÓIȑB
+// ʂ̃ReLXgKvȏꍇ ControllerCore 𒼐ڎƁB
 //==============================================================================
 class GameController {
 public:
+    using Core = ControllerCore<SdlControllerBackend, ControllerFeature::ALL>;
+
+    static Core& GetDefault() { return s_core; }
+
     // EIEXV
-    static bool Initialize();
-    static void Finalize();
-    static void Update();
+    static bool Initialize() { return s_core.Initialize(); }
+    static void Finalize() { s_core.Finalize(); }
+    static void Update() { s_core.Update(); }
+    static bool ProcessEvent(const SDL_Event& event) { return s_core.ProcessEvent(event); }
+
+    // 񓯊iSDL ̏ƃXbhōsB Update() ̒
+    // pCallback  GetInitStatus() Œm点A܂ł͖ڑƂēj
+    static bool InitializeAsync(InitCallback pCallback = nullptr, void* pUserData = nullptr) { return s_core.InitializeAsync(pCallback, pUserData); }
+    static InitStatus GetInitStatus() { return s_core.GetInitStatus(); }
+
+    // JX^}bsÕLbVȋOɐݒ肷BpTextPath ΌÂƂɍ蒼j
+    static void SetMappingCache(const char* pCachePath, const char* pTextPath = nullptr) { s_core.GetBackend().SetMappingCache(pCachePath, pTextPath); }
+
+    // ͎荞݃[h
+    static void SetInputMode(InputMode mode) { s_core.SetInputMode(mode); }
+    static InputMode GetInputMode() { return s_core.GetInputMode(); }
+
+    // ̓Xbhi쒆̓Cxg[hŒAUpdate() ̓Tvoj
+    static bool StartInputThread(Uint32 pollIntervalUS = 1000) { return s_core.StartInputThread(pollIntervalUS); }
+    static void StopInputThread() { s_core.StopInputThread(); }
+    static bool IsInputThreadRunning() { return s_core.IsInputThreadRunning(); }
+    static Uint32 GetDroppedSampleCount() { return s_core.GetBackend().GetDroppedSampleCount(); }
+
+    // vCiĐ SDL foCXg킸AL^t[ 1 i߂j
+    static void StartReplay(InputReplay* pReplay) { s_core.StartReplay(pReplay); }
+    static void StopReplay() { s_core.StopReplay(); }
+    static bool IsReplaying() { return s_core.IsReplaying(); }
+
+    // O Update() Ŏ荞񂾃Tv
+    static const InputSample* GetFrameSamples() { return s_core.GetFrameSamples(); }
+    static int GetFrameSampleCount() { return s_core.GetFrameSampleCount(); }
 
     // Ԏ擾
-    static const GamepadState& GetCurrentState() { return s_currentState; }
-    static const GamepadState& GetPrevState() { return s_prevState; }
-    static const char* GetControllerName();
-    static ControllerType GetControllerType();
-    static int GetPlayerIndex();
+    static const GamepadState& GetCurrentState() { return s_core.GetCurrentState(); }
+    static const GamepadState& GetPrevState() { return s_core.GetPrevState(); }
+    static const DeviceInfo& GetDeviceInfo() { return s_core.GetDeviceInfo(); }
+    static const char* GetControllerName() { return GetDeviceInfo().name; }
+    static ControllerType GetControllerType() { return GetDeviceInfo().type; }
+    static int GetPlayerIndex() { return s_core.GetBackend().GetPlayerIndex(); }
+    static const DeviceRegistry& GetDeviceRegistry() { return s_core.GetBackend().GetRegistry(); }
+    static int GetSlot() { return s_core.GetBackend().GetSlot(); }
 
-    // oCu[V
-    static void StartVibration(float intensity, float duration);
-    static void StartVibrationEx(float leftMotor, float rightMotor, float duration);
-    static void StartVibrationEx(const VibrationSettings& settings);
-    static void StartTriggerVibration(float left, float right, float duration);
-    static void StopVibration();
-    static bool IsVibrating() { return s_isVibrating; }
+    // xb`i`撼OɃXeBbNEZT[ǂݒAGbW͕ςȂj
+    static LateLatchState LatchLate(bool refresh = false) { return s_core.LatchLate(refresh); }
 
-    // LED
-    static bool SetLED(uint8_t r, uint8_t g, uint8_t b);
-    static bool HasLED();
+    // ͂͂ deadlineNSiSDL_GetTicksNS j܂ő҂iŒ莞Ԃ Sleep ̑j
+    static bool WaitForInput(Uint64 deadlineNS) { return s_core.WaitForInput(deadlineNS); }
 
-    // ZT[
-    static bool EnableGyro(bool enable);
-    static bool EnableAccelerometer(bool enable);
-    static SensorData GetSensorData();
-    static bool HasGyro();
-    static bool HasAccelerometer();
+    // oCu[V
+    static void StartVibration(float intensity, float duration) { s_core.StartVibrationEx(intensity, intensity, duration); }
+    static void StartVibrationEx(float leftMotor, float rightMotor, float duration) { s_core.StartVibrationEx(leftMotor, rightMotor, duration); }
+    static void StartVibrationEx(const VibrationSettings& settings) { s_core.StartVibrationEx(settings.leftMotor, settings.rightMotor, settings.duration); }
+    static void StartTriggerVibration(float left, float right, float duration) { s_core.StartTriggerVibration(left, right, duration); }
+    static void StopVibration() { s_core.StopVibration(); }
+    static bool IsVibrating() { return s_core.IsVibrating(); }
+
+    // UGtFNgid˂čĐłAUpdate() Ƃɍďށj
+    static int PlayHapticEffect(const HapticEffect& effect) { return s_core.PlayHapticEffect(effect); }
+    static void StopHapticEffect(int handle) { s_core.StopHapticEffect(handle); }
+    static const HapticScheduler& GetHaptics() { return s_core.GetHaptics(); }
+
+    // LEDio̓XbhɓnŃubNȂj
+    static bool SetLED(uint8_t r, uint8_t g, uint8_t b) { return s_core.SetLED(r, g, b); }
+    static bool HasLED() { return GetDeviceInfo().hasLED; }
 
-    // ^b`pbh
-    static TouchpadData GetTouchpadData();
-    static bool HasTouchpad();
+    // ZT[
+    static bool EnableGyro(bool enable) { return s_core.EnableSensor(SDL_SENSOR_GYRO, enable); }
+    static bool EnableAccelerometer(bool enable) { return s_core.EnableSensor(SDL_SENSOR_ACCEL, enable); }
+    static SensorData GetSensorData() { return s_core.GetSensorData(); }
+
+    // ZT[Xg[iÕt[ɓ͂STvj
+    static int GetSensorSampleCount() { return s_core.GetSensorSampleCount(); }
+    static int GetSensorSamples(SensorSample* pOut, int maxCount) { return s_core.GetSensorSamples(pOut, maxCount); }
+    static float GetSensorDataRate(SDL_SensorType type) { return s_core.GetSensorDataRate(type); }
+    static float GetObservedSensorRate(SDL_SensorType type) { return s_core.GetObservedSensorRate(type); }
+    static void SetSensorDecimation(int factor) { s_core.SetSensorDecimation(factor); }
+    static Uint32 GetDroppedSensorSampleCount() { return s_core.GetDroppedSensorSampleCount(); }
+    static bool HasGyro() { return GetDeviceInfo().hasGyro; }
+    static bool HasAccelerometer() { return GetDeviceInfo().hasAccel; }
+
+    // piԈȎSZT[TvōXVBWCƉxLɂĂƁj
+    static const OrientationEstimator& GetOrientation() { return s_core.GetOrientation(); }
+    static void SetOrientationSettings(const OrientationSettings& settings) { s_core.SetOrientationSettings(settings); }
+    static void ResetOrientationYaw() { s_core.ResetOrientationYaw(); }
+
+    // Õt[̉]ʁiWAAGCpj
+    static GyroAim GetWorldGyroDelta() { return s_core.GetWorldGyroDelta(); }
+    static GyroAim GetPlayerGyroDelta() { return s_core.GetPlayerGyroDelta(); }
+
+    // ^b`pbhiTOUCHPAD CxgXVS^b`pbhESw̏ԁj
+    static TouchpadData GetTouchpadData() { return s_core.GetTouchpadData(); }
+    static bool HasTouchpad() { return GetDeviceInfo().hasTouchpad; }
+
+    // ^b`Xg[iÕt[ɓ͂STvj
+    static int GetTouchSampleCount() { return s_core.GetTouchSampleCount(); }
+    static int GetTouchSamples(TouchSample* pOut, int maxCount) { return s_core.GetTouchSamples(pOut, maxCount); }
+
+    // WFX`[iÕt[ɔF́j
+    static int GetTouchGestureCount() { return s_core.GetTouchGestureCount(); }
+    static int GetTouchGestures(TouchGesture* pOut, int maxCount) { return s_core.GetTouchGestures(pOut, maxCount); }
+    static void SetTouchGestureSettings(const TouchGestureSettings& settings) { s_core.SetTouchGestureSettings(settings); }
 
     // obe[
-    static BatteryInfo GetBatteryInfo();
+    static BatteryInfo GetBatteryInfo() { return GetDeviceInfo().battery; }
+
+    // {^iGamepadButtonMask wj
+    static uint32_t GetButtons() { return s_core.GetCurrentState().buttons; }
+    static bool IsPressed(uint32_t mask) { return s_core.GetCurrentState().IsPressed(mask); }
+    static bool IsPressedAll(uint32_t mask) { return s_core.GetCurrentState().IsPressedAll(mask); }
+    static bool IsTrigger(uint32_t mask) { return s_core.GetCurrentState().IsTrigger(mask); }
+    static bool IsTriggerChord(uint32_t mask) { return s_core.GetCurrentState().IsTriggerChord(mask); }
+    static bool IsRelease(uint32_t mask) { return s_core.GetCurrentState().IsRelease(mask); }
+    static bool IsAnyButtonPressed() { return s_core.GetCurrentState().IsAnyButtonPressed(); }
+
+    // Õt[ɉꂽ / ꂽ񐔁iCxg[ĥ݁j
+    static int GetPressCount(uint32_t mask) { return s_core.GetPressCount(mask); }
+    static int GetReleaseCount(uint32_t mask) { return s_core.GetReleaseCount(mask); }
 
     // Press
-    static bool IsPressed_ButtonDown() { return s_currentState.buttonDown; }
-    static bool IsPressed_ButtonRight() { return s_currentState.buttonRight; }
-    static bool IsPressed_ButtonLeft() { return s_currentState.buttonLeft; }
-    static bool IsPressed_ButtonUp() { return s_currentState.buttonUp; }
-    static bool IsPressed_L1() { return s_currentState.buttonL1; }
-    static bool IsPressed_R1() { return s_currentState.buttonR1; }
-    static bool IsPressed_L2() { return s_currentState.buttonL2; }
-    static bool IsPressed_R2() { return s_currentState.buttonR2; }
-    static bool IsPressed_L3() { return s_currentState.buttonL3; }
-    static bool IsPressed_R3() { return s_currentState.buttonR3; }
-    static bool IsPressed_Start() { return s_currentState.buttonStart; }
-    static bool IsPressed_Select() { return s_currentState.buttonSelect; }
-    static bool IsPressed_Guide() { return s_currentState.buttonGuide; }
-    static bool IsPressed_Misc() { return s_currentState.buttonMisc; }
-    static bool IsPressed_DpadUp() { return s_currentState.dpadUp; }
-    static bool IsPressed_DpadDown() { return s_currentState.dpadDown; }
-    static bool IsPressed_DpadLeft() { return s_currentState.dpadLeft; }
-    static bool IsPressed_DpadRight() { return s_currentState.dpadRight; }
+    static bool IsPressed_ButtonDown() { return s_core.GetCurrentState().IsPressed(BUTTON_MASK_DOWN); }
+    static bool IsPressed_ButtonRight() { return s_core.GetCurrentState().IsPressed(BUTTON_MASK_RIGHT); }
+    static bool IsPressed_ButtonLeft() { return s_core.GetCurrentState().IsPressed(BUTTON_MASK_LEFT); }
+    static bool IsPressed_ButtonUp() { return s_core.GetCurrentState().IsPressed(BUTTON_MASK_UP); }
+    static bool IsPressed_L1() { return s_core.GetCurrentState().IsPressed(BUTTON_MASK_L1); }
+    static bool IsPressed_R1() { return s_core.GetCurrentState().IsPressed(BUTTON_MASK_R1); }
+    static bool IsPressed_L2() { return s_core.GetCurrentState().IsPressed(BUTTON_MASK_L2); }
+    static bool IsPressed_R2() { return s_core.GetCurrentState().IsPressed(BUTTON_MASK_R2); }
+    static bool IsPressed_L3() { return s_core.GetCurrentState().IsPressed(BUTTON_MASK_L3); }
+    static bool IsPressed_R3() { return s_core.GetCurrentState().IsPressed(BUTTON_MASK_R3); }
+    static bool IsPressed_Start() { return s_core.GetCurrentState().IsPressed(BUTTON_MASK_START); }
+    static bool IsPressed_Select() { return s_core.GetCurrentState().IsPressed(BUTTON_MASK_SELECT); }
+    static bool IsPressed_Guide() { return s_core.GetCurrentState().IsPressed(BUTTON_MASK_GUIDE); }
+    static bool IsPressed_Misc() { return s_core.GetCurrentState().IsPressed(BUTTON_MASK_MISC); }
+    static bool IsPressed_DpadUp() { return s_core.GetCurrentState().IsPressed(BUTTON_MASK_DPAD_UP); }
+    static bool IsPressed_DpadDown() { return s_core.GetCurrentState().IsPressed(BUTTON_MASK_DPAD_DOWN); }
+    static bool IsPressed_DpadLeft() { return s_core.GetCurrentState().IsPressed(BUTTON_MASK_DPAD_LEFT); }
+    static bool IsPressed_DpadRight() { return s_core.GetCurrentState().IsPressed(BUTTON_MASK_DPAD_RIGHT); }
 
     // Trigger
-    static bool IsTrigger_ButtonDown() { return s_currentState.buttonDown && !s_prevState.buttonDown; }
-    static bool IsTrigger_ButtonRight() { return s_currentState.buttonRight && !s_prevState.buttonRight; }
-    static bool IsTrigger_ButtonLeft() { return s_currentState.buttonLeft && !s_prevState.buttonLeft; }
-    static bool IsTrigger_ButtonUp() { return s_currentState.buttonUp && !s_prevState.buttonUp; }
-    static bool IsTrigger_L1() { return s_currentState.buttonL1 && !s_prevState.buttonL1; }
-    static bool IsTrigger_R1() { return s_currentState.buttonR1 && !s_prevState.buttonR1; }
-    static bool IsTrigger_L2() { return s_currentState.buttonL2 && !s_prevState.buttonL2; }
-    static bool IsTrigger_R2() { return s_currentState.buttonR2 && !s_prevState.buttonR2; }
-    static bool IsTrigger_L3() { return s_currentState.buttonL3 && !s_prevState.buttonL3; }
-    static bool IsTrigger_R3() { return s_currentState.buttonR3 && !s_prevState.buttonR3; }
-    static bool IsTrigger_Start() { return s_currentState.buttonStart && !s_prevState.buttonStart; }
-    static bool IsTrigger_Select() { return s_currentState.buttonSelect && !s_prevState.buttonSelect; }
-    static bool IsTrigger_Guide() { return s_currentState.buttonGuide && !s_prevState.buttonGuide; }
-    static bool IsTrigger_Misc() { return s_currentState.buttonMisc && !s_prevState.buttonMisc; }
-    static bool IsTrigger_DpadUp() { return s_currentState.dpadUp && !s_prevState.dpadUp; }
-    static bool IsTrigger_DpadDown() { return s_currentState.dpadDown && !s_prevState.dpadDown; }
-    static bool IsTrigger_DpadLeft() { return s_currentState.dpadLeft && !s_prevState.dpadLeft; }
-    static bool IsTrigger_DpadRight() { return s_currentState.dpadRight && !s_prevState.dpadRight; }
+    static bool IsTrigger_ButtonDown() { return s_core.GetCurrentState().IsTrigger(BUTTON_MASK_DOWN); }
+    static bool IsTrigger_ButtonRight() { return s_core.GetCurrentState().IsTrigger(BUTTON_MASK_RIGHT); }
+    static bool IsTrigger_ButtonLeft() { return s_core.GetCurrentState().IsTrigger(BUTTON_MASK_LEFT); }
+    static bool IsTrigger_ButtonUp() { return s_core.GetCurrentState().IsTrigger(BUTTON_MASK_UP); }
+    static bool IsTrigger_L1() { return s_core.GetCurrentState().IsTrigger(BUTTON_MASK_L1); }
+    static bool IsTrigger_R1() { return s_core.GetCurrentState().IsTrigger(BUTTON_MASK_R1); }
+    static bool IsTrigger_L2() { return s_core.GetCurrentState().IsTrigger(BUTTON_MASK_L2); }
+    static bool IsTrigger_R2() { return s_core.GetCurrentState().IsTrigger(BUTTON_MASK_R2); }
+    static bool IsTrigger_L3() { return s_core.GetCurrentState().IsTrigger(BUTTON_MASK_L3); }
+    static bool IsTrigger_R3() { return s_core.GetCurrentState().IsTrigger(BUTTON_MASK_R3); }
+    static bool IsTrigger_Start() { return s_core.GetCurrentState().IsTrigger(BUTTON_MASK_START); }
+    static bool IsTrigger_Select() { return s_core.GetCurrentState().IsTrigger(BUTTON_MASK_SELECT); }
+    static bool IsTrigger_Guide() { return s_core.GetCurrentState().IsTrigger(BUTTON_MASK_GUIDE); }
+    static bool IsTrigger_Misc() { return s_core.GetCurrentState().IsTrigger(BUTTON_MASK_MISC); }
+    static bool IsTrigger_DpadUp() { return s_core.GetCurrentState().IsTrigger(BUTTON_MASK_DPAD_UP); }
+    static bool IsTrigger_DpadDown() { return s_core.GetCurrentState().IsTrigger(BUTTON_MASK_DPAD_DOWN); }
+    static bool IsTrigger_DpadLeft() { return s_core.GetCurrentState().IsTrigger(BUTTON_MASK_DPAD_LEFT); }
+    static bool IsTrigger_DpadRight() { return s_core.GetCurrentState().IsTrigger(BUTTON_MASK_DPAD_RIGHT); }
 
     // Release
-    static bool IsRelease_ButtonDown() { return !s_currentState.buttonDown && s_prevState.buttonDown; }
-    static bool IsRelease_ButtonRight() { return !s_currentState.buttonRight && s_prevState.buttonRight; }
-    static bool IsRelease_ButtonLeft() { return !s_currentState.buttonLeft && s_prevState.buttonLeft; }
-    static bool IsRelease_ButtonUp() { return !s_currentState.buttonUp && s_prevState.buttonUp; }
-    static bool IsRelease_L1() { return !s_currentState.buttonL1 && s_prevState.buttonL1; }
-    static bool IsRelease_R1() { return !s_currentState.buttonR1 && s_prevState.buttonR1; }
-    static bool IsRelease_L2() { return !s_currentState.buttonL2 && s_prevState.buttonL2; }
-    static bool IsRelease_R2() { return !s_currentState.buttonR2 && s_prevState.buttonR2; }
-    static bool IsRelease_L3() { return !s_currentState.buttonL3 && s_prevState.buttonL3; }
-    static bool IsRelease_R3() { return !s_currentState.buttonR3 && s_prevState.buttonR3; }
-    static bool IsRelease_Start() { return !s_currentState.buttonStart && s_prevState.buttonStart; }
-    static bool IsRelease_Select() { return !s_currentState.buttonSelect && s_prevState.buttonSelect; }
-    static bool IsRelease_Guide() { return !s_currentState.buttonGuide && s_prevState.buttonGuide; }
-    static bool IsRelease_Misc() { return !s_currentState.buttonMisc && s_prevState.buttonMisc; }
-    static bool IsRelease_DpadUp() { return !s_currentState.dpadUp && s_prevState.dpadUp; }
-    static bool IsRelease_DpadDown() { return !s_currentState.dpadDown && s_prevState.dpadDown; }
-    static bool IsRelease_DpadLeft() { return !s_currentState.dpadLeft && s_prevState.dpadLeft; }
-    static bool IsRelease_DpadRight() { return !s_currentState.dpadRight && s_prevState.dpadRight; }
+    static bool IsRelease_ButtonDown() { return s_core.GetCurrentState().IsRelease(BUTTON_MASK_DOWN); }
+    static bool IsRelease_ButtonRight() { return s_core.GetCurrentState().IsRelease(BUTTON_MASK_RIGHT); }
+    static bool IsRelease_ButtonLeft() { return s_core.GetCurrentState().IsRelease(BUTTON_MASK_LEFT); }
+    static bool IsRelease_ButtonUp() { return s_core.GetCurrentState().IsRelease(BUTTON_MASK_UP); }
+    static bool IsRelease_L1() { return s_core.GetCurrentState().IsRelease(BUTTON_MASK_L1); }
+    static bool IsRelease_R1() { return s_core.GetCurrentState().IsRelease(BUTTON_MASK_R1); }
+    static bool IsRelease_L2() { return s_core.GetCurrentState().IsRelease(BUTTON_MASK_L2); }
+    static bool IsRelease_R2() { return s_core.GetCurrentState().IsRelease(BUTTON_MASK_R2); }
+    static bool IsRelease_L3() { return s_core.GetCurrentState().IsRelease(BUTTON_MASK_L3); }
+    static bool IsRelease_R3() { return s_core.GetCurrentState().IsRelease(BUTTON_MASK_R3); }
+    static bool IsRelease_Start() { return s_core.GetCurrentState().IsRelease(BUTTON_MASK_START); }
+    static bool IsRelease_Select() { return s_core.GetCurrentState().IsRelease(BUTTON_MASK_SELECT); }
+    static bool IsRelease_Guide() { return s_core.GetCurrentState().IsRelease(BUTTON_MASK_GUIDE); }
+    static bool IsRelease_Misc() { return s_core.GetCurrentState().IsRelease(BUTTON_MASK_MISC); }
+    static bool IsRelease_DpadUp() { return s_core.GetCurrentState().IsRelease(BUTTON_MASK_DPAD_UP); }
+    static bool IsRelease_DpadDown() { return s_core.GetCurrentState().IsRelease(BUTTON_MASK_DPAD_DOWN); }
+    static bool IsRelease_DpadLeft() { return s_core.GetCurrentState().IsRelease(BUTTON_MASK_DPAD_LEFT); }
+    static bool IsRelease_DpadRight() { return s_core.GetCurrentState().IsRelease(BUTTON_MASK_DPAD_RIGHT); }
 
     // XeBbNEgK[l擾
-    static float GetLeftStickX() { return s_currentState.leftStickX; }
-    static float GetLeftStickY() { return s_currentState.leftStickY; }
-    static float GetRightStickX() { return s_currentState.rightStickX; }
-    static float GetRightStickY() { return s_currentState.rightStickY; }
-    static float GetLeftTrigger() { return s_currentState.leftTrigger; }
-    static float GetRightTrigger() { return s_currentState.rightTrigger; }
+    static float GetLeftStickX() { return s_core.GetCurrentState().leftStickX; }
+    static float GetLeftStickY() { return s_core.GetCurrentState().leftStickY; }
+    static float GetRightStickX() { return s_core.GetCurrentState().rightStickX; }
+    static float GetRightStickY() { return s_core.GetCurrentState().rightStickY; }
+    static float GetLeftTrigger() { return s_core.GetCurrentState().leftTrigger; }
+    static float GetRightTrigger() { return s_core.GetCurrentState().rightTrigger; }
+
+    // Œ菬_̒lil / J[uKpA-32768 ` 32767j
+    static Sint16 GetRawAxis(SDL_GamepadAxis axis) { return s_core.GetRawAxis(axis); }
+    static Sint16 GetProcessedAxis(SDL_GamepadAxis axis) { return s_core.GetProcessedAxis(axis); }
+
+    // J[uiݒ莞Ƀe[u𐶐j
+    static void SetLeftStickCurve(const ResponseCurveSettings& settings) { s_core.SetLeftStickCurve(settings); }
+    static void SetRightStickCurve(const ResponseCurveSettings& settings) { s_core.SetRightStickCurve(settings); }
+    static void SetTriggerCurve(const ResponseCurveSettings& settings) { s_core.SetTriggerCurve(settings); }
+    static const ResponseCurveSet& GetResponseCurves() { return s_core.GetResponseCurves(); }
 
     // ڑ
-    static bool IsConnected() { return s_currentState.connected; }
+    static bool IsConnected() { return s_core.IsConnected(); }
 
 private:
-    static void UpdateState();
-    static void OpenGamepad(SDL_JoystickID id);
-    static void CloseGamepad();
-
-    static SDL_Gamepad* s_pGamepad;
-    static SDL_JoystickID s_gamepadId;
-
-    static GamepadState s_currentState;
-    static GamepadState s_prevState;
-
-    static bool s_isVibrating;
-    static Uint64 s_vibrationEndTime;
+    static Core s_core;
 };
@@ -0,0 +1,325 @@
+/*********************************************************************
+ * \file   gamepad_manager.cpp
+ * \brief  Q[pbhǗivC[Xbg / SoA ԁj
+ *********************************************************************/
+#include "gamepad_manager.h"
+#include "output_writer.h"
+
+//==============================================================================
+// ÓIoϐ̒`
+//==============================================================================
+DeviceRegistry GamepadManager::s_registry;
+SDL_Gamepad* GamepadManager::s_pGamepads[MAX_SLOTS] = {};
+int GamepadManager::s_outputSlots[MAX_SLOTS] = {};
+uint32_t GamepadManager::s_connectedSlots = 0;
+alignas(64) uint32_t GamepadManager::s_buttons[MAX_SLOTS] = {};
+alignas(64) uint32_t GamepadManager::s_prevButtons[MAX_SLOTS] = {};
+alignas(64) uint32_t GamepadManager::s_triggered[MAX_SLOTS] = {};
+alignas(64) uint32_t GamepadManager::s_released[MAX_SLOTS] = {};
+alignas(64) Sint16 GamepadManager::s_rawAxes[SDL_GAMEPAD_AXIS_COUNT][MAX_SLOTS] = {};
+alignas(64) Sint16 GamepadManager::s_processedAxes[SDL_GAMEPAD_AXIS_COUNT][MAX_SLOTS] = {};
+alignas(64) float GamepadManager::s_axes[SDL_GAMEPAD_AXIS_COUNT][MAX_SLOTS] = {};
+ResponseCurveSet GamepadManager::s_curves[MAX_SLOTS];
+HapticScheduler GamepadManager::s_haptics[MAX_SLOTS];
+
+//==============================================================================
+// 萔`
+//==============================================================================
+namespace {
+    constexpr float TRIGGER_DIGITAL_THRESHOLD = 0.5f;
+    constexpr int BUTTON_POLL_COUNT = SDL_GAMEPAD_BUTTON_MISC1 + 1;
+
+    // gK[̃fW^臒lilj
+    constexpr int TRIGGER_DIGITAL_RAW = static_cast<int>(TRIGGER_DIGITAL_THRESHOLD * 32767.0f);
+}
+
+//==============================================================================
+// 
+//==============================================================================
+bool GamepadManager::Initialize() {
+    if (!SDL_Init(SDL_INIT_GAMEPAD)) {
+        return false;
+    }
+
+    for (int i = 0; i < MAX_SLOTS; i++) {
+        CloseSlot(i);
+        s_curves[i] = ResponseCurveSet();
+    }
+    OutputWriter::Initialize();
+
+    // ڑς݂̃foCXo^\Ɏ荞łJ
+    s_registry.Clear();
+    s_registry.ScanConnected();
+    for (int i = 0; i < MAX_SLOTS; i++) {
+        if (s_registry.IsConnected(i)) {
+            OpenSlot(s_registry.GetId(i));
+        }
+    }
+
+    return true;
+}
+
+//==============================================================================
+// I
+//==============================================================================
+void GamepadManager::Finalize() {
+    for (int i = 0; i < MAX_SLOTS; i++) {
+        s_haptics[i].Silence(s_pGamepads[i]);
+        CloseSlot(i);
+    }
+    s_registry.Clear();
+    OutputWriter::Finalize();
+    SDL_QuitSubSystem(SDL_INIT_GAMEPAD);
+}
+
+//==============================================================================
+// XbgJiXbg͓o^\߂j
+//==============================================================================
+void GamepadManager::OpenSlot(SDL_JoystickID id) {
+    DeviceRegistry::Binding binding = s_registry.OnAdded(id);
+    int slot = binding.slot;
+    if (slot < 0 || s_pGamepads[slot]) return;
+
+    // JȂΗ\ɖ߂iJȂfoCX֍ĐڑU蕪Ȃj
+    s_pGamepads[slot] = SDL_OpenGamepad(id);
+    if (!s_pGamepads[slot]) {
+        s_registry.CancelAdded(id);
+        return;
+    }
+
+    // ʂ̃foCX\pƂ͐ݒɖ߂
+    if (!binding.reconnected) {
+        s_curves[slot] = ResponseCurveSet();
+    }
+
+    ResetSlotState(slot);
+    s_outputSlots[slot] = OutputWriter::Register(s_pGamepads[slot]);
+    s_haptics[slot].SetOutputSlot(s_outputSlots[slot]);
+    s_connectedSlots |= (1u << slot);
+    SDL_SetGamepadPlayerIndex(s_pGamepads[slot], slot);
+}
+
+//==============================================================================
+// Xbgio^\̗\Ɛݒ͎cj
+//==============================================================================
+void GamepadManager::CloseSlot(int slot) {
+    if (s_pGamepads[slot]) {
+        OutputWriter::Unregister(s_outputSlots[slot]);
+        SDL_CloseGamepad(s_pGamepads[slot]);
+    }
+    s_outputSlots[slot] = -1;
+    s_haptics[slot].SetOutputSlot(-1);
+    s_pGamepads[slot] = nullptr;
+    s_connectedSlots &= ~(1u << slot);
+    s_haptics[slot].Reset();
+    ResetSlotState(slot);
+}
+
+void GamepadManager::ResetSlotState(int slot) {
+    s_buttons[slot] = 0;
+    s_prevButtons[slot] = 0;
+    s_triggered[slot] = 0;
+    s_released[slot] = 0;
+    for (int axis = 0; axis < SDL_GAMEPAD_AXIS_COUNT; axis++) {
+        s_rawAxes[axis][slot] = 0;
+        s_processedAxes[axis][slot] = 0;
+        s_axes[axis][slot] = 0.0f;
+    }
+}
+
+//==============================================================================
+// Cxg
+//==============================================================================
+bool GamepadManager::ProcessEvent(const SDL_Event& event) {
+    switch (event.type) {
+    case SDL_EVENT_GAMEPAD_ADDED:
+        OpenSlot(event.gdevice.which);
+        return true;
+
+    case SDL_EVENT_GAMEPAD_REMOVED: {
+        int slot = s_registry.OnRemoved(event.gdevice.which);
+        if (slot >= 0) {
+            CloseSlot(slot);
+        }
+        return true;
+    }
+    }
+    return false;
+}
+
+//==============================================================================
+// XViSXbg 1 pXŏj
+//==============================================================================
+void GamepadManager::Update() {
+    SDL_Event event;
+    while (SDL_PollEvent(&event)) {
+        ProcessEvent(event);
+    }
+
+    // foCX琶̒lW߂
+    for (int i = 0; i < MAX_SLOTS; i++) {
+        s_prevButtons[i] = s_buttons[i];
+
+        SDL_Gamepad* pGamepad = s_pGamepads[i];
+        if (!pGamepad) continue;
+
+        uint32_t buttons = 0;
+        for (int b = 0; b < BUTTON_POLL_COUNT; b++) {
+            buttons |= static_cast<uint32_t>(
+                SDL_GetGamepadButton(pGamepad, static_cast<SDL_GamepadButton>(b))) << b;
+        }
+        s_buttons[i] = buttons;
+
+        for (int axis = 0; axis < SDL_GAMEPAD_AXIS_COUNT; axis++) {
+            s_rawAxes[axis][i] = SDL_GetGamepadAxis(pGamepad, static_cast<SDL_GamepadAxis>(axis));
+        }
+    }
+
+    // SXbg 6 ɉJ[uKpAfW^ƃGbWo܂ 1 pXōs
+    for (int i = 0; i < MAX_SLOTS; i++) {
+        Sint16 raw[SDL_GAMEPAD_AXIS_COUNT];
+        Sint16 processed[SDL_GAMEPAD_AXIS_COUNT];
+        for (int axis = 0; axis < SDL_GAMEPAD_AXIS_COUNT; axis++) {
+            raw[axis] = s_rawAxes[axis][i];
+        }
+        s_curves[i].Process(raw, processed);
+        for (int axis = 0; axis < SDL_GAMEPAD_AXIS_COUNT; axis++) {
+            s_processedAxes[axis][i] = processed[axis];
+            s_axes[axis][i] = ResponseCurve::ToFloat(processed[axis]);
+        }
+
+        uint32_t buttons = s_buttons[i] & ~(BUTTON_MASK_L2 | BUTTON_MASK_R2);
+        buttons |= (raw[SDL_GAMEPAD_AXIS_LEFT_TRIGGER] > TRIGGER_DIGITAL_RAW) ? BUTTON_MASK_L2 : 0u;
+        buttons |= (raw[SDL_GAMEPAD_AXIS_RIGHT_TRIGGER] > TRIGGER_DIGITAL_RAW) ? BUTTON_MASK_R2 : 0u;
+        s_buttons[i] = buttons;
+
+        uint32_t changed = buttons ^ s_prevButtons[i];
+        s_triggered[i] = changed & buttons;
+        s_released[i] = changed & s_prevButtons[i];
+    }
+
+    // UGtFNg̍Ə݁ifoCXƂ 1 eBbN 1 j
+    Uint64 nowNS = SDL_GetTicksNS();
+    for (int i = 0; i < MAX_SLOTS; i++) {
+        if (s_pGamepads[i]) {
+            s_haptics[i].Update(s_pGamepads[i], nowNS);
+        }
+    }
+}
+
+//==============================================================================
+// Xbg
+//==============================================================================
+int GamepadManager::GetConnectedCount() {
+    int count = 0;
+    for (uint32_t bits = s_connectedSlots; bits; bits &= bits - 1) {
+        count++;
+    }
+    return count;
+}
+
+const char* GamepadManager::GetControllerName(int slot) {
+    SDL_Gamepad* pGamepad = GetGamepad(slot);
+    if (!pGamepad) return "Not Connected";
+    const char* name = SDL_GetGamepadName(pGamepad);
+    return name ? name : "Unknown";
+}
+
+//==============================================================================
+// XbgPʂ̏Ԏ擾
+//==============================================================================
+GamepadState GamepadManager::GetState(int slot) {
+    GamepadState state = {};
+    if (!IsConnected(slot)) return state;
+
+    state.leftStickX = s_axes[SDL_GAMEPAD_AXIS_LEFTX][slot];
+    state.leftStickY = s_axes[SDL_GAMEPAD_AXIS_LEFTY][slot];
+    state.rightStickX = s_axes[SDL_GAMEPAD_AXIS_RIGHTX][slot];
+    state.rightStickY = s_axes[SDL_GAMEPAD_AXIS_RIGHTY][slot];
+    state.leftTrigger = s_axes[SDL_GAMEPAD_AXIS_LEFT_TRIGGER][slot];
+    state.rightTrigger = s_axes[SDL_GAMEPAD_AXIS_RIGHT_TRIGGER][slot];
+    state.buttons = s_buttons[slot];
+    state.UpdateEdges(s_prevButtons[slot]);
+    state.connected = true;
+    return state;
+}
+
+float GamepadManager::GetAxis(int slot, SDL_GamepadAxis axis) {
+    if (!IsValidSlot(slot) || axis < 0 || axis >= SDL_GAMEPAD_AXIS_COUNT) return 0.0f;
+    return s_axes[axis][slot];
+}
+
+Sint16 GamepadManager::GetRawAxis(int slot, SDL_GamepadAxis axis) {
+    if (!IsValidSlot(slot) || axis < 0 || axis >= SDL_GAMEPAD_AXIS_COUNT) return 0;
+    return s_rawAxes[axis][slot];
+}
+
+Sint16 GamepadManager::GetProcessedAxis(int slot, SDL_GamepadAxis axis) {
+    if (!IsValidSlot(slot) || axis < 0 || axis >= SDL_GAMEPAD_AXIS_COUNT) return 0;
+    return s_processedAxes[axis][slot];
+}
+
+//==============================================================================
+// J[uݒiXbgPʁj
+//==============================================================================
+void GamepadManager::SetStickCurve(int slot, int stick, const ResponseCurveSettings& settings) {
+    if (!IsValidSlot(slot)) return;
+    ResponseCurve& curve = (stick == 0) ? s_curves[slot].leftStick : s_curves[slot].rightStick;
+    curve.Compile(settings);
+}
+
+void GamepadManager::SetTriggerCurve(int slot, const ResponseCurveSettings& settings) {
+    if (!IsValidSlot(slot)) return;
+    s_curves[slot].triggers.Compile(settings);
+}
+
+//==============================================================================
+// UGtFNgiXbgPʁj
+//==============================================================================
+int GamepadManager::PlayHapticEffect(int slot, const HapticEffect& effect) {
+    if (!IsConnected(slot)) return -1;
+    return s_haptics[slot].Play(effect, SDL_GetTicksNS());
+}
+
+void GamepadManager::StopHapticEffect(int slot, int handle) {
+    if (!IsValidSlot(slot)) return;
+    s_haptics[slot].Stop(handle);
+}
+
+void GamepadManager::StopAllHapticEffects(int slot) {
+    if (!IsValidSlot(slot)) return;
+    s_haptics[slot].StopAll();
+}
+
+//==============================================================================
+// LEDiXbgPʁj
+//==============================================================================
+bool GamepadManager::SetLED(int slot, Uint8 r, Uint8 g, Uint8 b) {
+    SDL_Gamepad* pGamepad = GetGamepad(slot);
+    if (!pGamepad) return false;
+    if (OutputWriter::SubmitLED(s_outputSlots[slot], r, g, b)) return true;
+    return SDL_SetGamepadLED(pGamepad, r, g, b);
+}
+
+//==============================================================================
+// vC[f̔
+//==============================================================================
+uint32_t GamepadManager::ScanSlots(const uint32_t* pMasks, uint32_t mask) {
+    uint32_t slots = 0;
+    for (int i = 0; i < MAX_SLOTS; i++) {
+        slots |= static_cast<uint32_t>((pMasks[i] & mask) != 0) << i;
+    }
+    return slots;
+}
+
+int GamepadManager::FindTriggerSlot(uint32_t mask) {
+    uint32_t slots = GetTriggerSlots(mask);
+    if (!slots) return -1;
+
+    int slot = 0;
+    while (!(slots & 1u)) {
+        slots >>= 1;
+        slot++;
+    }
+    return slot;
+}
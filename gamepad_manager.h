@@ -0,0 +1,89 @@
+/*********************************************************************
+ * \file   gamepad_manager.h
+ * \brief  Q[pbhǗivC[Xbg / SoA ԁj
+ *********************************************************************/
+#pragma once
+#include "game_controller.h"
+
+//==============================================================================
+// Q[pbhǗNX
+//------------------------------------------------------------------------------
+// ڑ̃Q[pbhׂĊJAvC[XbgɊ蓖ĂB
+// Xbg̊蓖Ă DeviceRegistry sAؒffoCXĐڑ
+// Xbg֖߂ĉJ[uȂǂ̐ݒpB
+// XbgƂ̏Ԃ͔ziSoAjŕێASXbg 1 pXōXVB
+// GameController::Update() Ƃ̓CxgDߓɎgȂƁB
+// OŃCxg[v񂷏ꍇ ProcessEvent() ɃCxgnB
+//==============================================================================
+class GamepadManager {
+public:
+    static constexpr int MAX_SLOTS = DeviceRegistry::MAX_SLOTS;
+
+    // EIEXV
+    static bool Initialize();
+    static void Finalize();
+    static void Update();
+    static bool ProcessEvent(const SDL_Event& event);
+
+    // Xbg
+    static int GetConnectedCount();
+    static uint32_t GetConnectedSlots() { return s_connectedSlots; }
+    static bool IsConnected(int slot) { return IsValidSlot(slot) && (s_connectedSlots & (1u << slot)) != 0; }
+    static SDL_Gamepad* GetGamepad(int slot) { return IsValidSlot(slot) ? s_pGamepads[slot] : nullptr; }
+    static int FindSlot(SDL_JoystickID id) { return s_registry.FindSlot(id); }
+    static const DeviceRegistry& GetDeviceRegistry() { return s_registry; }
+    static const char* GetControllerName(int slot);
+
+    // XbgPʂ̏Ԏ擾
+    static GamepadState GetState(int slot);
+    static uint32_t GetButtons(int slot) { return IsValidSlot(slot) ? s_buttons[slot] : 0; }
+    static bool IsPressed(int slot, uint32_t mask) { return (GetButtons(slot) & mask) != 0; }
+    static bool IsTrigger(int slot, uint32_t mask) { return IsValidSlot(slot) && (s_triggered[slot] & mask) != 0; }
+    static bool IsRelease(int slot, uint32_t mask) { return IsValidSlot(slot) && (s_released[slot] & mask) != 0; }
+    static float GetAxis(int slot, SDL_GamepadAxis axis);
+    static Sint16 GetRawAxis(int slot, SDL_GamepadAxis axis);
+    static Sint16 GetProcessedAxis(int slot, SDL_GamepadAxis axis);
+
+    // J[uistick: 0 = , 1 = Ej
+    static void SetStickCurve(int slot, int stick, const ResponseCurveSettings& settings);
+    static void SetTriggerCurve(int slot, const ResponseCurveSettings& settings);
+
+    // UGtFNgiXbgƂɍAUpdate()  1 񂾂ށj
+    static int PlayHapticEffect(int slot, const HapticEffect& effect);
+    static void StopHapticEffect(int slot, int handle);
+    static void StopAllHapticEffects(int slot);
+
+    // LEDio̓XbhɓnŃubNȂj
+    static bool SetLED(int slot, Uint8 r, Uint8 g, Uint8 b);
+
+    // vC[f̔i߂l̓Xbg̃rbgWj
+    static uint32_t GetPressedSlots(uint32_t mask) { return ScanSlots(s_buttons, mask); }
+    static uint32_t GetTriggerSlots(uint32_t mask) { return ScanSlots(s_triggered, mask); }
+    static uint32_t GetReleaseSlots(uint32_t mask) { return ScanSlots(s_released, mask); }
+    static bool IsAnyPlayerPressed(uint32_t mask) { return GetPressedSlots(mask) != 0; }
+    static bool IsAnyPlayerTrigger(uint32_t mask) { return GetTriggerSlots(mask) != 0; }
+    static int FindTriggerSlot(uint32_t mask);
+
+private:
+    static bool IsValidSlot(int slot) { return slot >= 0 && slot < MAX_SLOTS; }
+    static uint32_t ScanSlots(const uint32_t* pMasks, uint32_t mask);
+    static void OpenSlot(SDL_JoystickID id);
+    static void CloseSlot(int slot);
+    static void ResetSlotState(int slot);
+
+    static DeviceRegistry s_registry;
+    static SDL_Gamepad* s_pGamepads[MAX_SLOTS];
+    static int s_outputSlots[MAX_SLOTS];
+    static uint32_t s_connectedSlots;
+
+    // XbgԁiSoAj
+    alignas(64) static uint32_t s_buttons[MAX_SLOTS];
+    alignas(64) static uint32_t s_prevButtons[MAX_SLOTS];
+    alignas(64) static uint32_t s_triggered[MAX_SLOTS];
+    alignas(64) static uint32_t s_released[MAX_SLOTS];
+    alignas(64) static Sint16 s_rawAxes[SDL_GAMEPAD_AXIS_COUNT][MAX_SLOTS];
+    alignas(64) static Sint16 s_processedAxes[SDL_GAMEPAD_AXIS_COUNT][MAX_SLOTS];
+    alignas(64) static float s_axes[SDL_GAMEPAD_AXIS_COUNT][MAX_SLOTS];
+    static ResponseCurveSet s_curves[MAX_SLOTS];
+    static HapticScheduler s_haptics[MAX_SLOTS];
+};
@@ -0,0 +1,221 @@
+/*********************************************************************
+ * \file   haptics.cpp
+ * \brief  UGtFNg̃XPW[iGx[v / Dx / ݂̏Wj
+ *********************************************************************/
+#include "haptics.h"
+#include "output_writer.h"
+#include <climits>
+
+//==============================================================================
+// wp[
+//==============================================================================
+namespace {
+    Uint64 SecondsToNS(float seconds) {
+        return (seconds > 0.0f) ? static_cast<Uint64>(seconds * static_cast<float>(SDL_NS_PER_SECOND)) : 0;
+    }
+
+    // 0.0 ~ 1.0  8 rbgxɊۂ߂Ă 16 rbg֍L
+    // ĩRg[[̓[^[l 8 rbgő邽߁Aȉ̕ω͏܂Ȃj
+    Uint16 QuantizeOutput(float value) {
+        if (value <= 0.0f) return 0;
+        if (value >= 1.0f) return 0xFFFF;
+        return static_cast<Uint16>(static_cast<int>(value * 255.0f + 0.5f) * 257);
+    }
+}
+
+//==============================================================================
+// GtFNgĐ
+//==============================================================================
+int HapticScheduler::Play(const HapticEffect& effect, Uint64 nowNS) {
+    int index = AllocateVoice(effect.priority);
+    if (index < 0) return -1;
+
+    Voice& voice = m_voices[index];
+    for (int c = 0; c < HAPTIC_CHANNEL_COUNT; c++) {
+        float strength = effect.strength[c];
+        voice.strength[c] = (strength < 0.0f) ? 0.0f : (strength > 1.0f) ? 1.0f : strength;
+    }
+    voice.startNS = nowNS;
+    voice.attackNS = SecondsToNS(effect.attack);
+    voice.sustainEndNS = (effect.sustain < 0.0f) ? SDL_MAX_UINT64
+        : nowNS + voice.attackNS + SecondsToNS(effect.sustain);
+    voice.decayNS = SecondsToNS(effect.decay);
+    voice.priority = effect.priority;
+    voice.generation++;
+
+    m_activeMask |= (1u << index);
+    m_requestCount++;
+    return MakeHandle(index, voice.generation);
+}
+
+//==============================================================================
+// GtFNg~
+//==============================================================================
+void HapticScheduler::Stop(int handle) {
+    if (!IsPlaying(handle)) return;
+    m_activeMask &= ~(1u << HandleIndex(handle));
+    m_requestCount++;
+}
+
+void HapticScheduler::StopAll() {
+    if (m_activeMask) {
+        m_activeMask = 0;
+        m_requestCount++;
+    }
+}
+
+bool HapticScheduler::IsPlaying(int handle) const {
+    if (handle < 0) return false;
+    int index = HandleIndex(handle);
+    if (index >= MAX_EFFECTS || !(m_activeMask & (1u << index))) return false;
+    return MakeHandle(index, m_voices[index].generation) == handle;
+}
+
+//==============================================================================
+// 󂫃Xbg̊mہitȂDxႢŌẪGtFNguj
+//==============================================================================
+int HapticScheduler::AllocateVoice(int priority) {
+    int victim = -1;
+    for (int i = 0; i < MAX_EFFECTS; i++) {
+        if (!(m_activeMask & (1u << i))) return i;
+
+        const Voice& voice = m_voices[i];
+        if (voice.priority > priority) continue;
+        if (victim < 0 ||
+            voice.priority < m_voices[victim].priority ||
+            (voice.priority == m_voices[victim].priority && voice.startNS < m_voices[victim].startNS)) {
+            victim = i;
+        }
+    }
+    return victim;
+}
+
+//==============================================================================
+// Gx[vi0.0 ~ 1.0AIĂΕj
+//==============================================================================
+float HapticScheduler::Envelope(const Voice& voice, Uint64 nowNS) const {
+    Uint64 elapsed = (nowNS > voice.startNS) ? nowNS - voice.startNS : 0;
+    if (elapsed < voice.attackNS) {
+        return static_cast<float>(elapsed) / static_cast<float>(voice.attackNS);
+    }
+    if (nowNS < voice.sustainEndNS) {
+        return 1.0f;
+    }
+
+    Uint64 decayElapsed = nowNS - voice.sustainEndNS;
+    if (decayElapsed < voice.decayNS) {
+        return 1.0f - static_cast<float>(decayElapsed) / static_cast<float>(voice.decayNS);
+    }
+    return -1.0f;
+}
+
+//==============================================================================
+// Ə
+//==============================================================================
+void HapticScheduler::Update(SDL_Gamepad* pGamepad, Uint64 nowNS) {
+    // IGtFNgOŏʂ̗Dx߂
+    float levels[MAX_EFFECTS];
+    int topPriority = INT_MIN;
+    for (int i = 0; i < MAX_EFFECTS; i++) {
+        if (!(m_activeMask & (1u << i))) continue;
+        levels[i] = Envelope(m_voices[i], nowNS);
+        if (levels[i] < 0.0f) {
+            m_activeMask &= ~(1u << i);
+        } else if (m_voices[i].priority > topPriority) {
+            topPriority = m_voices[i].priority;
+        }
+    }
+
+    float mix[HAPTIC_CHANNEL_COUNT] = {};
+    for (int i = 0; i < MAX_EFFECTS; i++) {
+        if (!(m_activeMask & (1u << i))) continue;
+        const Voice& voice = m_voices[i];
+        float level = levels[i] * ((voice.priority < topPriority) ? LOWER_PRIORITY_SCALE : 1.0f);
+        for (int c = 0; c < HAPTIC_CHANNEL_COUNT; c++) {
+            mix[c] += voice.strength[c] * level;
+        }
+    }
+
+    Uint16 out[HAPTIC_CHANNEL_COUNT];
+    for (int c = 0; c < HAPTIC_CHANNEL_COUNT; c++) {
+        out[c] = QuantizeOutput(mix[c]);
+    }
+    if (!pGamepad) return;
+
+    // [^[
+    bool rumbleChanged = out[HAPTIC_LOW_FREQUENCY] != m_output[HAPTIC_LOW_FREQUENCY] ||
+        out[HAPTIC_HIGH_FREQUENCY] != m_output[HAPTIC_HIGH_FREQUENCY];
+    bool rumbleOn = (out[HAPTIC_LOW_FREQUENCY] | out[HAPTIC_HIGH_FREQUENCY]) != 0;
+    if (rumbleChanged || (rumbleOn && nowNS - m_lastRumbleNS >= KEEPALIVE_NS)) {
+        WriteRumble(pGamepad, out[HAPTIC_LOW_FREQUENCY], out[HAPTIC_HIGH_FREQUENCY],
+            rumbleOn ? RUMBLE_DURATION_MS : 0);
+        m_output[HAPTIC_LOW_FREQUENCY] = out[HAPTIC_LOW_FREQUENCY];
+        m_output[HAPTIC_HIGH_FREQUENCY] = out[HAPTIC_HIGH_FREQUENCY];
+        m_lastRumbleNS = nowNS;
+        m_writeCount++;
+    }
+
+    // gK[[^[iΉ̃foCXɂ͈xs瑗Ȃj
+    if (!m_triggerSupported) return;
+    bool triggerChanged = out[HAPTIC_LEFT_TRIGGER] != m_output[HAPTIC_LEFT_TRIGGER] ||
+        out[HAPTIC_RIGHT_TRIGGER] != m_output[HAPTIC_RIGHT_TRIGGER];
+    bool triggerOn = (out[HAPTIC_LEFT_TRIGGER] | out[HAPTIC_RIGHT_TRIGGER]) != 0;
+    if (triggerChanged || (triggerOn && nowNS - m_lastTriggerNS >= KEEPALIVE_NS)) {
+        if (!WriteTriggerRumble(pGamepad, out[HAPTIC_LEFT_TRIGGER], out[HAPTIC_RIGHT_TRIGGER],
+            triggerOn ? RUMBLE_DURATION_MS : 0)) {
+            m_triggerSupported = false;
+        }
+        m_output[HAPTIC_LEFT_TRIGGER] = out[HAPTIC_LEFT_TRIGGER];
+        m_output[HAPTIC_RIGHT_TRIGGER] = out[HAPTIC_RIGHT_TRIGGER];
+        m_lastTriggerNS = nowNS;
+        m_writeCount++;
+    }
+}
+
+//==============================================================================
+// ݁iOutputWriter ɓnȂΒڏj
+//------------------------------------------------------------------------------
+// 񓯊̏ꍇ͎sȂ̂ŁAgK[U̔Ή͒ڏݎ̂݁B
+//==============================================================================
+void HapticScheduler::WriteRumble(SDL_Gamepad* pGamepad, Uint16 low, Uint16 high, Uint32 durationMS) {
+    if (OutputWriter::SubmitRumble(m_outputSlot, low, high, durationMS)) return;
+    SDL_RumbleGamepad(pGamepad, low, high, durationMS);
+}
+
+bool HapticScheduler::WriteTriggerRumble(SDL_Gamepad* pGamepad, Uint16 left, Uint16 right, Uint32 durationMS) {
+    if (OutputWriter::SubmitTriggerRumble(m_outputSlot, left, right, durationMS)) return true;
+    return SDL_RumbleGamepadTriggers(pGamepad, left, right, durationMS);
+}
+
+//==============================================================================
+// ~
+//==============================================================================
+void HapticScheduler::Silence(SDL_Gamepad* pGamepad) {
+    StopAll();
+    if (pGamepad) {
+        if (m_output[HAPTIC_LOW_FREQUENCY] | m_output[HAPTIC_HIGH_FREQUENCY]) {
+            WriteRumble(pGamepad, 0, 0, 0);
+            m_writeCount++;
+        }
+        if (m_triggerSupported && (m_output[HAPTIC_LEFT_TRIGGER] | m_output[HAPTIC_RIGHT_TRIGGER])) {
+            WriteTriggerRumble(pGamepad, 0, 0, 0);
+            m_writeCount++;
+        }
+    }
+    for (int c = 0; c < HAPTIC_CHANNEL_COUNT; c++) {
+        m_output[c] = 0;
+    }
+}
+
+//==============================================================================
+// Zbg
+//==============================================================================
+void HapticScheduler::Reset() {
+    m_activeMask = 0;
+    for (int c = 0; c < HAPTIC_CHANNEL_COUNT; c++) {
+        m_output[c] = 0;
+    }
+    m_lastRumbleNS = 0;
+    m_lastTriggerNS = 0;
+    m_triggerSupported = true;
+}
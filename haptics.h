@@ -0,0 +1,118 @@
+/*********************************************************************
+ * \file   haptics.h
+ * \brief  UGtFNg̃XPW[iGx[v / Dx / ݂̏Wj
+ *********************************************************************/
+#pragma once
+#include <SDL3/SDL.h>
+
+//==============================================================================
+// U`l
+//==============================================================================
+enum HapticChannel {
+    HAPTIC_LOW_FREQUENCY = 0,   // [^[igj
+    HAPTIC_HIGH_FREQUENCY,      // E[^[igj
+    HAPTIC_LEFT_TRIGGER,
+    HAPTIC_RIGHT_TRIGGER,
+    HAPTIC_CHANNEL_COUNT
+};
+
+//==============================================================================
+// UGtFNg\
+//------------------------------------------------------------------------------
+// i0.0 ~ 1.0j`lƂɎw肵Aattack ŗオAsustain ̊
+// ێAdecay ŌďIBsustain Ȃ Stop() ܂őB
+//==============================================================================
+struct HapticEffect {
+    float strength[HAPTIC_CHANNEL_COUNT] = {};
+    float attack = 0.0f;    // b
+    float sustain = 0.0f;   // biȂ疳j
+    float decay = 0.0f;     // b
+    int priority = 0;       // 傫قǗD
+
+    static HapticEffect Rumble(float lowFrequency, float highFrequency, float duration) {
+        HapticEffect effect;
+        effect.strength[HAPTIC_LOW_FREQUENCY] = lowFrequency;
+        effect.strength[HAPTIC_HIGH_FREQUENCY] = highFrequency;
+        effect.sustain = duration;
+        return effect;
+    }
+
+    static HapticEffect Trigger(float left, float right, float duration) {
+        HapticEffect effect;
+        effect.strength[HAPTIC_LEFT_TRIGGER] = left;
+        effect.strength[HAPTIC_RIGHT_TRIGGER] = right;
+        effect.sustain = duration;
+        return effect;
+    }
+};
+
+//==============================================================================
+// UXPW[i1 foCXj
+//------------------------------------------------------------------------------
+// Đ̃GtFNg𖈃eBbNAo͂ςƂ
+// SDL_RumbleGamepad / SDL_RumbleGamepadTriggers  1 񂸂ĂԁB
+// ŏʂ̗DxႢGtFNg LOWER_PRIORITY_SCALE {ɗ}B
+// U KEEPALIVE_NS Ƃɓl𑗂蒼AXV~܂΃foCXŎ~܂B
+// SetOutputSlot()  OutputWriter ̃Xbgw肷Ə݂񓯊ɂB
+//==============================================================================
+class HapticScheduler {
+public:
+    static constexpr int MAX_EFFECTS = 16;
+    static constexpr float LOWER_PRIORITY_SCALE = 0.25f;
+    static constexpr Uint64 KEEPALIVE_NS = 200 * SDL_NS_PER_MS;
+    static constexpr Uint32 RUMBLE_DURATION_MS = 500;
+
+    // GtFNg̍ĐE~inh -1 Ŏsj
+    int Play(const HapticEffect& effect, Uint64 nowNS);
+    void Stop(int handle);
+    void StopAll();
+    bool IsPlaying(int handle) const;
+    bool IsActive() const { return m_activeMask != 0; }
+
+    // ĕKvȂfoCX֏ށi1 eBbN 1 j
+    void Update(SDL_Gamepad* pGamepad, Uint64 nowNS);
+
+    // o͂𑦍Ɏ~߂iIȂǁj
+    void Silence(SDL_Gamepad* pGamepad);
+
+    // foCX̕tւɌĂԁi݂͍sȂj
+    void Reset();
+
+    // ݐi-1 ȂĂяoXbhŒڏށj
+    void SetOutputSlot(int slot) { m_outputSlot = slot; }
+
+    // ߂ɑlƓv
+    Uint16 GetOutput(HapticChannel channel) const { return m_output[channel]; }
+    Uint32 GetRequestCount() const { return m_requestCount; }
+    Uint32 GetWriteCount() const { return m_writeCount; }
+
+private:
+    struct Voice {
+        float strength[HAPTIC_CHANNEL_COUNT];
+        Uint64 startNS;
+        Uint64 attackNS;
+        Uint64 sustainEndNS;    // Ȃ SDL_MAX_UINT64
+        Uint64 decayNS;
+        int priority;
+        Uint16 generation;
+    };
+
+    static int MakeHandle(int index, Uint16 generation) { return (generation << 8) | index; }
+    static int HandleIndex(int handle) { return handle & 0xFF; }
+    float Envelope(const Voice& voice, Uint64 nowNS) const;
+    int AllocateVoice(int priority);
+    void WriteRumble(SDL_Gamepad* pGamepad, Uint16 low, Uint16 high, Uint32 durationMS);
+    bool WriteTriggerRumble(SDL_Gamepad* pGamepad, Uint16 left, Uint16 right, Uint32 durationMS);
+
+    Voice m_voices[MAX_EFFECTS] = {};
+    Uint32 m_activeMask = 0;
+
+    Uint16 m_output[HAPTIC_CHANNEL_COUNT] = {};
+    Uint64 m_lastRumbleNS = 0;
+    Uint64 m_lastTriggerNS = 0;
+    bool m_triggerSupported = true;
+    int m_outputSlot = -1;
+
+    Uint32 m_requestCount = 0;
+    Uint32 m_writeCount = 0;
+};
@@ -0,0 +1,547 @@
+/*********************************************************************
+ * \file   input_codec.cpp
+ * \brief  Rg[[Ԃ̒ʐMpGR[hEfR[hirbgl߁EʎqEj
+ *********************************************************************/
+#include "input_codec.h"
+#include <cmath>
+
+using namespace InputCodecFormat;
+
+//==============================================================================
+// 萔Ewp[
+//==============================================================================
+namespace {
+    constexpr int EDGE_BITS = SDL_GAMEPAD_BUTTON_COUNT + 2;    // L2 / R2 ܂
+    constexpr Uint32 EDGE_MASK = (1u << EDGE_BITS) - 1;
+    constexpr Uint32 CONNECTED_BIT = 1u << EDGE_BITS;
+
+    constexpr int TIME_SMALL_BITS = 16;
+    constexpr int TIME_BITS = 48;           // }CNbi 8.9 Nj
+
+    enum BitsIndex { BITS_STICK, BITS_TRIGGER, BITS_SENSOR, BITS_TOUCH, BITS_PRESSURE, BITS_COUNT };
+
+    Uint32 LowMask(int bits) {
+        return (bits >= 32) ? 0xFFFFFFFFu : ((1u << bits) - 1);
+    }
+
+    int ClampBits(int bits, int minBits) {
+        return SDL_clamp(bits, minBits, MAX_FIELD_BITS);
+    }
+
+    Uint32 ZigZag(Sint32 value) {
+        return (static_cast<Uint32>(value) << 1) ^ static_cast<Uint32>(value >> 31);
+    }
+
+    Sint32 UnZigZag(Uint32 value) {
+        return static_cast<Sint32>(value >> 1) ^ -static_cast<Sint32>(value & 1);
+    }
+
+    Sint32 SignExtend(Uint32 value, int bits) {
+        Uint32 sign = 1u << (bits - 1);
+        return static_cast<Sint32>((value ^ sign) - sign);
+    }
+
+    //--------------------------------------------------------------------------
+    // ʎq
+    //--------------------------------------------------------------------------
+    // -range ~ range 𕄍t bits rbg
+    Sint32 QuantizeSigned(float value, float range, int bits) {
+        float scale = static_cast<float>((1 << (bits - 1)) - 1);
+        float normalized = SDL_clamp(value / range, -1.0f, 1.0f);
+        return static_cast<Sint32>(std::lround(normalized * scale));
+    }
+
+    float DequantizeSigned(Sint32 value, float range, int bits) {
+        float scale = static_cast<float>((1 << (bits - 1)) - 1);
+        return value / scale * range;
+    }
+
+    // 0 ~ 1 𕄍Ȃ bits rbg
+    Sint32 QuantizeUnsigned(float value, int bits) {
+        float scale = static_cast<float>((1 << bits) - 1);
+        return static_cast<Sint32>(std::lround(SDL_clamp(value, 0.0f, 1.0f) * scale));
+    }
+
+    float DequantizeUnsigned(Sint32 value, int bits) {
+        return value / static_cast<float>((1 << bits) - 1);
+    }
+
+    //--------------------------------------------------------------------------
+    // rbg݁iĂяõobt@ցAꂽȍ~̂ĂĎsɂj
+    //--------------------------------------------------------------------------
+    class BitWriter {
+    public:
+        BitWriter(Uint8* pBuffer, size_t capacity) : m_pBuffer(pBuffer), m_capacity(capacity) {}
+
+        // bits  32 ܂
+        void Write(Uint32 value, int bits) {
+            m_accumulator |= static_cast<Uint64>(value & LowMask(bits)) << m_count;
+            m_count += bits;
+            while (m_count >= 8) {
+                PutByte(static_cast<Uint8>(m_accumulator));
+                m_accumulator >>= 8;
+                m_count -= 8;
+            }
+        }
+
+        void WriteBit(bool value) { Write(value ? 1u : 0u, 1); }
+
+        void Write64(Uint64 value, int bits) {
+            if (bits > 32) {
+                Write(static_cast<Uint32>(value), 32);
+                Write(static_cast<Uint32>(value >> 32), bits - 32);
+            } else {
+                Write(static_cast<Uint32>(value), bits);
+            }
+        }
+
+        // 񂾃oCgiĂ 0j
+        size_t Finish() {
+            if (m_count > 0) {
+                PutByte(static_cast<Uint8>(m_accumulator));
+                m_accumulator = 0;
+                m_count = 0;
+            }
+            return m_overflow ? 0 : m_size;
+        }
+
+    private:
+        void PutByte(Uint8 byte) {
+            if (m_size < m_capacity) {
+                m_pBuffer[m_size++] = byte;
+            } else {
+                m_overflow = true;
+            }
+        }
+
+        Uint8* m_pBuffer;
+        size_t m_capacity;
+        size_t m_size = 0;
+        Uint64 m_accumulator = 0;
+        int m_count = 0;
+        bool m_overflow = false;
+    };
+
+    //--------------------------------------------------------------------------
+    // rbgǂݍ݁iI[z 0 ԂĎsL^j
+    //--------------------------------------------------------------------------
+    class BitReader {
+    public:
+        BitReader(const Uint8* pData, size_t size) : m_pData(pData), m_size(size) {}
+
+        Uint32 Read(int bits) {
+            while (m_count < bits) {
+                if (m_position >= m_size) {
+                    m_overflow = true;
+                    return 0;
+                }
+                m_accumulator |= static_cast<Uint64>(m_pData[m_position++]) << m_count;
+                m_count += 8;
+            }
+            Uint32 value = static_cast<Uint32>(m_accumulator) & LowMask(bits);
+            m_accumulator >>= bits;
+            m_count -= bits;
+            return value;
+        }
+
+        bool ReadBit() { return Read(1) != 0; }
+
+        Uint64 Read64(int bits) {
+            if (bits > 32) {
+                Uint64 low = Read(32);
+                return low | (static_cast<Uint64>(Read(bits - 32)) << 32);
+            }
+            return Read(bits);
+        }
+
+        bool IsOverflow() const { return m_overflow; }
+
+    private:
+        const Uint8* m_pData;
+        size_t m_size;
+        size_t m_position = 0;
+        Uint64 m_accumulator = 0;
+        int m_count = 0;
+        bool m_overflow = false;
+    };
+
+    //--------------------------------------------------------------------------
+    // l 1 iL[t[͐ΒlAȊO ωȂ /  / Βlj
+    //--------------------------------------------------------------------------
+    void WriteField(BitWriter& writer, Sint32 value, Sint32 prev, int bits, bool key) {
+        if (key) {
+            writer.Write(static_cast<Uint32>(value), bits);
+            return;
+        }
+        if (value == prev) {
+            writer.WriteBit(false);
+            return;
+        }
+
+        writer.WriteBit(true);
+        int smallBits = SDL_max(bits / 2, 1);
+        Uint32 delta = ZigZag(value - prev);
+        if (delta < (1u << smallBits)) {
+            writer.WriteBit(false);
+            writer.Write(delta, smallBits);
+        } else {
+            writer.WriteBit(true);
+            writer.Write(static_cast<Uint32>(value), bits);
+        }
+    }
+
+    Sint32 ReadField(BitReader& reader, Sint32 prev, int bits, bool isSigned, bool key) {
+        if (!key) {
+            if (!reader.ReadBit()) return prev;
+            if (!reader.ReadBit()) {
+                int smallBits = SDL_max(bits / 2, 1);
+                return prev + UnZigZag(reader.Read(smallBits));
+            }
+        }
+        Uint32 raw = reader.Read(bits);
+        return isSigned ? SignExtend(raw, bits) : static_cast<Sint32>(raw);
+    }
+
+    //--------------------------------------------------------------------------
+    // ʎqς݂̏ԂiȂl 0 ɂđMőj
+    //--------------------------------------------------------------------------
+    void Quantize(const RecordedFrame& frame, const int bits[BITS_COUNT], InputCodecReference* pOut) {
+        InputCodecReference& ref = *pOut;
+        ref = {};
+        for (int i = 0; i < BITS_COUNT; i++) ref.bits[i] = bits[i];
+
+        ref.timeUS = frame.timestampNS / 1000;
+        ref.frame = frame.frame;
+
+        const GamepadState& state = frame.state;
+        ref.buttons = (state.buttons & EDGE_MASK) | (state.connected ? CONNECTED_BIT : 0);
+        ref.axes[SDL_GAMEPAD_AXIS_LEFTX] = QuantizeSigned(state.leftStickX, 1.0f, bits[BITS_STICK]);
+        ref.axes[SDL_GAMEPAD_AXIS_LEFTY] = QuantizeSigned(state.leftStickY, 1.0f, bits[BITS_STICK]);
+        ref.axes[SDL_GAMEPAD_AXIS_RIGHTX] = QuantizeSigned(state.rightStickX, 1.0f, bits[BITS_STICK]);
+        ref.axes[SDL_GAMEPAD_AXIS_RIGHTY] = QuantizeSigned(state.rightStickY, 1.0f, bits[BITS_STICK]);
+        ref.axes[SDL_GAMEPAD_AXIS_LEFT_TRIGGER] = QuantizeUnsigned(state.leftTrigger, bits[BITS_TRIGGER]);
+        ref.axes[SDL_GAMEPAD_AXIS_RIGHT_TRIGGER] = QuantizeUnsigned(state.rightTrigger, bits[BITS_TRIGGER]);
+
+        ref.hasSensor = frame.hasSensor;
+        if (frame.hasSensor) {
+            const SensorData& sensor = frame.sensor;
+            ref.hasGyro = sensor.hasGyro;
+            ref.hasAccel = sensor.hasAccel;
+            ref.sensor[0] = QuantizeSigned(sensor.gyroX, GYRO_RANGE, bits[BITS_SENSOR]);
+            ref.sensor[1] = QuantizeSigned(sensor.gyroY, GYRO_RANGE, bits[BITS_SENSOR]);
+            ref.sensor[2] = QuantizeSigned(sensor.gyroZ, GYRO_RANGE, bits[BITS_SENSOR]);
+            ref.sensor[3] = QuantizeSigned(sensor.accelX, ACCEL_RANGE, bits[BITS_SENSOR]);
+            ref.sensor[4] = QuantizeSigned(sensor.accelY, ACCEL_RANGE, bits[BITS_SENSOR]);
+            ref.sensor[5] = QuantizeSigned(sensor.accelZ, ACCEL_RANGE, bits[BITS_SENSOR]);
+        }
+
+        ref.hasTouchpad = frame.hasTouchpad;
+        if (frame.hasTouchpad) {
+            const TouchpadData& touchpad = frame.touchpad;
+            ref.touchpadEnabled = touchpad.hasTouchpad;
+            ref.numTouchpads = SDL_clamp(touchpad.numTouchpads, 0, TouchpadData::MAX_TOUCHPADS);
+            for (int pad = 0; pad < ref.numTouchpads; pad++) {
+                for (int i = 0; i < TouchpadData::MAX_FINGERS; i++) {
+                    const TouchpadData::Finger& source = touchpad.fingers[pad][i];
+                    if (!source.down) continue;
+
+                    InputCodecReference::Finger& finger = ref.fingers[pad][i];
+                    finger.down = true;
+                    finger.x = QuantizeUnsigned(source.x, bits[BITS_TOUCH]);
+                    finger.y = QuantizeUnsigned(source.y, bits[BITS_TOUCH]);
+                    finger.pressure = QuantizeUnsigned(source.pressure, bits[BITS_PRESSURE]);
+                }
+            }
+        }
+    }
+
+    // Õ{^GbW܂邩iL[t[͑OƓƂ݂Ȃj
+    bool IsDerivableEdges(const GamepadState& state, Uint32 prevButtons) {
+        GamepadState derived;
+        derived.buttons = state.buttons & EDGE_MASK;
+        derived.UpdateEdges(prevButtons);
+        return derived.triggered == (state.triggered & EDGE_MASK) &&
+            derived.released == (state.released & EDGE_MASK) &&
+            derived.held == (state.held & EDGE_MASK);
+    }
+}
+
+//==============================================================================
+// GR[_[
+//==============================================================================
+InputEncoder::InputEncoder(const InputCodecSettings& settings) {
+    SetSettings(settings);
+}
+
+void InputEncoder::SetSettings(const InputCodecSettings& settings) {
+    m_settings = settings;
+    m_settings.stickBits = ClampBits(settings.stickBits, 2);
+    m_settings.triggerBits = ClampBits(settings.triggerBits, 1);
+    m_settings.sensorBits = ClampBits(settings.sensorBits, 2);
+    m_settings.touchBits = ClampBits(settings.touchBits, 1);
+    m_settings.pressureBits = ClampBits(settings.pressureBits, 1);
+    m_settings.keyframeInterval = SDL_max(settings.keyframeInterval, 0);
+    m_forceKeyframe = true;
+}
+
+void InputEncoder::Reset() {
+    m_reference = {};
+    m_sequence = 0;
+    m_framesSinceKeyframe = 0;
+    m_forceKeyframe = true;
+}
+
+size_t InputEncoder::Encode(const RecordedFrame& frame, Uint8* pBuffer, size_t capacity) {
+    bool key = m_forceKeyframe ||
+        (m_settings.keyframeInterval > 0 && m_framesSinceKeyframe >= m_settings.keyframeInterval);
+
+    const int bits[BITS_COUNT] = {
+        m_settings.stickBits, m_settings.triggerBits, m_settings.sensorBits,
+        m_settings.touchBits, m_settings.pressureBits,
+    };
+    InputCodecReference next;
+    Quantize(frame, bits, &next);
+    const InputCodecReference& prev = m_reference;
+
+    BitWriter writer(pBuffer, capacity);
+    Uint8 sequence = static_cast<Uint8>(m_sequence + 1);
+    writer.WriteBit(key);
+    writer.Write(sequence, SEQUENCE_BITS);
+
+    // ݒ
+    if (key) {
+        for (int i = 0; i < BITS_COUNT; i++) writer.Write(static_cast<Uint32>(bits[i] - 1), 4);
+    }
+
+    // Et[
+    if (key) {
+        writer.Write64(next.timeUS, TIME_BITS);
+        writer.Write(next.frame, 32);
+    } else {
+        Uint32 delta = ZigZag(static_cast<Sint32>(next.timeUS - prev.timeUS));
+        Uint64 elapsed = (next.timeUS > prev.timeUS) ? next.timeUS - prev.timeUS : prev.timeUS - next.timeUS;
+        if (elapsed < (1u << (TIME_SMALL_BITS - 1))) {
+            writer.WriteBit(false);
+            writer.Write(delta, TIME_SMALL_BITS);
+        } else {
+            writer.WriteBit(true);
+            writer.Write64(next.timeUS, TIME_BITS);
+        }
+
+        bool nextFrame = (next.frame == prev.frame + 1);
+        writer.WriteBit(nextFrame);
+        if (!nextFrame) writer.Write(next.frame, 32);
+    }
+
+    // {^
+    Uint32 prevButtons = key ? next.buttons : prev.buttons;
+    if (key) {
+        writer.Write(next.buttons, BUTTON_BITS);
+    } else {
+        Uint32 changed = next.buttons ^ prev.buttons;
+        writer.WriteBit(changed != 0);
+        if (changed) writer.Write(changed, BUTTON_BITS);
+    }
+    bool derivable = IsDerivableEdges(frame.state, prevButtons & EDGE_MASK);
+    writer.WriteBit(!derivable);
+    if (!derivable) {
+        writer.Write(frame.state.triggered, EDGE_BITS);
+        writer.Write(frame.state.released, EDGE_BITS);
+        writer.Write(frame.state.held, EDGE_BITS);
+    }
+
+    // 
+    for (int axis = 0; axis < SDL_GAMEPAD_AXIS_COUNT; axis++) {
+        int axisBits = (axis < SDL_GAMEPAD_AXIS_LEFT_TRIGGER) ? bits[BITS_STICK] : bits[BITS_TRIGGER];
+        WriteField(writer, next.axes[axis], prev.axes[axis], axisBits, key);
+    }
+
+    // ZT[
+    writer.WriteBit(next.hasSensor);
+    if (next.hasSensor) {
+        bool sensorKey = key || !prev.hasSensor;
+        writer.WriteBit(next.hasGyro);
+        writer.WriteBit(next.hasAccel);
+        for (int i = 0; i < 6; i++) {
+            WriteField(writer, next.sensor[i], prev.sensor[i], bits[BITS_SENSOR], sensorKey);
+        }
+    }
+
+    // ^b`pbh
+    writer.WriteBit(next.hasTouchpad);
+    if (next.hasTouchpad) {
+        bool touchKey = key || !prev.hasTouchpad;
+        writer.WriteBit(next.touchpadEnabled);
+        writer.Write(static_cast<Uint32>(next.numTouchpads), 2);
+        for (int pad = 0; pad < next.numTouchpads; pad++) {
+            for (int i = 0; i < TouchpadData::MAX_FINGERS; i++) {
+                const InputCodecReference::Finger& finger = next.fingers[pad][i];
+                const InputCodecReference::Finger& prevFinger = prev.fingers[pad][i];
+                writer.WriteBit(finger.down);
+                if (!finger.down) continue;
+
+                bool fingerKey = touchKey || !prevFinger.down;
+                WriteField(writer, finger.x, prevFinger.x, bits[BITS_TOUCH], fingerKey);
+                WriteField(writer, finger.y, prevFinger.y, bits[BITS_TOUCH], fingerKey);
+                WriteField(writer, finger.pressure, prevFinger.pressure, bits[BITS_PRESSURE], fingerKey);
+            }
+        }
+    }
+
+    size_t size = writer.Finish();
+    if (size == 0) return 0;
+
+    // Ƃi߂
+    m_reference = next;
+    m_sequence = sequence;
+    m_framesSinceKeyframe = key ? 1 : m_framesSinceKeyframe + 1;
+    m_forceKeyframe = false;
+    return size;
+}
+
+//==============================================================================
+// fR[_[
+//==============================================================================
+void InputDecoder::Reset() {
+    m_reference = {};
+    m_sequence = 0;
+    m_hasReference = false;
+}
+
+bool InputDecoder::Decode(const Uint8* pData, size_t size, RecordedFrame* pOut) {
+    if (!pData || size == 0) return false;
+
+    BitReader reader(pData, size);
+    bool key = reader.ReadBit();
+    Uint8 sequence = static_cast<Uint8>(reader.Read(SEQUENCE_BITS));
+
+    // ͒ÕpPbg̑łȂΓǂ߂Ȃ
+    if (!key && (!m_hasReference || sequence != static_cast<Uint8>(m_sequence + 1))) return false;
+
+    const InputCodecReference& prev = m_reference;
+    InputCodecReference next = {};
+
+    // ݒ
+    int* bits = next.bits;
+    if (key) {
+        for (int i = 0; i < BITS_COUNT; i++) bits[i] = static_cast<int>(reader.Read(4)) + 1;
+        if (bits[BITS_STICK] < 2 || bits[BITS_SENSOR] < 2) return false;
+    } else {
+        for (int i = 0; i < BITS_COUNT; i++) bits[i] = prev.bits[i];
+    }
+
+    // Et[
+    if (key) {
+        next.timeUS = reader.Read64(TIME_BITS);
+        next.frame = reader.Read(32);
+    } else {
+        if (!reader.ReadBit()) {
+            next.timeUS = prev.timeUS + UnZigZag(reader.Read(TIME_SMALL_BITS));
+        } else {
+            next.timeUS = reader.Read64(TIME_BITS);
+        }
+        next.frame = reader.ReadBit() ? prev.frame + 1 : reader.Read(32);
+    }
+
+    // {^
+    if (key) {
+        next.buttons = reader.Read(BUTTON_BITS);
+    } else {
+        next.buttons = prev.buttons;
+        if (reader.ReadBit()) next.buttons ^= reader.Read(BUTTON_BITS);
+    }
+    Uint32 prevButtons = key ? next.buttons : prev.buttons;
+
+    GamepadState state;
+    state.buttons = next.buttons & EDGE_MASK;
+    state.connected = (next.buttons & CONNECTED_BIT) != 0;
+    state.UpdateEdges(prevButtons & EDGE_MASK);
+    if (reader.ReadBit()) {
+        state.triggered = reader.Read(EDGE_BITS);
+        state.released = reader.Read(EDGE_BITS);
+        state.held = reader.Read(EDGE_BITS);
+    }
+
+    // 
+    for (int axis = 0; axis < SDL_GAMEPAD_AXIS_COUNT; axis++) {
+        bool isStick = (axis < SDL_GAMEPAD_AXIS_LEFT_TRIGGER);
+        int axisBits = isStick ? bits[BITS_STICK] : bits[BITS_TRIGGER];
+        next.axes[axis] = ReadField(reader, prev.axes[axis], axisBits, isStick, key);
+    }
+    state.leftStickX = DequantizeSigned(next.axes[SDL_GAMEPAD_AXIS_LEFTX], 1.0f, bits[BITS_STICK]);
+    state.leftStickY = DequantizeSigned(next.axes[SDL_GAMEPAD_AXIS_LEFTY], 1.0f, bits[BITS_STICK]);
+    state.rightStickX = DequantizeSigned(next.axes[SDL_GAMEPAD_AXIS_RIGHTX], 1.0f, bits[BITS_STICK]);
+    state.rightStickY = DequantizeSigned(next.axes[SDL_GAMEPAD_AXIS_RIGHTY], 1.0f, bits[BITS_STICK]);
+    state.leftTrigger = DequantizeUnsigned(next.axes[SDL_GAMEPAD_AXIS_LEFT_TRIGGER], bits[BITS_TRIGGER]);
+    state.rightTrigger = DequantizeUnsigned(next.axes[SDL_GAMEPAD_AXIS_RIGHT_TRIGGER], bits[BITS_TRIGGER]);
+
+    // ZT[
+    SensorData sensor;
+    next.hasSensor = reader.ReadBit();
+    if (next.hasSensor) {
+        bool sensorKey = key || !prev.hasSensor;
+        next.hasGyro = reader.ReadBit();
+        next.hasAccel = reader.ReadBit();
+        for (int i = 0; i < 6; i++) {
+            next.sensor[i] = ReadField(reader, prev.sensor[i], bits[BITS_SENSOR], true, sensorKey);
+        }
+
+        sensor.hasGyro = next.hasGyro;
+        sensor.hasAccel = next.hasAccel;
+        sensor.gyroX = DequantizeSigned(next.sensor[0], GYRO_RANGE, bits[BITS_SENSOR]);
+        sensor.gyroY = DequantizeSigned(next.sensor[1], GYRO_RANGE, bits[BITS_SENSOR]);
+        sensor.gyroZ = DequantizeSigned(next.sensor[2], GYRO_RANGE, bits[BITS_SENSOR]);
+        sensor.accelX = DequantizeSigned(next.sensor[3], ACCEL_RANGE, bits[BITS_SENSOR]);
+        sensor.accelY = DequantizeSigned(next.sensor[4], ACCEL_RANGE, bits[BITS_SENSOR]);
+        sensor.accelZ = DequantizeSigned(next.sensor[5], ACCEL_RANGE, bits[BITS_SENSOR]);
+    }
+
+    // ^b`pbhiw̎͑Ȃ̂ŁAĂwɂ̓t[̎j
+    TouchpadData touchpad;
+    Uint64 timestampNS = next.timeUS * 1000;
+    next.hasTouchpad = reader.ReadBit();
+    if (next.hasTouchpad) {
+        bool touchKey = key || !prev.hasTouchpad;
+        next.touchpadEnabled = reader.ReadBit();
+        next.numTouchpads = static_cast<int>(reader.Read(2));
+        if (next.numTouchpads > TouchpadData::MAX_TOUCHPADS) return false;
+
+        touchpad.hasTouchpad = next.touchpadEnabled;
+        touchpad.numTouchpads = next.numTouchpads;
+        for (int pad = 0; pad < next.numTouchpads; pad++) {
+            for (int i = 0; i < TouchpadData::MAX_FINGERS; i++) {
+                InputCodecReference::Finger& finger = next.fingers[pad][i];
+                const InputCodecReference::Finger& prevFinger = prev.fingers[pad][i];
+                finger.down = reader.ReadBit();
+                if (!finger.down) continue;
+
+                bool fingerKey = touchKey || !prevFinger.down;
+                finger.x = ReadField(reader, prevFinger.x, bits[BITS_TOUCH], false, fingerKey);
+                finger.y = ReadField(reader, prevFinger.y, bits[BITS_TOUCH], false, fingerKey);
+                finger.pressure = ReadField(reader, prevFinger.pressure, bits[BITS_PRESSURE], false, fingerKey);
+
+                TouchpadData::Finger& out = touchpad.fingers[pad][i];
+                out.down = true;
+                out.x = DequantizeUnsigned(finger.x, bits[BITS_TOUCH]);
+                out.y = DequantizeUnsigned(finger.y, bits[BITS_TOUCH]);
+                out.pressure = DequantizeUnsigned(finger.pressure, bits[BITS_PRESSURE]);
+                out.timestampNS = timestampNS;
+            }
+        }
+    }
+
+    if (reader.IsOverflow()) return false;
+
+    m_reference = next;
+    m_sequence = sequence;
+    m_hasReference = true;
+
+    pOut->timestampNS = timestampNS;
+    pOut->frame = next.frame;
+    pOut->state = state;
+    pOut->sensor = sensor;
+    pOut->touchpad = touchpad;
+    pOut->hasSensor = next.hasSensor;
+    pOut->hasTouchpad = next.hasTouchpad;
+    return true;
+}
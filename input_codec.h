@@ -0,0 +1,121 @@
+/*********************************************************************
+ * \file   input_codec.h
+ * \brief  Rg[[Ԃ̒ʐMpGR[hEfR[hirbgl߁EʎqEj
+ *********************************************************************/
+#pragma once
+#include "input_recorder.h"
+
+//==============================================================================
+// pPbg`irbgA擪rbg LSB ɋl߂j
+//------------------------------------------------------------------------------
+//  wb_[      L[t[ 1 / V[PX 8
+//  ݒ          L[t[̂݁Ferbg - 1  4 rbg
+//  Et[ L[t[͐ΒlAȊO͑OpPbgƂ̍
+//  {^        ω 1 [+ XOR }XN]AGbWԂ狁܂Ȃ
+//                triggered / released / held ̂܂ܑ
+//   ~ 6        ω 1 [+  1 +  or Βl]
+//  ZT[      L 1 [+ WCLExL + 6 liƓj]
+//  ^b`pbh  L 1 [+ L 1 +  2 + wƂɉ 1 [+ x, y, ]]
+//
+// L[t[ȊO͒ÕpPbgOɂ̂ŁAMŃV[PX
+// r؂ꂽ Decode() ͎sBM ForceKeyframe() ĂԂA
+// keyframeInterval ŒIɃL[t[邱ƁB
+//==============================================================================
+namespace InputCodecFormat {
+    constexpr int SEQUENCE_BITS = 8;
+    constexpr int MAX_FIELD_BITS = 16;
+    constexpr int BUTTON_BITS = SDL_GAMEPAD_BUTTON_COUNT + 3;   // L2 / R2 + ڑ
+
+    // ʎq͈̔́iWC }2000dpsAx }8Gj
+    constexpr float GYRO_RANGE = 34.9066f;
+    constexpr float ACCEL_RANGE = 8.0f * SDL_STANDARD_GRAVITY;
+
+    // 1 pPbg̍őoCgiMobt@͂ꂾΕKj
+    constexpr size_t MAX_PACKET_SIZE = 128;
+}
+
+//==============================================================================
+// ʎqݒiL[t[Ɋ܂߂̂ŎM̐ݒ͕svj
+//==============================================================================
+struct InputCodecSettings {
+    int stickBits = 12;         // XeBbNitj
+    int triggerBits = 8;        // gK[
+    int sensorBits = 14;        // WCExitj
+    int touchBits = 12;         // ^b`W
+    int pressureBits = 6;       // ^b`
+    int keyframeInterval = 0;   // ̊ԊuŃL[t[i0 = ŏ ForceKeyframe() ̂݁j
+};
+
+//==============================================================================
+// ʎqς݂̏ԁi̊BMœlɂȂj
+//==============================================================================
+struct InputCodecReference {
+    struct Finger {
+        bool down;
+        Sint32 x;
+        Sint32 y;
+        Sint32 pressure;
+    };
+
+    Uint64 timeUS;
+    Uint32 frame;
+    Uint32 buttons;
+    Sint32 axes[SDL_GAMEPAD_AXIS_COUNT];
+
+    bool hasSensor;
+    bool hasGyro;
+    bool hasAccel;
+    Sint32 sensor[6];
+
+    bool hasTouchpad;
+    bool touchpadEnabled;
+    int numTouchpads;
+    Finger fingers[TouchpadData::MAX_TOUCHPADS][TouchpadData::MAX_FINGERS];
+
+    int bits[5];    // InputCodecSettings ̃rbgistick, trigger, sensor, touch, pressurej
+};
+
+//==============================================================================
+// GR[_[
+//==============================================================================
+class InputEncoder {
+public:
+    explicit InputEncoder(const InputCodecSettings& settings = InputCodecSettings());
+
+    // ݒςƎ̃pPbg̓L[t[ɂȂ
+    void SetSettings(const InputCodecSettings& settings);
+    const InputCodecSettings& GetSettings() const { return m_settings; }
+
+    // 񂾃oCgԂiobt@Ȃ 0 ŁAԂ͐i߂Ȃj
+    size_t Encode(const RecordedFrame& frame, Uint8* pBuffer, size_t capacity);
+
+    void ForceKeyframe() { m_forceKeyframe = true; }
+    void Reset();
+
+private:
+    InputCodecSettings m_settings;
+    InputCodecReference m_reference = {};
+    Uint8 m_sequence = 0;
+    int m_framesSinceKeyframe = 0;
+    bool m_forceKeyframe = true;
+};
+
+//==============================================================================
+// fR[_[
+//==============================================================================
+class InputDecoder {
+public:
+    InputDecoder() = default;
+
+    // ꂽpPbgEr؂ꂽpPbg falseipOut ƓԂ͕ςȂj
+    bool Decode(const Uint8* pData, size_t size, RecordedFrame* pOut);
+
+    // L[t[󂯎čǂ߂Ԃ
+    bool HasReference() const { return m_hasReference; }
+    void Reset();
+
+private:
+    InputCodecReference m_reference = {};
+    Uint8 m_sequence = 0;
+    bool m_hasReference = false;
+};
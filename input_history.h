@@ -0,0 +1,238 @@
+/*********************************************************************
+ * \file   input_history.h
+ * \brief  t[ԍň͗i[obNEśE߃vCpj
+ *********************************************************************/
+#pragma once
+#include "game_controller.h"
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+//==============================================================================
+// 1 pbh 1 t[̓́i16 oCgj
+//------------------------------------------------------------------------------
+//  16bit ɗʎq̂ŁA\Ɗm̔rɕ_̌덷oȂB
+// GbWitriggered j͎AWJɑOt[̃{^狁ߒB
+//==============================================================================
+struct PackedInput {
+    static constexpr Uint32 CONNECTED_BIT = 1u << 31;
+
+    Uint32 buttons = 0;         // GamepadButtonMask + CONNECTED_BIT
+    Sint16 leftStickX = 0;
+    Sint16 leftStickY = 0;
+    Sint16 rightStickX = 0;
+    Sint16 rightStickY = 0;
+    Sint16 leftTrigger = 0;
+    Sint16 rightTrigger = 0;
+
+    static PackedInput Pack(const GamepadState& state) {
+        PackedInput input;
+        input.buttons = (state.buttons & ~CONNECTED_BIT) | (state.connected ? CONNECTED_BIT : 0);
+        input.leftStickX = PackAxis(state.leftStickX);
+        input.leftStickY = PackAxis(state.leftStickY);
+        input.rightStickX = PackAxis(state.rightStickX);
+        input.rightStickY = PackAxis(state.rightStickY);
+        input.leftTrigger = PackAxis(state.leftTrigger);
+        input.rightTrigger = PackAxis(state.rightTrigger);
+        return input;
+    }
+
+    // prevButtons ͑Ot[ PackedInput::buttons
+    GamepadState Unpack(Uint32 prevButtons) const {
+        GamepadState state;
+        state.leftStickX = UnpackAxis(leftStickX);
+        state.leftStickY = UnpackAxis(leftStickY);
+        state.rightStickX = UnpackAxis(rightStickX);
+        state.rightStickY = UnpackAxis(rightStickY);
+        state.leftTrigger = UnpackAxis(leftTrigger);
+        state.rightTrigger = UnpackAxis(rightTrigger);
+        state.buttons = buttons & ~CONNECTED_BIT;
+        state.connected = (buttons & CONNECTED_BIT) != 0;
+        state.UpdateEdges(prevButtons & ~CONNECTED_BIT);
+        return state;
+    }
+
+    bool operator==(const PackedInput& other) const {
+        return buttons == other.buttons &&
+            leftStickX == other.leftStickX && leftStickY == other.leftStickY &&
+            rightStickX == other.rightStickX && rightStickY == other.rightStickY &&
+            leftTrigger == other.leftTrigger && rightTrigger == other.rightTrigger;
+    }
+    bool operator!=(const PackedInput& other) const { return !(*this == other); }
+
+private:
+    static Sint16 PackAxis(float value) {
+        if (value > 1.0f) value = 1.0f;
+        if (value < -1.0f) value = -1.0f;
+        return static_cast<Sint16>(std::lround(value * 32767.0f));
+    }
+    static float UnpackAxis(Sint16 value) { return value / 32767.0f; }
+};
+
+static_assert(sizeof(PackedInput) == 16, "PackedInput must stay 16 bytes");
+static_assert(std::is_trivially_copyable<PackedInput>::value, "PackedInput must be trivially copyable");
+
+//==============================================================================
+// ͗
+//------------------------------------------------------------------------------
+// t[ԍ & (CAPACITY - 1) ̈ʒuɑSpbhuŒ蒷OB
+// EL^ O(1) ŃmۂȂBCAPACITY t[Â͂
+// Vt[ɏ㏑̂ŁA[obN̍ő啝傫邱ƁB
+//
+// gi[obNjF
+//   E[g̓͂͂ĂȂt[ RecordPrediction() ŗ\L^Đi߂
+//   E͂ Record(..., true) Ŋm肳B\ƈႦ TakeFirstMismatch() 
+//     ̃t[Ԃ̂ŁA܂Ŋ߂čăV~[V
+//   Emς݂̓͂͗\ŏ㏑Ȃ
+//==============================================================================
+template<size_t CAPACITY, int PAD_COUNT>
+class InputHistory {
+    static_assert(CAPACITY > 1 && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+    static_assert(CAPACITY <= 0x40000000, "CAPACITY is too large");
+    static_assert(PAD_COUNT > 0 && PAD_COUNT <= 31, "PAD_COUNT must be 1..31");
+
+public:
+    static constexpr Sint32 NO_FRAME = -1;
+    static constexpr Sint32 FRAME_CAPACITY = static_cast<Sint32>(CAPACITY);
+
+    InputHistory() { Reset(); }
+
+    void Reset() {
+        for (Entry& entry : m_entries) {
+            entry.frame = NO_FRAME;
+            entry.recordedPads = 0;
+            entry.confirmedPads = 0;
+        }
+        for (PackedInput& input : m_lastConfirmed) input = {};
+        m_latestFrame = NO_FRAME;
+        m_firstMismatch = NO_FRAME;
+    }
+
+    //--------------------------------------------------------------------------
+    // L^
+    //--------------------------------------------------------------------------
+    // \iconfirmed = falsej܂͊m͂L^B
+    // ɏ㏑ꂽÂt[͈͊Õpbh falseB
+    bool Record(Sint32 frame, int pad, const PackedInput& input, bool confirmed) {
+        if (frame < 0 || !IsValidPad(pad) || IsExpired(frame)) return false;
+
+        Entry& entry = m_entries[frame & (FRAME_CAPACITY - 1)];
+        if (entry.frame != frame) {
+            entry.frame = frame;
+            entry.recordedPads = 0;
+            entry.confirmedPads = 0;
+        }
+
+        Uint32 bit = 1u << pad;
+        if (entry.confirmedPads & bit) return true;
+
+        if (confirmed) {
+            // \gĐi߂Ăt[ȂHႢL^
+            if ((entry.recordedPads & bit) && entry.pads[pad] != input) {
+                NoteMismatch(frame);
+            }
+            entry.confirmedPads |= bit;
+            m_lastConfirmed[pad] = input;
+        }
+        entry.pads[pad] = input;
+        entry.recordedPads |= bit;
+
+        if (frame > m_latestFrame) m_latestFrame = frame;
+        return true;
+    }
+
+    bool Record(Sint32 frame, int pad, const GamepadState& state, bool confirmed) {
+        return Record(frame, pad, PackedInput::Pack(state), confirmed);
+    }
+
+    // \l߂iOt[̓́A΍ŌɊm肵͂JԂj
+    PackedInput Predict(Sint32 frame, int pad) const {
+        if (!IsValidPad(pad)) return {};
+        const PackedInput* pPrev = Find(frame - 1, pad);
+        return pPrev ? *pPrev : m_lastConfirmed[pad];
+    }
+
+    bool RecordPrediction(Sint32 frame, int pad) {
+        return Record(frame, pad, Predict(frame, pad), false);
+    }
+
+    //--------------------------------------------------------------------------
+    // Q
+    //--------------------------------------------------------------------------
+    // L^i܂͏㏑ς݁jȂ nullptr
+    const PackedInput* Find(Sint32 frame, int pad) const {
+        if (frame < 0 || !IsValidPad(pad) || IsExpired(frame)) return nullptr;
+        const Entry& entry = m_entries[frame & (FRAME_CAPACITY - 1)];
+        if (entry.frame != frame || !(entry.recordedPads & (1u << pad))) return nullptr;
+        return &entry.pads[pad];
+    }
+
+    // GamepadState ɓWJiOt[ꍇ̓GbWȂj
+    bool GetState(Sint32 frame, int pad, GamepadState* pOut) const {
+        const PackedInput* pInput = Find(frame, pad);
+        if (!pInput) return false;
+        const PackedInput* pPrev = Find(frame - 1, pad);
+        *pOut = pInput->Unpack(pPrev ? pPrev->buttons : pInput->buttons);
+        return true;
+    }
+
+    bool IsConfirmed(Sint32 frame, int pad) const {
+        if (frame < 0 || !IsValidPad(pad) || IsExpired(frame)) return false;
+        const Entry& entry = m_entries[frame & (FRAME_CAPACITY - 1)];
+        return entry.frame == frame && (entry.confirmedPads & (1u << pad)) != 0;
+    }
+
+    // Spbhm肵Ă邩
+    bool IsFrameConfirmed(Sint32 frame) const {
+        if (frame < 0 || IsExpired(frame)) return false;
+        const Entry& entry = m_entries[frame & (FRAME_CAPACITY - 1)];
+        return entry.frame == frame && entry.confirmedPads == ALL_PADS;
+    }
+
+    Sint32 GetLatestFrame() const { return m_latestFrame; }
+    Sint32 GetOldestFrame() const {
+        if (m_latestFrame == NO_FRAME) return NO_FRAME;
+        Sint32 oldest = m_latestFrame - FRAME_CAPACITY + 1;
+        return oldest < 0 ? 0 : oldest;
+    }
+
+    //--------------------------------------------------------------------------
+    // \̐HႢ
+    //--------------------------------------------------------------------------
+    // \Ɗm肪HłÂt[i NO_FRAMEj
+    Sint32 GetFirstMismatch() const { return m_firstMismatch; }
+
+    // 擾ăNAi߂n߂ƂɌĂԁj
+    Sint32 TakeFirstMismatch() {
+        Sint32 frame = m_firstMismatch;
+        m_firstMismatch = NO_FRAME;
+        return frame;
+    }
+
+private:
+    static constexpr Uint32 ALL_PADS = (1u << PAD_COUNT) - 1;
+
+    struct Entry {
+        Sint32 frame;
+        Uint32 recordedPads;    // L^̂pbh
+        Uint32 confirmedPads;   // m肵pbh
+        PackedInput pads[PAD_COUNT];
+    };
+
+    static bool IsValidPad(int pad) { return pad >= 0 && pad < PAD_COUNT; }
+
+    bool IsExpired(Sint32 frame) const {
+        return m_latestFrame != NO_FRAME && frame <= m_latestFrame - FRAME_CAPACITY;
+    }
+
+    void NoteMismatch(Sint32 frame) {
+        if (m_firstMismatch == NO_FRAME || frame < m_firstMismatch) {
+            m_firstMismatch = frame;
+        }
+    }
+
+    Entry m_entries[CAPACITY];
+    PackedInput m_lastConfirmed[PAD_COUNT];
+    Sint32 m_latestFrame = NO_FRAME;
+    Sint32 m_firstMismatch = NO_FRAME;
+};
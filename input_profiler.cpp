@@ -0,0 +1,326 @@
+/*********************************************************************
+ * \file   input_profiler.cpp
+ * \brief  ͒xERXǧviGC_ENABLE_PROFILING `̂ݗLj
+ *********************************************************************/
+#include "input_profiler.h"
+#include <cstdio>
+
+//==============================================================================
+// qXgO
+//==============================================================================
+namespace {
+    int MostSignificantBit64(Uint64 value) {
+        Uint32 high = static_cast<Uint32>(value >> 32);
+        if (high) return 32 + SDL_MostSignificantBitIndex32(high);
+        return SDL_MostSignificantBitIndex32(static_cast<Uint32>(value));
+    }
+}
+
+int ProfileHistogram::BucketIndex(Uint64 valueNS) {
+    if (valueNS < 4) return static_cast<int>(valueNS);
+
+    int msb = MostSignificantBit64(valueNS);
+    int sub = static_cast<int>((valueNS >> (msb - 2)) & 3);
+    int index = (msb - 1) * 4 + sub;
+    return (index < BUCKET_COUNT) ? index : BUCKET_COUNT - 1;
+}
+
+// Ō̃oPbg̉iwb_[̃Rg̒lƍ킹Ăj
+static_assert(ProfileHistogram::BucketLowerBound(ProfileHistogram::BUCKET_COUNT - 1) == (7ull << 38),
+    "update the range in the ProfileHistogram comment");
+
+void ProfileHistogram::Record(Uint64 valueNS) {
+    buckets[BucketIndex(valueNS)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(valueNS, std::memory_order_relaxed);
+
+    Uint64 current = min.load(std::memory_order_relaxed);
+    while (valueNS < current && !min.compare_exchange_weak(current, valueNS, std::memory_order_relaxed)) {
+    }
+    current = max.load(std::memory_order_relaxed);
+    while (valueNS > current && !max.compare_exchange_weak(current, valueNS, std::memory_order_relaxed)) {
+    }
+}
+
+void ProfileHistogram::Reset() {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        buckets[i].store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    min.store(SDL_MAX_UINT64, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+}
+
+Uint64 ProfileHistogram::GetMean() const {
+    Uint64 n = GetCount();
+    return n ? sum.load(std::memory_order_relaxed) / n : 0;
+}
+
+// oPbg̒lԂiől𒴂Ȃ悤Ɋۂ߂j
+Uint64 ProfileHistogram::GetPercentile(double percentile) const {
+    Uint64 n = GetCount();
+    if (n == 0) return 0;
+
+    Uint64 target = static_cast<Uint64>(percentile / 100.0 * static_cast<double>(n));
+    if (target >= n) target = n - 1;
+
+    Uint64 seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen > target) {
+            Uint64 lower = BucketLowerBound(i);
+            Uint64 value = lower + (BucketLowerBound(i + 1) - lower) / 2;
+            Uint64 maxValue = GetMax();
+            return (value < maxValue) ? value : maxValue;
+        }
+    }
+    return GetMax();
+}
+
+#if defined(GC_ENABLE_PROFILING)
+
+//==============================================================================
+// 
+//==============================================================================
+namespace {
+    // g[X 1 iԂ܂͒lj
+    struct TraceEntry {
+        Uint64 beginNS;
+        Uint64 durationNS;
+        Uint32 threadId;
+        Uint8 metric;
+        Uint8 isSpan;
+    };
+
+    ProfileHistogram s_histograms[PROFILE_METRIC_COUNT];
+    ProfileHistogram s_deviceLatency[InputProfiler::MAX_DEVICES];
+    ProfileHistogram s_deviceInterval[InputProfiler::MAX_DEVICES];
+
+    // foCX\iRecordEvent ĂԃXbĥ݂ށj
+    SDL_JoystickID s_deviceIds[InputProfiler::MAX_DEVICES] = {};
+    Uint64 s_lastEventNS[InputProfiler::MAX_DEVICES] = {};
+
+    // g[X͏㏑ĂOiőL^͈ꕔ邱Ƃj
+    TraceEntry s_trace[InputProfiler::TRACE_CAPACITY];
+    std::atomic<Uint32> s_traceWrite{ 0 };
+
+    const char* const METRIC_NAMES[PROFILE_METRIC_COUNT] = {
+        "event_latency",
+        "report_interval",
+        "update_total",
+        "update_poll",
+        "update_sensor",
+        "update_state",
+        "update_haptics",
+        "rumble_latency",
+        "led_latency",
+    };
+
+    void PushTrace(ProfileMetric metric, Uint64 beginNS, Uint64 durationNS, bool isSpan) {
+        Uint32 index = s_traceWrite.fetch_add(1, std::memory_order_relaxed) & (InputProfiler::TRACE_CAPACITY - 1);
+        TraceEntry& entry = s_trace[index];
+        entry.beginNS = beginNS;
+        entry.durationNS = durationNS;
+        entry.threadId = static_cast<Uint32>(SDL_GetCurrentThreadID());
+        entry.metric = static_cast<Uint8>(metric);
+        entry.isSpan = isSpan ? 1 : 0;
+    }
+
+    int FindDevice(SDL_JoystickID id) {
+        for (int i = 0; i < InputProfiler::MAX_DEVICES; i++) {
+            if (s_deviceIds[i] == id) return i;
+        }
+        for (int i = 0; i < InputProfiler::MAX_DEVICES; i++) {
+            if (s_deviceIds[i] == 0) {
+                s_deviceIds[i] = id;
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    bool IsDeviceMetric(ProfileMetric metric) {
+        return metric == PROFILE_EVENT_LATENCY || metric == PROFILE_REPORT_INTERVAL;
+    }
+
+    void WriteHistogramCSV(FILE* pFile, ProfileMetric metric, int device, const ProfileHistogram& histogram) {
+        if (histogram.GetCount() == 0) return;
+        fprintf(pFile, "summary,%s,%d,,%llu,%llu,%llu,%llu,%llu,%llu,%llu\n",
+            METRIC_NAMES[metric], device,
+            static_cast<unsigned long long>(histogram.GetCount()),
+            static_cast<unsigned long long>(histogram.GetMin()),
+            static_cast<unsigned long long>(histogram.GetPercentile(50.0)),
+            static_cast<unsigned long long>(histogram.GetPercentile(90.0)),
+            static_cast<unsigned long long>(histogram.GetPercentile(99.0)),
+            static_cast<unsigned long long>(histogram.GetMax()),
+            static_cast<unsigned long long>(histogram.GetMean()));
+        for (int i = 0; i < ProfileHistogram::BUCKET_COUNT; i++) {
+            Uint32 n = histogram.buckets[i].load(std::memory_order_relaxed);
+            if (n == 0) continue;
+            fprintf(pFile, "bucket,%s,%d,%llu,%u,,,,,,\n", METRIC_NAMES[metric], device,
+                static_cast<unsigned long long>(ProfileHistogram::BucketLowerBound(i)), n);
+        }
+    }
+}
+
+static_assert((InputProfiler::TRACE_CAPACITY & (InputProfiler::TRACE_CAPACITY - 1)) == 0,
+    "TRACE_CAPACITY must be a power of two");
+
+//==============================================================================
+// L^
+//==============================================================================
+bool InputProfiler::IsEnabled() {
+    return true;
+}
+
+void InputProfiler::Record(ProfileMetric metric, Uint64 valueNS) {
+    s_histograms[metric].Record(valueNS);
+    PushTrace(metric, SDL_GetTicksNS(), valueNS, false);
+}
+
+void InputProfiler::RecordSpan(ProfileMetric metric, Uint64 beginNS, Uint64 endNS) {
+    Uint64 durationNS = endNS - beginNS;
+    s_histograms[metric].Record(durationNS);
+    PushTrace(metric, beginNS, durationNS, true);
+}
+
+void InputProfiler::RecordEvent(SDL_JoystickID id, Uint64 eventNS) {
+    if (eventNS == 0) return;
+
+    Uint64 nowNS = SDL_GetTicksNS();
+    Uint64 latencyNS = (nowNS > eventNS) ? nowNS - eventNS : 0;
+    s_histograms[PROFILE_EVENT_LATENCY].Record(latencyNS);
+
+    int device = FindDevice(id);
+    if (device < 0) return;
+    s_deviceLatency[device].Record(latencyNS);
+
+    // |[goCxg͓^CX^vȂ̂ŊԊuɐȂ
+    Uint64 lastNS = s_lastEventNS[device];
+    if (lastNS != 0 && eventNS > lastNS) {
+        s_deviceInterval[device].Record(eventNS - lastNS);
+        s_histograms[PROFILE_REPORT_INTERVAL].Record(eventNS - lastNS);
+    }
+    if (eventNS > lastNS) {
+        s_lastEventNS[device] = eventNS;
+    }
+}
+
+//==============================================================================
+// Q
+//==============================================================================
+const ProfileHistogram* InputProfiler::GetHistogram(ProfileMetric metric, int device) {
+    if (metric < 0 || metric >= PROFILE_METRIC_COUNT) return nullptr;
+    if (device < 0) return &s_histograms[metric];
+    if (device >= MAX_DEVICES || !IsDeviceMetric(metric)) return nullptr;
+    return (metric == PROFILE_EVENT_LATENCY) ? &s_deviceLatency[device] : &s_deviceInterval[device];
+}
+
+SDL_JoystickID InputProfiler::GetDeviceId(int device) {
+    return (device >= 0 && device < MAX_DEVICES) ? s_deviceIds[device] : 0;
+}
+
+float InputProfiler::GetReportRate(int device) {
+    const ProfileHistogram* pHistogram = GetHistogram(PROFILE_REPORT_INTERVAL, device);
+    if (!pHistogram) return 0.0f;
+    Uint64 medianNS = pHistogram->GetPercentile(50.0);
+    return medianNS ? static_cast<float>(SDL_NS_PER_SECOND) / static_cast<float>(medianNS) : 0.0f;
+}
+
+const char* InputProfiler::GetMetricName(ProfileMetric metric) {
+    return (metric >= 0 && metric < PROFILE_METRIC_COUNT) ? METRIC_NAMES[metric] : "";
+}
+
+void InputProfiler::Reset() {
+    for (int i = 0; i < PROFILE_METRIC_COUNT; i++) {
+        s_histograms[i].Reset();
+    }
+    for (int i = 0; i < MAX_DEVICES; i++) {
+        s_deviceLatency[i].Reset();
+        s_deviceInterval[i].Reset();
+        s_deviceIds[i] = 0;
+        s_lastEventNS[i] = 0;
+    }
+    s_traceWrite.store(0, std::memory_order_relaxed);
+}
+
+//==============================================================================
+// CSV o
+//------------------------------------------------------------------------------
+// summary s̓qXgO̗vAbucket s͋łȂoPbgilower_ns ȏǰB
+// device  -1 ̍s͑SfoCX̍vB
+//==============================================================================
+bool InputProfiler::DumpCSV(const char* pPath) {
+    FILE* pFile = fopen(pPath, "w");
+    if (!pFile) return false;
+
+    fprintf(pFile, "kind,metric,device,lower_ns,count,min_ns,p50_ns,p90_ns,p99_ns,max_ns,mean_ns\n");
+    for (int i = 0; i < PROFILE_METRIC_COUNT; i++) {
+        ProfileMetric metric = static_cast<ProfileMetric>(i);
+        WriteHistogramCSV(pFile, metric, -1, s_histograms[i]);
+        if (!IsDeviceMetric(metric)) continue;
+        for (int device = 0; device < MAX_DEVICES; device++) {
+            if (s_deviceIds[device] == 0) continue;
+            WriteHistogramCSV(pFile, metric, device, *GetHistogram(metric, device));
+        }
+    }
+
+    fclose(pFile);
+    return true;
+}
+
+//==============================================================================
+// Chrome g[Xichrome://tracing / Perfettojo
+//------------------------------------------------------------------------------
+// Ԃ "X"AlixȂǁj "C" ̃JE^[ƂďB̓}CNbB
+//==============================================================================
+bool InputProfiler::DumpChromeTrace(const char* pPath) {
+    FILE* pFile = fopen(pPath, "w");
+    if (!pFile) return false;
+
+    Uint32 end = s_traceWrite.load(std::memory_order_acquire);
+    Uint32 begin = (end > static_cast<Uint32>(TRACE_CAPACITY)) ? end - TRACE_CAPACITY : 0;
+
+    fprintf(pFile, "{\"traceEvents\":[\n");
+    bool first = true;
+    for (Uint32 i = begin; i < end; i++) {
+        const TraceEntry& entry = s_trace[i & (TRACE_CAPACITY - 1)];
+        if (entry.metric >= PROFILE_METRIC_COUNT) continue;
+
+        const char* pName = METRIC_NAMES[entry.metric];
+        double ts = static_cast<double>(entry.beginNS) / 1000.0;
+        double value = static_cast<double>(entry.durationNS) / 1000.0;
+        if (entry.isSpan) {
+            fprintf(pFile, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                first ? "" : ",\n", pName, entry.threadId, ts, value);
+        } else {
+            fprintf(pFile, "%s{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"args\":{\"us\":%.3f}}",
+                first ? "" : ",\n", pName, entry.threadId, ts, value);
+        }
+        first = false;
+    }
+    fprintf(pFile, "\n]}\n");
+
+    fclose(pFile);
+    return true;
+}
+
+#else
+
+//==============================================================================
+// iĂяo͎c邪L^Ȃj
+//==============================================================================
+bool InputProfiler::IsEnabled() { return false; }
+void InputProfiler::Record(ProfileMetric, Uint64) {}
+void InputProfiler::RecordSpan(ProfileMetric, Uint64, Uint64) {}
+void InputProfiler::RecordEvent(SDL_JoystickID, Uint64) {}
+const ProfileHistogram* InputProfiler::GetHistogram(ProfileMetric, int) { return nullptr; }
+SDL_JoystickID InputProfiler::GetDeviceId(int) { return 0; }
+float InputProfiler::GetReportRate(int) { return 0.0f; }
+const char* InputProfiler::GetMetricName(ProfileMetric) { return ""; }
+void InputProfiler::Reset() {}
+bool InputProfiler::DumpCSV(const char*) { return false; }
+bool InputProfiler::DumpChromeTrace(const char*) { return false; }
+
+#endif
@@ -0,0 +1,114 @@
+/*********************************************************************
+ * \file   input_profiler.h
+ * \brief  ͒xERXǧviGC_ENABLE_PROFILING `̂ݗLj
+ *********************************************************************/
+#pragma once
+#include <SDL3/SDL.h>
+#include <atomic>
+
+//==============================================================================
+// v
+//==============================================================================
+enum ProfileMetric {
+    PROFILE_EVENT_LATENCY = 0,  // Cxg̃^CX^v Update() Ŏ荞ނ܂ŁifoCXʁj
+    PROFILE_REPORT_INTERVAL,    // foCX̃|[gԊuifoCXʁAt|[g[gj
+    PROFILE_UPDATE_TOTAL,       // Update() S
+    PROFILE_UPDATE_POLL,        // SDL_PollEvent / O̎o
+    PROFILE_UPDATE_SENSOR,      // ZT[t[̊m
+    PROFILE_UPDATE_STATE,       // UpdateState()
+    PROFILE_UPDATE_HAPTICS,     // U̍
+    PROFILE_RUMBLE_LATENCY,     // U̗v珑݊܂
+    PROFILE_LED_LATENCY,        // LED ̗v珑݊܂
+    PROFILE_METRIC_COUNT
+};
+
+//==============================================================================
+// ŒoPbg̃qXgOibNt[j
+//------------------------------------------------------------------------------
+// 2 ׂ̂悲Ƃ 4 oPbgiΌ덷 25% ȓjBŌ̃oPbg
+// BucketLowerBound(BUCKET_COUNT - 1) = 7 ~ 2^38 nsi 32 jȏ܂Ƃ߂ĐB
+// L^͕Xbh瓯ɍsĂ悢B
+//==============================================================================
+struct ProfileHistogram {
+    static constexpr int BUCKET_COUNT = 160;
+
+    std::atomic<Uint32> buckets[BUCKET_COUNT];
+    std::atomic<Uint64> count;
+    std::atomic<Uint64> sum;
+    std::atomic<Uint64> min;
+    std::atomic<Uint64> max;
+
+    ProfileHistogram() { Reset(); }
+
+    void Record(Uint64 valueNS);
+    void Reset();
+
+    Uint64 GetCount() const { return count.load(std::memory_order_relaxed); }
+    Uint64 GetMin() const { return GetCount() ? min.load(std::memory_order_relaxed) : 0; }
+    Uint64 GetMax() const { return max.load(std::memory_order_relaxed); }
+    Uint64 GetMean() const;
+    Uint64 GetPercentile(double percentile) const;
+
+    static int BucketIndex(Uint64 valueNS);
+    static constexpr Uint64 BucketLowerBound(int index) {
+        // index = (ŏʃrbg - 1) ~ 4 + ̉ 2 rbg
+        return (index < 4) ? static_cast<Uint64>(index)
+                           : static_cast<Uint64>(4 + index % 4) << (index / 4 - 1);
+    }
+};
+
+//==============================================================================
+// vNX
+//==============================================================================
+class InputProfiler {
+public:
+    static constexpr int MAX_DEVICES = 8;
+    static constexpr int TRACE_CAPACITY = 8192;
+
+    static bool IsEnabled();
+
+    // L^iǂ̃Xbhł悢j
+    static void Record(ProfileMetric metric, Uint64 valueNS);
+    static void RecordSpan(ProfileMetric metric, Uint64 beginNS, Uint64 endNS);
+
+    // Cxg 1 ̒xƃ|[gԊuiUpdate() ĂԃXbĥ݁j
+    static void RecordEvent(SDL_JoystickID id, Uint64 eventNS);
+
+    // QƁidevice ̓foCXʂ̍ڂ̂݁A-1 őSfoCX̍vj
+    static const ProfileHistogram* GetHistogram(ProfileMetric metric, int device = -1);
+    static SDL_JoystickID GetDeviceId(int device);
+    static float GetReportRate(int device);
+    static const char* GetMetricName(ProfileMetric metric);
+    static void Reset();
+
+    // o
+    static bool DumpCSV(const char* pPath);
+    static bool DumpChromeTrace(const char* pPath);
+
+    // Ԍvp
+    class Scope {
+    public:
+        explicit Scope(ProfileMetric metric) : m_metric(metric), m_beginNS(SDL_GetTicksNS()) {}
+        ~Scope() { RecordSpan(m_metric, m_beginNS, SDL_GetTicksNS()); }
+    private:
+        ProfileMetric m_metric;
+        Uint64 m_beginNS;
+    };
+};
+
+//==============================================================================
+// v}NiGC_ENABLE_PROFILING ΉȂj
+//==============================================================================
+#if defined(GC_ENABLE_PROFILING)
+#define GC_PROFILE_CONCAT_INNER(a, b) a##b
+#define GC_PROFILE_CONCAT(a, b) GC_PROFILE_CONCAT_INNER(a, b)
+#define GC_PROFILE_SCOPE(metric) InputProfiler::Scope GC_PROFILE_CONCAT(gcProfileScope, __LINE__)(metric)
+#define GC_PROFILE_RECORD(metric, valueNS) InputProfiler::Record((metric), (valueNS))
+#define GC_PROFILE_EVENT(id, eventNS) InputProfiler::RecordEvent((id), (eventNS))
+#define GC_PROFILE_ONLY(statement) statement
+#else
+#define GC_PROFILE_SCOPE(metric)
+#define GC_PROFILE_RECORD(metric, valueNS) ((void)0)
+#define GC_PROFILE_EVENT(id, eventNS) ((void)0)
+#define GC_PROFILE_ONLY(statement)
+#endif
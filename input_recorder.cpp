@@ -0,0 +1,471 @@
+/*********************************************************************
+ * \file   input_recorder.cpp
+ * \brief  ͂̋L^ƍĐio[WtoCi` / mmap ǂݍ݁j
+ *********************************************************************/
+#include "input_recorder.h"
+#include "game_controller.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace InputRecordFormat;
+
+//==============================================================================
+// 萔Ewp[
+//==============================================================================
+namespace {
+    // R[h̊eubÑTCY
+    constexpr size_t RECORD_HEADER_SIZE = 16;   // timestampNS, frame, flags, size
+    constexpr size_t STATE_BLOCK_SIZE = 40;     //  6, {^}XN 4
+    constexpr size_t SENSOR_BLOCK_SIZE = 28;    // WC 3, x 3, L 2 + \ 2
+    constexpr size_t TOUCHPAD_BLOCK_SIZE = 132; // L,  + \ 2, w 2 ~ 4 ~ ( + \ 3, x, y, )
+    constexpr size_t TOUCHPAD_BLOCK_SIZE_V1 = 28;   // L,  + \ 2, w 2 ~ ( + \ 3, x, y)
+    constexpr size_t MAX_RECORD_SIZE = RECORD_HEADER_SIZE + STATE_BLOCK_SIZE + SENSOR_BLOCK_SIZE + TOUCHPAD_BLOCK_SIZE;
+
+    template<typename T>
+    void Put(Uint8*& p, T value) {
+        std::memcpy(p, &value, sizeof(T));
+        p += sizeof(T);
+    }
+
+    template<typename T>
+    T Get(const Uint8*& p) {
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+        p += sizeof(T);
+        return value;
+    }
+}
+
+//==============================================================================
+// R[_[FJ
+//==============================================================================
+bool InputRecorder::Open(const char* pPath) {
+    Close();
+
+    m_pStream = SDL_IOFromFile(pPath, "wb");
+    if (!m_pStream) return false;
+
+    FileHeader header = {};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.startTimeNS = SDL_GetTicksNS();
+    if (SDL_WriteIO(m_pStream, &header, sizeof(header)) != sizeof(header)) {
+        SDL_CloseIO(m_pStream);
+        m_pStream = nullptr;
+        return false;
+    }
+
+    m_offset = sizeof(header);
+    m_frameCount = 0;
+    m_failed = false;
+    m_index.clear();
+    return true;
+}
+
+//==============================================================================
+// R[_[FiCfbNXƃtb^[j
+//==============================================================================
+void InputRecorder::Close() {
+    if (!m_pStream) return;
+
+    FileFooter footer = {};
+    footer.recordsEnd = m_offset;
+
+    // CfbNX 8 oCgEɒu
+    static const Uint8 PADDING[8] = {};
+    size_t padding = static_cast<size_t>((8 - (m_offset & 7)) & 7);
+    SDL_WriteIO(m_pStream, PADDING, padding);
+    footer.indexOffset = m_offset + padding;
+
+    if (!m_index.empty()) {
+        SDL_WriteIO(m_pStream, m_index.data(), m_index.size() * sizeof(IndexEntry));
+    }
+
+    footer.indexCount = static_cast<Uint32>(m_index.size());
+    footer.frameCount = m_frameCount;
+    footer.magic = FOOTER_MAGIC;
+    SDL_WriteIO(m_pStream, &footer, sizeof(footer));
+
+    SDL_CloseIO(m_pStream);
+    m_pStream = nullptr;
+    m_index.clear();
+}
+
+//==============================================================================
+// R[_[Ft[ǋL
+//==============================================================================
+bool InputRecorder::RecordFrame(const GamepadState& state, const SensorData* pSensor, const TouchpadData* pTouchpad) {
+    if (!m_pStream || m_failed) return false;
+
+    Uint64 timestampNS = SDL_GetTicksNS();
+
+    Uint16 flags = 0;
+    if (state.connected) flags |= FLAG_CONNECTED;
+    if (pSensor) flags |= FLAG_SENSOR;
+    if (pTouchpad) flags |= FLAG_TOUCHPAD;
+
+    Uint8 buffer[MAX_RECORD_SIZE] = {};
+    Uint8* p = buffer + RECORD_HEADER_SIZE;
+
+    // 
+    Put(p, state.leftStickX);
+    Put(p, state.leftStickY);
+    Put(p, state.rightStickX);
+    Put(p, state.rightStickY);
+    Put(p, state.leftTrigger);
+    Put(p, state.rightTrigger);
+    Put(p, state.buttons);
+    Put(p, state.triggered);
+    Put(p, state.released);
+    Put(p, state.held);
+
+    // ZT[
+    if (pSensor) {
+        Put(p, pSensor->gyroX);
+        Put(p, pSensor->gyroY);
+        Put(p, pSensor->gyroZ);
+        Put(p, pSensor->accelX);
+        Put(p, pSensor->accelY);
+        Put(p, pSensor->accelZ);
+        Put(p, static_cast<Uint8>(pSensor->hasGyro));
+        Put(p, static_cast<Uint8>(pSensor->hasAccel));
+        p += 2;
+    }
+
+    // ^b`pbh
+    if (pTouchpad) {
+        Put(p, static_cast<Uint8>(pTouchpad->hasTouchpad));
+        Put(p, static_cast<Uint8>(pTouchpad->numTouchpads));
+        p += 2;
+        for (int pad = 0; pad < TouchpadData::MAX_TOUCHPADS; pad++) {
+            for (int i = 0; i < TouchpadData::MAX_FINGERS; i++) {
+                const TouchpadData::Finger& finger = pTouchpad->fingers[pad][i];
+                Put(p, static_cast<Uint8>(finger.down));
+                p += 3;
+                Put(p, finger.x);
+                Put(p, finger.y);
+                Put(p, finger.pressure);
+            }
+        }
+    }
+
+    // wb_[
+    Uint16 size = static_cast<Uint16>(p - buffer);
+    Uint8* pHeader = buffer;
+    Put(pHeader, timestampNS);
+    Put(pHeader, m_frameCount);
+    Put(pHeader, flags);
+    Put(pHeader, size);
+
+    size_t written = SDL_WriteIO(m_pStream, buffer, size);
+    if (written != size) {
+        // ̃R[ĥ͎ĂĈȍ~͋L^ȂiClose() ł܂ł̃tb^[j
+        if (written > 0) SDL_SeekIO(m_pStream, static_cast<Sint64>(m_offset), SDL_IO_SEEK_SET);
+        m_failed = true;
+        return false;
+    }
+
+    // CfbNX͏R[hw
+    if (m_frameCount % INDEX_INTERVAL == 0) {
+        IndexEntry entry = {};
+        entry.frame = m_frameCount;
+        entry.timestampNS = timestampNS;
+        entry.offset = m_offset;
+        m_index.push_back(entry);
+    }
+
+    m_offset += size;
+    m_frameCount++;
+    return true;
+}
+
+bool InputRecorder::RecordCurrentFrame() {
+    SensorData sensor = GameController::GetSensorData();
+    TouchpadData touchpad = GameController::GetTouchpadData();
+    return RecordFrame(GameController::GetCurrentState(),
+        (sensor.hasGyro || sensor.hasAccel) ? &sensor : nullptr,
+        touchpad.hasTouchpad ? &touchpad : nullptr);
+}
+
+//==============================================================================
+// vCFJ
+//==============================================================================
+bool InputReplay::Open(const char* pPath) {
+    Close();
+
+#ifdef _WIN32
+    HANDLE hFile = CreateFileA(pPath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize = {};
+    if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(FileHeader))) {
+        CloseHandle(hFile);
+        return false;
+    }
+
+    HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* pView = hMapping ? MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!pView) {
+        if (hMapping) CloseHandle(hMapping);
+        CloseHandle(hFile);
+        return false;
+    }
+
+    m_hFile = hFile;
+    m_hMapping = hMapping;
+    m_pData = static_cast<const Uint8*>(pView);
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = open(pPath, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st = {};
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+        close(fd);
+        return false;
+    }
+
+    void* pView = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (pView == MAP_FAILED) return false;
+
+    m_pData = static_cast<const Uint8*>(pView);
+    m_size = static_cast<size_t>(st.st_size);
+#endif
+
+    FileHeader header;
+    std::memcpy(&header, m_pData, sizeof(header));
+    if (header.magic != MAGIC || header.version < MIN_READ_VERSION || header.version > VERSION) {
+        Close();
+        return false;
+    }
+    m_version = header.version;
+    m_startTimeNS = header.startTimeNS;
+
+    // tb^[ƃCfbNX
+    FileFooter footer = {};
+    if (m_size >= sizeof(FileHeader) + sizeof(FileFooter)) {
+        std::memcpy(&footer, m_pData + m_size - sizeof(FileFooter), sizeof(footer));
+    }
+
+    bool hasFooter = footer.magic == FOOTER_MAGIC &&
+        footer.recordsEnd <= footer.indexOffset &&
+        footer.indexOffset + static_cast<Uint64>(footer.indexCount) * sizeof(IndexEntry) + sizeof(FileFooter) <= m_size;
+
+    if (hasFooter) {
+        m_recordsEnd = static_cast<size_t>(footer.recordsEnd);
+        m_pIndex = reinterpret_cast<const IndexEntry*>(m_pData + footer.indexOffset);
+        m_indexCount = footer.indexCount;
+        m_frameCount = footer.frameCount;
+    } else {
+        // L^rŏIt@CFĂȂR[h܂ł𐔂
+        size_t offset = sizeof(FileHeader);
+        size_t next = 0;
+        m_recordsEnd = m_size;
+        m_frameCount = 0;
+        while (ParseRecord(offset, nullptr, &next)) {
+            offset = next;
+            m_frameCount++;
+        }
+        m_recordsEnd = offset;
+    }
+
+    Rewind();
+    return true;
+}
+
+//==============================================================================
+// vCF
+//==============================================================================
+void InputReplay::Close() {
+    if (m_pData) {
+#ifdef _WIN32
+        UnmapViewOfFile(m_pData);
+        CloseHandle(static_cast<HANDLE>(m_hMapping));
+        CloseHandle(static_cast<HANDLE>(m_hFile));
+#else
+        munmap(const_cast<Uint8*>(m_pData), m_size);
+#endif
+    }
+
+    m_pData = nullptr;
+    m_size = 0;
+    m_hFile = nullptr;
+    m_hMapping = nullptr;
+    m_pIndex = nullptr;
+    m_indexCount = 0;
+    m_frameCount = 0;
+    m_version = 0;
+    m_recordsEnd = 0;
+    m_cursor = 0;
+    m_cursorFrame = 0;
+}
+
+//==============================================================================
+// vCFV[N
+//==============================================================================
+void InputReplay::Rewind() {
+    m_cursor = sizeof(FileHeader);
+    m_cursorFrame = 0;
+}
+
+const IndexEntry* InputReplay::FindIndex(Uint32 frame, Uint64 timestampNS, bool byTime) const {
+    if (!m_pIndex || m_indexCount == 0) return nullptr;
+
+    // framei܂͎jȉōŌ̃Gg
+    const IndexEntry* pEnd = m_pIndex + m_indexCount;
+    const IndexEntry* pFound = byTime
+        ? std::upper_bound(m_pIndex, pEnd, timestampNS,
+            [](Uint64 t, const IndexEntry& e) { return t < e.timestampNS; })
+        : std::upper_bound(m_pIndex, pEnd, frame,
+            [](Uint32 f, const IndexEntry& e) { return f < e.frame; });
+    return (pFound == m_pIndex) ? nullptr : pFound - 1;
+}
+
+bool InputReplay::SeekToFrame(Uint32 frame) {
+    if (!m_pData || frame >= m_frameCount) return false;
+
+    const IndexEntry* pEntry = FindIndex(frame, 0, false);
+    if (pEntry) {
+        m_cursor = static_cast<size_t>(pEntry->offset);
+        m_cursorFrame = pEntry->frame;
+    } else if (frame < m_cursorFrame) {
+        Rewind();
+    }
+
+    // CfbNXԂ͏ɓǂݔ΂
+    size_t next = 0;
+    while (m_cursorFrame < frame && ParseRecord(m_cursor, nullptr, &next)) {
+        m_cursor = next;
+        m_cursorFrame++;
+    }
+    return m_cursorFrame == frame;
+}
+
+bool InputReplay::SeekToTime(Uint64 timestampNS) {
+    if (!m_pData || m_frameCount == 0) return false;
+
+    const IndexEntry* pEntry = FindIndex(0, timestampNS, true);
+    if (pEntry) {
+        m_cursor = static_cast<size_t>(pEntry->offset);
+        m_cursorFrame = pEntry->frame;
+    } else {
+        Rewind();
+    }
+
+    // timestampNS ȑOōŌ̃t[
+    RecordedFrame frame;
+    size_t next = 0;
+    size_t cursor = m_cursor;
+    while (ParseRecord(cursor, &frame, &next) && frame.timestampNS <= timestampNS) {
+        m_cursor = cursor;
+        m_cursorFrame = frame.frame;
+        cursor = next;
+    }
+    return true;
+}
+
+//==============================================================================
+// vCFǂݍ
+//==============================================================================
+bool InputReplay::ReadNext(RecordedFrame* pOut) {
+    size_t next = 0;
+    if (!ParseRecord(m_cursor, pOut, &next)) return false;
+
+    m_cursor = next;
+    m_cursorFrame++;
+    return true;
+}
+
+bool InputReplay::ParseRecord(size_t offset, RecordedFrame* pOut, size_t* pNext) const {
+    if (!m_pData || offset + RECORD_HEADER_SIZE > m_recordsEnd) return false;
+
+    const Uint8* p = m_pData + offset;
+    Uint64 timestampNS = Get<Uint64>(p);
+    Uint32 frame = Get<Uint32>(p);
+    Uint16 flags = Get<Uint16>(p);
+    Uint16 size = Get<Uint16>(p);
+
+    size_t expected = RECORD_HEADER_SIZE + STATE_BLOCK_SIZE;
+    if (flags & FLAG_SENSOR) expected += SENSOR_BLOCK_SIZE;
+    if (flags & FLAG_TOUCHPAD) expected += (m_version >= 2) ? TOUCHPAD_BLOCK_SIZE : TOUCHPAD_BLOCK_SIZE_V1;
+    if (size != expected || offset + size > m_recordsEnd) return false;
+
+    *pNext = offset + size;
+    if (!pOut) return true;
+
+    *pOut = {};
+    pOut->timestampNS = timestampNS;
+    pOut->frame = frame;
+
+    GamepadState& state = pOut->state;
+    state.leftStickX = Get<float>(p);
+    state.leftStickY = Get<float>(p);
+    state.rightStickX = Get<float>(p);
+    state.rightStickY = Get<float>(p);
+    state.leftTrigger = Get<float>(p);
+    state.rightTrigger = Get<float>(p);
+    state.buttons = Get<Uint32>(p);
+    state.triggered = Get<Uint32>(p);
+    state.released = Get<Uint32>(p);
+    state.held = Get<Uint32>(p);
+    state.connected = (flags & FLAG_CONNECTED) != 0;
+
+    if (flags & FLAG_SENSOR) {
+        SensorData& sensor = pOut->sensor;
+        sensor.gyroX = Get<float>(p);
+        sensor.gyroY = Get<float>(p);
+        sensor.gyroZ = Get<float>(p);
+        sensor.accelX = Get<float>(p);
+        sensor.accelY = Get<float>(p);
+        sensor.accelZ = Get<float>(p);
+        sensor.hasGyro = Get<Uint8>(p) != 0;
+        sensor.hasAccel = Get<Uint8>(p) != 0;
+        p += 2;
+        pOut->hasSensor = true;
+    }
+
+    if (flags & FLAG_TOUCHPAD) {
+        TouchpadData& touchpad = pOut->touchpad;
+        touchpad.hasTouchpad = Get<Uint8>(p) != 0;
+        touchpad.numTouchpads = Get<Uint8>(p);
+        p += 2;
+        if (m_version >= 2) {
+            for (int pad = 0; pad < TouchpadData::MAX_TOUCHPADS; pad++) {
+                for (int i = 0; i < TouchpadData::MAX_FINGERS; i++) {
+                    TouchpadData::Finger& finger = touchpad.fingers[pad][i];
+                    finger.down = Get<Uint8>(p) != 0;
+                    p += 3;
+                    finger.x = Get<float>(p);
+                    finger.y = Get<float>(p);
+                    finger.pressure = Get<float>(p);
+                    finger.timestampNS = timestampNS;
+                }
+            }
+        } else {
+            // o[W 1 ̓^b`pbh 0 ̎w 2 {̂݁i͂Ȃj
+            for (int i = 0; i < 2; i++) {
+                TouchpadData::Finger& finger = touchpad.fingers[0][i];
+                finger.down = Get<Uint8>(p) != 0;
+                p += 3;
+                finger.x = Get<float>(p);
+                finger.y = Get<float>(p);
+                finger.timestampNS = timestampNS;
+            }
+        }
+        pOut->hasTouchpad = true;
+    }
+
+    return true;
+}
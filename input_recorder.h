@@ -0,0 +1,143 @@
+/*********************************************************************
+ * \file   input_recorder.h
+ * \brief  ͂̋L^ƍĐio[WtoCi` / mmap ǂݍ݁j
+ *********************************************************************/
+#pragma once
+#include "controller_types.h"
+#include <vector>
+
+//==============================================================================
+// t@C`igGfBAj
+//------------------------------------------------------------------------------
+//  FileHeader
+//  t[R[h ~ Niϒ: RecordHeader +  [+ ZT[] [+ ^b`pbh]j
+//  CfbNXi8 oCgEAINDEX_INTERVAL t[Ƃ { frame, timestampNS, offset }j
+//  FileFooter
+// tb^[iL^ɗjt@C擪珇ɓǂ߂B
+//==============================================================================
+namespace InputRecordFormat {
+    constexpr Uint32 MAGIC = 0x52494347;         // "GCIR"
+    constexpr Uint32 FOOTER_MAGIC = 0x58494347;  // "GCIX"
+    constexpr Uint32 VERSION = 2;           // 2: ^b`pbhubNS^b`pbhESw + ͂Ɋg
+    constexpr Uint32 MIN_READ_VERSION = 1;  // ǂݍ݂͂ VERSION ܂
+    constexpr Uint32 INDEX_INTERVAL = 64;
+
+    // R[hɊ܂܂ubN
+    constexpr Uint16 FLAG_CONNECTED = 1u << 0;
+    constexpr Uint16 FLAG_SENSOR = 1u << 1;
+    constexpr Uint16 FLAG_TOUCHPAD = 1u << 2;
+
+    struct FileHeader {
+        Uint32 magic;
+        Uint32 version;
+        Uint64 startTimeNS;
+    };
+
+    struct IndexEntry {
+        Uint32 frame;
+        Uint32 reserved;
+        Uint64 timestampNS;
+        Uint64 offset;
+    };
+
+    struct FileFooter {
+        Uint64 recordsEnd;
+        Uint64 indexOffset;
+        Uint32 indexCount;
+        Uint32 frameCount;
+        Uint32 magic;
+        Uint32 reserved;
+    };
+}
+
+//==============================================================================
+// L^ς݃t[
+//==============================================================================
+struct RecordedFrame {
+    Uint64 timestampNS = 0;
+    Uint32 frame = 0;
+    GamepadState state;
+    SensorData sensor;
+    TouchpadData touchpad;
+    bool hasSensor = false;
+    bool hasTouchpad = false;
+};
+
+//==============================================================================
+// ̓R[_[
+//==============================================================================
+class InputRecorder {
+public:
+    InputRecorder() = default;
+    ~InputRecorder() { Close(); }
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    bool Open(const char* pPath);
+    void Close();
+    bool IsOpen() const { return m_pStream != nullptr; }
+
+    // 1 t[ǋLiZT[E^b`pbh͕svȂ nullptrjB
+    // ݂ɎsA܂ł̃t[cĈȍ~͋L^Ȃifalsej
+    bool RecordFrame(const GamepadState& state, const SensorData* pSensor, const TouchpadData* pTouchpad);
+
+    // GameController ̌݃t[ǋL
+    bool RecordCurrentFrame();
+
+    Uint32 GetFrameCount() const { return m_frameCount; }
+    bool HasFailed() const { return m_failed; }
+
+private:
+    SDL_IOStream* m_pStream = nullptr;
+    Uint64 m_offset = 0;
+    Uint32 m_frameCount = 0;
+    bool m_failed = false;
+    std::vector<InputRecordFormat::IndexEntry> m_index;
+};
+
+//==============================================================================
+// ̓vCit@C}bvēǂށj
+//==============================================================================
+class InputReplay {
+public:
+    InputReplay() = default;
+    ~InputReplay() { Close(); }
+    InputReplay(const InputReplay&) = delete;
+    InputReplay& operator=(const InputReplay&) = delete;
+
+    bool Open(const char* pPath);
+    void Close();
+    bool IsOpen() const { return m_pData != nullptr; }
+
+    // V[NiCfbNX񕪒TĂő INDEX_INTERVAL ǂݔ΂j
+    bool SeekToFrame(Uint32 frame);
+    bool SeekToTime(Uint64 timestampNS);
+    void Rewind();
+
+    // ݈ʒũt[ǂŎ֐i
+    bool ReadNext(RecordedFrame* pOut);
+
+    Uint32 GetFrameCount() const { return m_frameCount; }
+    Uint32 GetPosition() const { return m_cursorFrame; }
+    bool IsEnd() const { return m_cursor >= m_recordsEnd; }
+    Uint64 GetStartTimeNS() const { return m_startTimeNS; }
+
+private:
+    bool ParseRecord(size_t offset, RecordedFrame* pOut, size_t* pNext) const;
+    const InputRecordFormat::IndexEntry* FindIndex(Uint32 frame, Uint64 timestampNS, bool byTime) const;
+
+    const Uint8* m_pData = nullptr;
+    size_t m_size = 0;
+    void* m_hFile = nullptr;
+    void* m_hMapping = nullptr;
+
+    const InputRecordFormat::IndexEntry* m_pIndex = nullptr;
+    Uint32 m_indexCount = 0;
+    Uint32 m_frameCount = 0;
+    Uint32 m_version = 0;
+    Uint64 m_startTimeNS = 0;
+
+    size_t m_recordsEnd = 0;
+    size_t m_cursor = 0;
+    Uint32 m_cursorFrame = 0;
+};
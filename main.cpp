@@ -8,6 +8,13 @@
 #include <windows.h>
 #include "game_controller.h"
 
+namespace {
+    // ͂Ԃ̑҂ԁiL[͂̊mFԊu˂j
+    constexpr Uint64 IDLE_WAIT_NS = 100 * SDL_NS_PER_MS;
+    // ĕ`̍ŒZԊu
+    constexpr Uint64 FRAME_INTERVAL_NS = 16 * SDL_NS_PER_MS;
+}
+
 void ClearScreen() {
     COORD coord = { 0, 0 };
     SetConsoleCursorPosition(GetStdHandle(STD_OUTPUT_HANDLE), coord);
@@ -84,6 +91,8 @@ int main() {
     bool isRunning = true;
 
     while (isRunning) {
+        Uint64 frameStartNS = SDL_GetTicksNS();
+
         if (_kbhit()) {
             int key = _getch();
             switch (key) {
@@ -113,7 +122,7 @@ int main() {
             for (int i = 0; i < 13; i++) PrintLine("");
             PrintLine("-------------------------------------------------------------------------------");
             PrintLine(" ESC: Exit");
-            Sleep(100);
+            GameController::WaitForInput(frameStartNS + IDLE_WAIT_NS);
             continue;
         }
 
@@ -128,26 +137,26 @@ int main() {
         GetTriggerBar(barLT, state.leftTrigger);
         GetTriggerBar(barRT, state.rightTrigger);
 
-        const char* pDU = state.dpadUp ? "[U]" : " U ";
-        const char* pDD = state.dpadDown ? "[D]" : " D ";
-        const char* pDL = state.dpadLeft ? "[L]" : " L ";
-        const char* pDR = state.dpadRight ? "[R]" : " R ";
+        const char* pDU = state.IsPressed(BUTTON_MASK_DPAD_UP) ? "[U]" : " U ";
+        const char* pDD = state.IsPressed(BUTTON_MASK_DPAD_DOWN) ? "[D]" : " D ";
+        const char* pDL = state.IsPressed(BUTTON_MASK_DPAD_LEFT) ? "[L]" : " L ";
+        const char* pDR = state.IsPressed(BUTTON_MASK_DPAD_RIGHT) ? "[R]" : " R ";
 
-        const char* pBU = state.buttonUp ? "[^]" : " ^ ";
-        const char* pBD = state.buttonDown ? "[v]" : " v ";
-        const char* pBL = state.buttonLeft ? "[<]" : " < ";
-        const char* pBR = state.buttonRight ? "[>]" : " > ";
+        const char* pBU = state.IsPressed(BUTTON_MASK_UP) ? "[^]" : " ^ ";
+        const char* pBD = state.IsPressed(BUTTON_MASK_DOWN) ? "[v]" : " v ";
+        const char* pBL = state.IsPressed(BUTTON_MASK_LEFT) ? "[<]" : " < ";
+        const char* pBR = state.IsPressed(BUTTON_MASK_RIGHT) ? "[>]" : " > ";
 
-        const char* pL1 = state.buttonL1 ? "[L1]" : " L1 ";
-        const char* pR1 = state.buttonR1 ? "[R1]" : " R1 ";
-        const char* pL2 = state.buttonL2 ? "[L2]" : " L2 ";
-        const char* pR2 = state.buttonR2 ? "[R2]" : " R2 ";
-        const char* pL3 = state.buttonL3 ? "[L3]" : " L3 ";
-        const char* pR3 = state.buttonR3 ? "[R3]" : " R3 ";
+        const char* pL1 = state.IsPressed(BUTTON_MASK_L1) ? "[L1]" : " L1 ";
+        const char* pR1 = state.IsPressed(BUTTON_MASK_R1) ? "[R1]" : " R1 ";
+        const char* pL2 = state.IsPressed(BUTTON_MASK_L2) ? "[L2]" : " L2 ";
+        const char* pR2 = state.IsPressed(BUTTON_MASK_R2) ? "[R2]" : " R2 ";
+        const char* pL3 = state.IsPressed(BUTTON_MASK_L3) ? "[L3]" : " L3 ";
+        const char* pR3 = state.IsPressed(BUTTON_MASK_R3) ? "[R3]" : " R3 ";
 
-        const char* pSel = state.buttonSelect ? "[SEL]" : " SEL ";
-        const char* pSta = state.buttonStart ? "[STA]" : " STA ";
-        const char* pGui = state.buttonGuide ? "[GUI]" : " GUI ";
+        const char* pSel = state.IsPressed(BUTTON_MASK_SELECT) ? "[SEL]" : " SEL ";
+        const char* pSta = state.IsPressed(BUTTON_MASK_START) ? "[STA]" : " STA ";
+        const char* pGui = state.IsPressed(BUTTON_MASK_GUIDE) ? "[GUI]" : " GUI ";
 
         const char* pVibe = GameController::IsVibrating() ? "[VIBE]" : "      ";
 
@@ -229,8 +238,8 @@ int main() {
         if (GameController::HasTouchpad()) {
             TouchpadData t = GameController::GetTouchpadData();
             sprintf_s(line, sizeof(line), " Touch: [%c]%.2f,%.2f  [%c]%.2f,%.2f",
-                t.fingers[0].down ? '*' : ' ', t.fingers[0].x, t.fingers[0].y,
-                t.fingers[1].down ? '*' : ' ', t.fingers[1].x, t.fingers[1].y);
+                t.fingers[0][0].down ? '*' : ' ', t.fingers[0][0].x, t.fingers[0][0].y,
+                t.fingers[0][1].down ? '*' : ' ', t.fingers[0][1].x, t.fingers[0][1].y);
         } else {
             sprintf_s(line, sizeof(line), " Touch: N/A");
         }
@@ -239,7 +248,16 @@ int main() {
         PrintLine("===============================================================================");
         PrintLine(" ESC:Exit V/B:Vibe T:Trigger R/G/L/W:LED(Red/Green/bLue/White)");
 
-        Sleep(16);
+        // ͂͂܂ő҂iÛ͍ߖt[񂷁jB
+        // ē͂Cxg܂Ƃ߂邽߁A`̊Ԋu FRAME_INTERVAL_NS 󂯂
+        Uint64 frameEndNS = frameStartNS + FRAME_INTERVAL_NS;
+        if (GameController::IsVibrating() ||
+            GameController::WaitForInput(frameStartNS + IDLE_WAIT_NS)) {
+            Uint64 nowNS = SDL_GetTicksNS();
+            if (nowNS < frameEndNS) {
+                SDL_DelayNS(frameEndNS - nowNS);
+            }
+        }
     }
 
     GameController::Finalize();
@@ -0,0 +1,436 @@
+/*********************************************************************
+ * \file   main_posix.cpp
+ * \brief  Rg[[̓fobOpiLinux / ANSI [ŁASpbh\j
+ *********************************************************************/
+#include <cerrno>
+#include <csignal>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+#include "gamepad_manager.h"
+
+//==============================================================================
+// 萔`
+//==============================================================================
+namespace {
+    constexpr int MAX_COLS = 160;
+    constexpr int MAX_ROWS = 100;
+    constexpr int SCREEN_COLS = 80;
+    constexpr int ROWS_PER_PAD = 5;
+
+    // ͂Ԃ̑҂ԁiL[͂̊mFԊu˂j
+    constexpr Sint32 IDLE_WAIT_MS = 100;
+    // ĕ`̍ŒZԊu
+    constexpr Uint64 FRAME_INTERVAL_NS = 16 * SDL_NS_PER_MS;
+    // U Update() 񂵑鎞
+    constexpr Uint64 HAPTIC_ACTIVE_NS = 1000 * SDL_NS_PER_MS;
+
+    // ESC ̌ɑ͂̂҂ԁi͂΃GXP[vV[PXƂēǂݎ̂Ăj
+    constexpr int ESCAPE_WAIT_MS = 30;
+    constexpr int MAX_ESCAPE_LENGTH = 16;
+    // o͐悪߂悤ɂȂ̂҂ԁiubLO̒[j
+    constexpr int WRITE_WAIT_MS = 100;
+
+    constexpr int KEY_NONE = -1;        // ǂ߂L[
+    constexpr int KEY_IGNORED = 0;      // ǂݎ̂ĂGXP[vV[PX
+    constexpr int KEY_ESCAPE = 27;
+}
+
+//==============================================================================
+// [̓o
+//==============================================================================
+namespace {
+    // ׂďI܂ŌJԂiVOiɂ钆f͂蒼j
+    bool WriteAll(const char* pData, size_t length) {
+        while (length > 0) {
+            ssize_t written = write(STDOUT_FILENO, pData, length);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    pollfd fd = { STDOUT_FILENO, POLLOUT, 0 };
+                    if (poll(&fd, 1, WRITE_WAIT_MS) > 0) continue;
+                }
+                return false;
+            }
+            pData += written;
+            length -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+    bool WriteAll(const char* pText) {
+        return WriteAll(pText, strlen(pText));
+    }
+
+    bool HasPendingInput(int waitMS) {
+        pollfd fd = { STDIN_FILENO, POLLIN, 0 };
+        return poll(&fd, 1, waitMS) > 0;
+    }
+
+    int ReadByte() {
+        unsigned char c;
+        return (read(STDIN_FILENO, &c, 1) == 1) ? c : KEY_NONE;
+    }
+
+    // ̃L[iESC PƂ̂Ƃ KEY_ESCAPEBL[Ȃǂ KEY_IGNOREDj
+    int ReadKey() {
+        int c = ReadByte();
+        if (c != KEY_ESCAPE) return c;
+        if (!HasPendingInput(ESCAPE_WAIT_MS)) return KEY_ESCAPE;
+
+        // CSIiESC [j SS3iESC Oj͏I[i0x40 ` 0x7Ej܂ŁA
+        // ȊO Alt + L[Ƃ 1 ǂݎ̂Ă
+        int next = ReadByte();
+        if (next == '[' || next == 'O') {
+            for (int i = 0; i < MAX_ESCAPE_LENGTH; i++) {
+                int b = HasPendingInput(ESCAPE_WAIT_MS) ? ReadByte() : KEY_NONE;
+                if (b == KEY_NONE || (b >= 0x40 && b <= 0x7E)) break;
+            }
+        }
+        return KEY_IGNORED;
+    }
+}
+
+//==============================================================================
+// [ʁiZobt@AωZ܂Ƃ߂ďo͂j
+//==============================================================================
+class TerminalScreen {
+public:
+    bool Open();
+    void Close();
+
+    // [TCY̕ύX𔽉fi Present() őŜj
+    void Resize();
+
+    void Clear();
+    void Print(int row, const char* pFormat, ...);
+    void Present();
+
+    int GetRows() const { return m_rows; }
+
+private:
+    void Append(const char* pText, size_t length);
+
+    char m_front[MAX_ROWS][MAX_COLS] = {};
+    char m_back[MAX_ROWS][MAX_COLS] = {};
+    int m_rows = 25;
+    int m_cols = SCREEN_COLS;
+
+    char m_output[MAX_ROWS * MAX_COLS * 8] = {};
+    size_t m_outputLength = 0;
+
+    termios m_savedTermios = {};
+    bool m_isOpen = false;
+};
+
+bool TerminalScreen::Open() {
+    if (tcgetattr(STDIN_FILENO, &m_savedTermios) != 0) return false;
+
+    // JmjJEGR[Eǂݍ݂̓ubNȂ
+    termios raw = m_savedTermios;
+    raw.c_lflag &= ~(ICANON | ECHO);
+    raw.c_cc[VMIN] = 0;
+    raw.c_cc[VTIME] = 0;
+    tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+
+    // ։ʂɐ؂ւăJ[\B
+    if (!WriteAll("\x1b[?1049h\x1b[?25l\x1b[2J")) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &m_savedTermios);
+        return false;
+    }
+
+    m_isOpen = true;
+    Resize();
+    return true;
+}
+
+void TerminalScreen::Close() {
+    if (!m_isOpen) return;
+
+    WriteAll("\x1b[0m\x1b[?25h\x1b[?1049l");
+    tcsetattr(STDIN_FILENO, TCSANOW, &m_savedTermios);
+    m_isOpen = false;
+}
+
+void TerminalScreen::Resize() {
+    winsize size = {};
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0) {
+        m_rows = (size.ws_row < MAX_ROWS) ? size.ws_row : MAX_ROWS;
+        m_cols = (size.ws_col < MAX_COLS) ? size.ws_col : MAX_COLS;
+    }
+
+    // O̓e𖳌ɂđSZ
+    memset(m_front, 0, sizeof(m_front));
+    WriteAll("\x1b[2J");
+}
+
+void TerminalScreen::Clear() {
+    memset(m_back, ' ', sizeof(m_back));
+}
+
+void TerminalScreen::Print(int row, const char* pFormat, ...) {
+    if (row < 0 || row >= m_rows) return;
+
+    char line[MAX_COLS + 1];
+    va_list args;
+    va_start(args, pFormat);
+    int length = vsnprintf(line, sizeof(line), pFormat, args);
+    va_end(args);
+    if (length < 0) return;
+    if (length > m_cols) length = m_cols;
+
+    memcpy(m_back[row], line, length);
+}
+
+void TerminalScreen::Append(const char* pText, size_t length) {
+    if (m_outputLength + length > sizeof(m_output)) return;
+    memcpy(m_output + m_outputLength, pText, length);
+    m_outputLength += length;
+}
+
+void TerminalScreen::Present() {
+    m_outputLength = 0;
+
+    for (int row = 0; row < m_rows; row++) {
+        int cursorCol = -1;
+        for (int col = 0; col < m_cols; col++) {
+            char c = m_back[row][col];
+            if (c == m_front[row][col]) continue;
+
+            // AĕωZ̓J[\ړȂ
+            if (col != cursorCol) {
+                char move[16];
+                int length = snprintf(move, sizeof(move), "\x1b[%d;%dH", row + 1, col + 1);
+                Append(move, length);
+            }
+            Append(&c, 1);
+            m_front[row][col] = c;
+            cursorCol = col + 1;
+        }
+    }
+
+    // ߂ȂΉʂ̓eȂȂ̂ŁA͑SZ
+    if (m_outputLength > 0 && !WriteAll(m_output, m_outputLength)) {
+        memset(m_front, 0, sizeof(m_front));
+    }
+}
+
+//==============================================================================
+// \pwp[
+//==============================================================================
+namespace {
+    volatile sig_atomic_t s_quitRequested = 0;
+    volatile sig_atomic_t s_resizeRequested = 0;
+
+    void OnSignal(int signal) {
+        if (signal == SIGWINCH) {
+            s_resizeRequested = 1;
+        } else {
+            s_quitRequested = 1;
+        }
+    }
+
+    void GetStickBar(char* pBuf, float value) {
+        int pos = static_cast<int>((value + 1.0f) * 6.0f);
+        if (pos < 0) pos = 0;
+        if (pos > 12) pos = 12;
+        pBuf[0] = '[';
+        for (int i = 0; i < 13; i++) {
+            if (i == 6) pBuf[i + 1] = '|';
+            else if (i == pos) pBuf[i + 1] = '*';
+            else pBuf[i + 1] = '-';
+        }
+        pBuf[14] = ']';
+        pBuf[15] = '\0';
+    }
+
+    void GetTriggerBar(char* pBuf, float value) {
+        int filled = static_cast<int>(value * 10);
+        pBuf[0] = '[';
+        for (int i = 0; i < 10; i++) {
+            pBuf[i + 1] = (i < filled) ? '=' : ' ';
+        }
+        pBuf[11] = ']';
+        pBuf[12] = '\0';
+    }
+
+    // Ă [O]AĂ O 󔒂ň͂
+    void AppendButton(char* pBuf, size_t size, uint32_t buttons, uint32_t mask, const char* pName) {
+        size_t length = strlen(pBuf);
+        snprintf(pBuf + length, size - length, (buttons & mask) ? "[%s]" : " %s ", pName);
+    }
+
+    const char* GetTypeString(SDL_Gamepad* pGamepad) {
+        const char* pType = SDL_GetGamepadStringForType(SDL_GetGamepadType(pGamepad));
+        return pType ? pType : "unknown";
+    }
+
+    // 1 pbhiROWS_PER_PAD sj
+    void DrawPad(TerminalScreen& screen, int row, int slot) {
+        GamepadState state = GamepadManager::GetState(slot);
+        char barX[16], barY[16], barT[16];
+
+        screen.Print(row, " P%-2d %-44.44s [%s]",
+            slot + 1, GamepadManager::GetControllerName(slot), GetTypeString(GamepadManager::GetGamepad(slot)));
+
+        GetStickBar(barX, state.leftStickX);
+        GetStickBar(barY, state.leftStickY);
+        GetTriggerBar(barT, state.leftTrigger);
+        screen.Print(row + 1, "   L X:%5.2f %s Y:%5.2f %s  LT:%4.2f %s",
+            state.leftStickX, barX, state.leftStickY, barY, state.leftTrigger, barT);
+
+        GetStickBar(barX, state.rightStickX);
+        GetStickBar(barY, state.rightStickY);
+        GetTriggerBar(barT, state.rightTrigger);
+        screen.Print(row + 2, "   R X:%5.2f %s Y:%5.2f %s  RT:%4.2f %s",
+            state.rightStickX, barX, state.rightStickY, barY, state.rightTrigger, barT);
+
+        char buttons[96] = "  ";
+        AppendButton(buttons, sizeof(buttons), state.buttons, BUTTON_MASK_DPAD_UP, "U");
+        AppendButton(buttons, sizeof(buttons), state.buttons, BUTTON_MASK_DPAD_DOWN, "D");
+        AppendButton(buttons, sizeof(buttons), state.buttons, BUTTON_MASK_DPAD_LEFT, "L");
+        AppendButton(buttons, sizeof(buttons), state.buttons, BUTTON_MASK_DPAD_RIGHT, "R");
+        AppendButton(buttons, sizeof(buttons), state.buttons, BUTTON_MASK_UP, "^");
+        AppendButton(buttons, sizeof(buttons), state.buttons, BUTTON_MASK_DOWN, "v");
+        AppendButton(buttons, sizeof(buttons), state.buttons, BUTTON_MASK_LEFT, "<");
+        AppendButton(buttons, sizeof(buttons), state.buttons, BUTTON_MASK_RIGHT, ">");
+        AppendButton(buttons, sizeof(buttons), state.buttons, BUTTON_MASK_L1, "L1");
+        AppendButton(buttons, sizeof(buttons), state.buttons, BUTTON_MASK_R1, "R1");
+        AppendButton(buttons, sizeof(buttons), state.buttons, BUTTON_MASK_L2, "L2");
+        AppendButton(buttons, sizeof(buttons), state.buttons, BUTTON_MASK_R2, "R2");
+        AppendButton(buttons, sizeof(buttons), state.buttons, BUTTON_MASK_L3, "L3");
+        AppendButton(buttons, sizeof(buttons), state.buttons, BUTTON_MASK_R3, "R3");
+        AppendButton(buttons, sizeof(buttons), state.buttons, BUTTON_MASK_SELECT, "SEL");
+        AppendButton(buttons, sizeof(buttons), state.buttons, BUTTON_MASK_GUIDE, "GUI");
+        AppendButton(buttons, sizeof(buttons), state.buttons, BUTTON_MASK_START, "STA");
+        AppendButton(buttons, sizeof(buttons), state.buttons, BUTTON_MASK_MISC, "MSC");
+        screen.Print(row + 3, "%s", buttons);
+    }
+
+    void Draw(TerminalScreen& screen) {
+        screen.Clear();
+        screen.Print(0, "===============================================================================");
+        screen.Print(1, "                    SDL3 CONTROLLER DEBUG MONITOR (%d connected)",
+            GamepadManager::GetConnectedCount());
+        screen.Print(2, "===============================================================================");
+
+        int row = 3;
+        int footer = screen.GetRows() - 2;
+        if (GamepadManager::GetConnectedCount() == 0) {
+            screen.Print(row + 1, " Controller not connected...");
+            screen.Print(row + 3, " Supported: Xbox, PlayStation, Switch Pro, Joy-Con, etc.");
+        }
+        for (int slot = 0; slot < GamepadManager::MAX_SLOTS; slot++) {
+            if (!GamepadManager::IsConnected(slot)) continue;
+            if (row + ROWS_PER_PAD > footer) {
+                screen.Print(row, " ... (enlarge the terminal to show more pads)");
+                break;
+            }
+            DrawPad(screen, row, slot);
+            screen.Print(row + ROWS_PER_PAD - 1, "-------------------------------------------------------------------------------");
+            row += ROWS_PER_PAD;
+        }
+
+        screen.Print(footer, "===============================================================================");
+        screen.Print(footer + 1, " Q/ESC:Exit V/B:Vibe T:Trigger R/G/L/W:LED(Red/Green/bLue/White)");
+    }
+
+    void ForEachSlot(void (*pFunc)(int slot)) {
+        for (int slot = 0; slot < GamepadManager::MAX_SLOTS; slot++) {
+            if (GamepadManager::IsConnected(slot)) pFunc(slot);
+        }
+    }
+
+    // L[́i߂l false ŏIj
+    bool HandleKey(int key, Uint64* pHapticUntilNS) {
+        Uint64 nowNS = SDL_GetTicksNS();
+        switch (key) {
+        case KEY_ESCAPE: case 'q': case 'Q':
+            return false;
+        case 'v': case 'V':
+            ForEachSlot([](int slot) { GamepadManager::PlayHapticEffect(slot, HapticEffect::Rumble(1.0f, 1.0f, 0.5f)); });
+            *pHapticUntilNS = nowNS + HAPTIC_ACTIVE_NS;
+            break;
+        case 'b': case 'B':
+            ForEachSlot([](int slot) { GamepadManager::PlayHapticEffect(slot, HapticEffect::Rumble(0.3f, 0.3f, 0.3f)); });
+            *pHapticUntilNS = nowNS + HAPTIC_ACTIVE_NS;
+            break;
+        case 't': case 'T':
+            ForEachSlot([](int slot) { GamepadManager::PlayHapticEffect(slot, HapticEffect::Trigger(0.5f, 0.5f, 0.3f)); });
+            *pHapticUntilNS = nowNS + HAPTIC_ACTIVE_NS;
+            break;
+        case 'r': case 'R': ForEachSlot([](int slot) { GamepadManager::SetLED(slot, 255, 0, 0); }); break;
+        case 'g': case 'G': ForEachSlot([](int slot) { GamepadManager::SetLED(slot, 0, 255, 0); }); break;
+        case 'l': case 'L': ForEachSlot([](int slot) { GamepadManager::SetLED(slot, 0, 0, 255); }); break;
+        case 'w': case 'W': ForEachSlot([](int slot) { GamepadManager::SetLED(slot, 255, 255, 255); }); break;
+        }
+        return true;
+    }
+}
+
+//==============================================================================
+// C
+//------------------------------------------------------------------------------
+// Œ莞Ԃ Sleep ͎g킸 SDL_WaitEventTimeout ő҂B͂Ԃ
+// IDLE_WAIT_MS ƂɃL[͂mF邾ŁAʂȂB
+//==============================================================================
+int main() {
+    if (!GamepadManager::Initialize()) {
+        fprintf(stderr, "SDL_Init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    TerminalScreen screen;
+    if (!screen.Open()) {
+        fprintf(stderr, "cannot open the terminal\n");
+        GamepadManager::Finalize();
+        return 1;
+    }
+
+    signal(SIGINT, OnSignal);
+    signal(SIGTERM, OnSignal);
+    signal(SIGWINCH, OnSignal);
+
+    Uint64 lastFrameNS = 0;
+    Uint64 hapticUntilNS = 0;
+    bool isRunning = true;
+
+    while (isRunning && !s_quitRequested) {
+        // Û͍߂ɈԊuŉ񂵁AȊO̓Cxg܂ŐQ
+        Uint64 nowNS = SDL_GetTicksNS();
+        Sint32 waitMS = (hapticUntilNS > nowNS) ? static_cast<Sint32>(FRAME_INTERVAL_NS / SDL_NS_PER_MS) : IDLE_WAIT_MS;
+
+        SDL_Event event;
+        if (SDL_WaitEventTimeout(&event, waitMS)) {
+            GamepadManager::ProcessEvent(event);
+
+            // ē͂Cxg܂Ƃ߂邽߁AO̕`悩 FRAME_INTERVAL_NS ͑҂
+            nowNS = SDL_GetTicksNS();
+            if (nowNS - lastFrameNS < FRAME_INTERVAL_NS) {
+                SDL_DelayNS(FRAME_INTERVAL_NS - (nowNS - lastFrameNS));
+            }
+        }
+
+        for (int key = ReadKey(); key != KEY_NONE && isRunning; key = ReadKey()) {
+            isRunning = HandleKey(key, &hapticUntilNS);
+        }
+
+        if (s_resizeRequested) {
+            s_resizeRequested = 0;
+            screen.Resize();
+        }
+
+        GamepadManager::Update();
+        Draw(screen);
+        screen.Present();
+        lastFrameNS = SDL_GetTicksNS();
+    }
+
+    screen.Close();
+    GamepadManager::Finalize();
+    return 0;
+}
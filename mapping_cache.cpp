@@ -0,0 +1,270 @@
+/*********************************************************************
+ * \file   mapping_cache.cpp
+ * \brief  JX^Q[pbh}bsÕLbViNɃeLXg͂Ȃj
+ *********************************************************************/
+#include "mapping_cache.h"
+#include <cstring>
+
+using namespace MappingCacheFormat;
+
+//==============================================================================
+// eLXg̐
+//==============================================================================
+namespace {
+    constexpr int GUID_LENGTH = 32;
+
+    struct MappingLine {
+        const char* pText;
+        int length;
+        int order;      // ̍sԍi GUID ͌̍scj
+    };
+
+    // GUID A GUID ͌̏
+    int SDLCALL CompareLines(const void* pA, const void* pB) {
+        const MappingLine* a = static_cast<const MappingLine*>(pA);
+        const MappingLine* b = static_cast<const MappingLine*>(pB);
+        int result = SDL_strncasecmp(a->pText, b->pText, GUID_LENGTH);
+        if (result != 0) return result;
+        return a->order - b->order;
+    }
+
+    bool IsHexDigit(char c) {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+    }
+
+    // "GUID,O,}bsO..." ̌`ŁAplatform: Ό݂̃vbgtH[̂
+    bool IsUsableLine(const char* pLine, int length, const char* pPlatform) {
+        if (length <= GUID_LENGTH + 1 || pLine[GUID_LENGTH] != ',') return false;
+        for (int i = 0; i < GUID_LENGTH; i++) {
+            if (!IsHexDigit(pLine[i])) return false;
+        }
+
+        // ÔƂɃ}bsO 1 ȏ゠
+        const char* pName = pLine + GUID_LENGTH + 1;
+        const char* pEnd = pLine + length;
+        const char* pMapping = static_cast<const char*>(std::memchr(pName, ',', pEnd - pName));
+        if (!pMapping || pMapping + 1 >= pEnd) return false;
+
+        static const char PLATFORM_KEY[] = "platform:";
+        const int keyLength = sizeof(PLATFORM_KEY) - 1;
+        for (const char* p = pMapping + 1; p + keyLength <= pEnd; p++) {
+            if (p[-1] != ',' || SDL_strncmp(p, PLATFORM_KEY, keyLength) != 0) continue;
+
+            const char* pValue = p + keyLength;
+            const char* pValueEnd = static_cast<const char*>(std::memchr(pValue, ',', pEnd - pValue));
+            size_t valueLength = (pValueEnd ? pValueEnd : pEnd) - pValue;
+            return SDL_strlen(pPlatform) == valueLength && SDL_strncasecmp(pValue, pPlatform, valueLength) == 0;
+        }
+        return true;
+    }
+
+    // gs GUID ɉs؂ŕׂi߂l SDL_malloc ́j
+    char* CompileText(const char* pSource, size_t sourceSize, Uint32* pCount, Uint32* pTextSize) {
+        int lineCapacity = 1;
+        for (size_t i = 0; i < sourceSize; i++) {
+            if (pSource[i] == '\n') lineCapacity++;
+        }
+
+        MappingLine* pLines = static_cast<MappingLine*>(SDL_malloc(sizeof(MappingLine) * lineCapacity));
+        char* pText = static_cast<char*>(SDL_malloc(sourceSize + 1));
+        if (!pLines || !pText) {
+            SDL_free(pLines);
+            SDL_free(pText);
+            return nullptr;
+        }
+
+        const char* pPlatform = SDL_GetPlatform();
+        int lineCount = 0;
+        const char* pEnd = pSource + sourceSize;
+        for (const char* pLine = pSource; pLine < pEnd; ) {
+            const char* pNext = static_cast<const char*>(std::memchr(pLine, '\n', pEnd - pLine));
+            if (!pNext) pNext = pEnd;
+
+            // Ő󔒂 CR 
+            const char* pBegin = pLine;
+            const char* pLast = pNext;
+            while (pBegin < pLast && (*pBegin == ' ' || *pBegin == '\t')) pBegin++;
+            while (pLast > pBegin && (pLast[-1] == '\r' || pLast[-1] == ' ' || pLast[-1] == '\t')) pLast--;
+
+            int length = static_cast<int>(pLast - pBegin);
+            if (length > 0 && *pBegin != '#' && IsUsableLine(pBegin, length, pPlatform)) {
+                pLines[lineCount].pText = pBegin;
+                pLines[lineCount].length = length;
+                pLines[lineCount].order = lineCount;
+                lineCount++;
+            }
+            if (pNext == pEnd) break;
+            pLine = pNext + 1;
+        }
+
+        SDL_qsort(pLines, lineCount, sizeof(MappingLine), CompareLines);
+
+        Uint32 count = 0;
+        size_t textLength = 0;
+        for (int i = 0; i < lineCount; i++) {
+            //  GUID Ȃ̂̂c
+            if (i + 1 < lineCount && SDL_strncasecmp(pLines[i].pText, pLines[i + 1].pText, GUID_LENGTH) == 0) continue;
+
+            if (count > 0) pText[textLength++] = '\n';
+            std::memcpy(pText + textLength, pLines[i].pText, pLines[i].length);
+            textLength += pLines[i].length;
+            count++;
+        }
+        pText[textLength] = '\0';
+
+        SDL_free(pLines);
+        *pCount = count;
+        *pTextSize = static_cast<Uint32>(textLength + 1);
+        return pText;
+    }
+}
+
+//==============================================================================
+// LbVt@C
+//==============================================================================
+namespace {
+    // ̃eLXg΁ALbVŎg
+    bool IsCacheCurrent(const FileHeader& header, const char* pTextPath) {
+        SDL_PathInfo info;
+        if (!pTextPath || !SDL_GetPathInfo(pTextPath, &info)) return true;
+        return header.sourceSize == info.size && header.sourceModifyTime == info.modify_time;
+    }
+
+    // LbVȂ}bsO̕Ԃ
+    const char* ReadCache(const void* pData, size_t size, const char* pTextPath, Uint32* pCount, Uint32* pTextSize) {
+        if (!pData || size < sizeof(FileHeader)) return nullptr;
+
+        FileHeader header;
+        std::memcpy(&header, pData, sizeof(header));
+        if (header.magic != MAGIC || header.version != VERSION) return nullptr;
+        if (header.textSize == 0 || sizeof(FileHeader) + header.textSize != size) return nullptr;
+        if (SDL_strncmp(header.platform, SDL_GetPlatform(), PLATFORM_NAME_SIZE) != 0) return nullptr;
+        if (!IsCacheCurrent(header, pTextPath)) return nullptr;
+
+        const char* pText = static_cast<const char*>(pData) + sizeof(FileHeader);
+        if (pText[header.textSize - 1] != '\0') return nullptr;
+
+        *pCount = header.mappingCount;
+        *pTextSize = header.textSize;
+        return pText;
+    }
+
+    bool WriteCache(const char* pCachePath, const SDL_PathInfo& source, const char* pText, Uint32 count, Uint32 textSize) {
+        FileHeader header = {};
+        header.magic = MAGIC;
+        header.version = VERSION;
+        header.sourceSize = source.size;
+        header.sourceModifyTime = source.modify_time;
+        header.mappingCount = count;
+        header.textSize = textSize;
+        SDL_strlcpy(header.platform, SDL_GetPlatform(), PLATFORM_NAME_SIZE);
+
+        SDL_IOStream* pStream = SDL_IOFromFile(pCachePath, "wb");
+        if (!pStream) return false;
+
+        bool ok = SDL_WriteIO(pStream, &header, sizeof(header)) == sizeof(header) &&
+                  SDL_WriteIO(pStream, pText, textSize) == textSize;
+        ok = SDL_CloseIO(pStream) && ok;
+        if (!ok) {
+            SDL_RemovePath(pCachePath);
+        }
+        return ok;
+    }
+
+    // eLXgǂŃLbVɏiȂĂe͕Ԃj
+    char* BuildCache(const char* pTextPath, const char* pCachePath, Uint32* pCount, Uint32* pTextSize) {
+        SDL_PathInfo info;
+        if (!SDL_GetPathInfo(pTextPath, &info)) return nullptr;
+
+        size_t sourceSize = 0;
+        char* pSource = static_cast<char*>(SDL_LoadFile(pTextPath, &sourceSize));
+        if (!pSource) return nullptr;
+
+        char* pText = CompileText(pSource, sourceSize, pCount, pTextSize);
+        SDL_free(pSource);
+
+        if (pText && pCachePath) {
+            WriteCache(pCachePath, info, pText, *pCount, *pTextSize);
+        }
+        return pText;
+    }
+
+    // OȂqgɒuAN̗񋓂ƓɎ荞܂B
+    // ɂqgiϐ܂ށj͏Ɍ֎cA GUID ł͂D悷
+    void SetConfigHint(const char* pText, Uint32 textSize) {
+        const char* pCurrent = SDL_GetHint(SDL_HINT_GAMECONTROLLERCONFIG);
+        size_t textLength = textSize - 1;
+
+        // O Apply() ő̂͏ixĂłLтȂj
+        if (pCurrent && SDL_strncmp(pCurrent, pText, textLength) == 0 &&
+            (pCurrent[textLength] == '\0' || pCurrent[textLength] == '\n')) {
+            pCurrent += textLength;
+            if (*pCurrent == '\n') pCurrent++;
+        }
+        if (!pCurrent || !*pCurrent) {
+            SDL_SetHint(SDL_HINT_GAMECONTROLLERCONFIG, pText);
+            return;
+        }
+
+        size_t currentLength = SDL_strlen(pCurrent);
+        char* pCombined = static_cast<char*>(SDL_malloc(textLength + 1 + currentLength + 1));
+        if (!pCombined) return;
+        std::memcpy(pCombined, pText, textLength);
+        pCombined[textLength] = '\n';
+        std::memcpy(pCombined + textLength + 1, pCurrent, currentLength + 1);
+
+        // ϐŎw肳Ăƒʏ̗Dxł͒uȂ
+        if (!SDL_SetHint(SDL_HINT_GAMECONTROLLERCONFIG, pCombined)) {
+            SDL_SetHintWithPriority(SDL_HINT_GAMECONTROLLERCONFIG, pCombined, SDL_HINT_OVERRIDE);
+        }
+        SDL_free(pCombined);
+    }
+
+    // ͗񋓂ςł̂ŒǉƂēo^iJĂfoCX SDL ă}bvj
+    void Register(const char* pText, Uint32 textSize) {
+        if (!SDL_WasInit(SDL_INIT_GAMEPAD)) {
+            SetConfigHint(pText, textSize);
+            return;
+        }
+        SDL_AddGamepadMappingsFromIO(SDL_IOFromConstMem(pText, textSize - 1), true);
+    }
+}
+
+//==============================================================================
+// 쐬EKp
+//==============================================================================
+int MappingCache::Build(const char* pTextPath, const char* pCachePath) {
+    Uint32 count = 0;
+    Uint32 textSize = 0;
+    char* pText = BuildCache(pTextPath, nullptr, &count, &textSize);
+    if (!pText) return -1;
+
+    SDL_PathInfo info;
+    bool ok = SDL_GetPathInfo(pTextPath, &info) && WriteCache(pCachePath, info, pText, count, textSize);
+    SDL_free(pText);
+    return ok ? static_cast<int>(count) : -1;
+}
+
+int MappingCache::Apply(const char* pCachePath, const char* pTextPath) {
+    Uint32 count = 0;
+    Uint32 textSize = 0;
+
+    size_t size = 0;
+    void* pData = SDL_LoadFile(pCachePath, &size);
+    const char* pText = ReadCache(pData, size, pTextPath, &count, &textSize);
+
+    char* pBuilt = nullptr;
+    if (!pText && pTextPath) {
+        pBuilt = BuildCache(pTextPath, pCachePath, &count, &textSize);
+        pText = pBuilt;
+    }
+
+    if (pText && count > 0) {
+        Register(pText, textSize);
+    }
+
+    int result = pText ? static_cast<int>(count) : -1;
+    SDL_free(pBuilt);
+    SDL_free(pData);
+    return result;
+}
@@ -0,0 +1,50 @@
+/*********************************************************************
+ * \file   mapping_cache.h
+ * \brief  JX^Q[pbh}bsÕLbViNɃeLXg͂Ȃj
+ *********************************************************************/
+#pragma once
+#include <SDL3/SDL.h>
+
+//==============================================================================
+// LbVt@C`
+//------------------------------------------------------------------------------
+// FileHeader ̂ƂɁÃvbgtH[̃}bsO GUID 
+// s؂ŕׂiNUL I[jB GUID ͌̍sŏ㏑ς݁B
+// ̃eLXg̃TCYEXVoĂAςĂ蒼B
+//==============================================================================
+namespace MappingCacheFormat {
+    constexpr Uint32 MAGIC = 0x434D4347;    // "GCMC"
+    constexpr Uint32 VERSION = 1;
+    constexpr int PLATFORM_NAME_SIZE = 32;
+
+    struct FileHeader {
+        Uint32 magic;
+        Uint32 version;
+        Uint64 sourceSize;          // ̃eLXg̃TCY
+        Sint64 sourceModifyTime;    // ̃eLXg̍XViSDL_Timej
+        Uint32 mappingCount;
+        Uint32 textSize;            // NUL ܂
+        char platform[PLATFORM_NAME_SIZE];
+    };
+}
+
+//==============================================================================
+// }bsOLbVNX
+//------------------------------------------------------------------------------
+// gamecontrollerdb.txt `̃eLXgAvbgtH[̍sERgE
+// dEꂽŝĂAN͂ SDL ֓nɂB
+// SDL_INIT_GAMEPAD O Apply()  SDL_HINT_GAMECONTROLLERCONFIG ɒuA
+// ÑfoCX񋓂ƓɎ荞܂Bɂqg͎cA GUID ł
+// D悷B Apply()  SDL_AddGamepadMappingsFromIO Œǉ
+// i񋓂͍ςł̂ŁAJĂfoCXɂ SDL ă}bvʒmjB
+//==============================================================================
+class MappingCache {
+public:
+    // eLXgLbVi߂l̓}bsOA-1 Ŏsj
+    static int Build(const char* pTextPath, const char* pCachePath);
+
+    // LbV SDL ֓ni߂l̓}bsOA-1 ŎsjB
+    // pTextPath w肷ƁALbVÂƂɃeLXg蒼
+    // i߂ȂĂe͓nj
+    static int Apply(const char* pCachePath, const char* pTextPath = nullptr);
+};
@@ -0,0 +1,408 @@
+/*********************************************************************
+ * \file   motion_command.cpp
+ * \brief  R}h͂̔Fi8  + rbgI[g}g / Œ蒷j
+ *********************************************************************/
+#include "motion_command.h"
+#include <algorithm>
+
+//==============================================================================
+// 萔`
+//==============================================================================
+namespace {
+    constexpr int BITS_PER_WORD = 64;
+    constexpr float DIAGONAL_ANGLE_MAX = 89.0f;
+    constexpr float DEGREES_TO_RADIANS = 3.14159265f / 180.0f;
+
+    // E]ieL[\Lj
+    constexpr int MIRROR_DIRECTIONS[10] = { 0, 3, 2, 1, 6, 5, 4, 9, 8, 7 };
+
+    // ŉʂ 1 ̃rbgʒu
+    int LowestBit64(Uint64 value) {
+        Uint64 lowest = value & (~value + 1);
+        Uint32 high = static_cast<Uint32>(lowest >> 32);
+        if (high) return 32 + SDL_MostSignificantBitIndex32(high);
+        return SDL_MostSignificantBitIndex32(static_cast<Uint32>(lowest));
+    }
+
+    bool IsValidCommand(int command) {
+        return command >= 0 && command < MotionCommandRecognizer::MAX_COMMANDS;
+    }
+
+    bool IsValidStep(const MotionStep& step) {
+        if ((step.directions & MotionDir::ANY) == 0) return false;
+        switch (step.kind) {
+        case MotionStepKind::Direction:
+            return true;
+        case MotionStepKind::Button:
+            return step.buttons != 0;
+        case MotionStepKind::Charge:
+            return step.duration > 0;
+        default:
+            return false;
+        }
+    }
+}
+
+//==============================================================================
+// ̔
+//==============================================================================
+void MotionCommandRecognizer::SetSettings(const MotionInputSettings& settings) {
+    m_settings = settings;
+
+    // ΂߂̐` 45 x𒆐S diagonalAngle ̕i|y| / |x| ͈̔͂Ŕׂj
+    float angle = std::min(std::max(settings.diagonalAngle, 0.0f), DIAGONAL_ANGLE_MAX);
+    m_diagonalLow = std::tan((45.0f - angle * 0.5f) * DEGREES_TO_RADIANS);
+    m_diagonalHigh = std::tan((45.0f + angle * 0.5f) * DEGREES_TO_RADIANS);
+}
+
+int MotionCommandRecognizer::Quantize(const GamepadState& state) const {
+    int x = 0;
+    int y = 0;     // iSDL ̃XeBbNƓj
+
+    if (m_settings.useDpad && state.IsPressed(BUTTON_MASK_DPAD)) {
+        x = (state.IsPressed(BUTTON_MASK_DPAD_RIGHT) ? 1 : 0) - (state.IsPressed(BUTTON_MASK_DPAD_LEFT) ? 1 : 0);
+        y = (state.IsPressed(BUTTON_MASK_DPAD_DOWN) ? 1 : 0) - (state.IsPressed(BUTTON_MASK_DPAD_UP) ? 1 : 0);
+    }
+    else if (m_settings.useLeftStick) {
+        float ax = std::fabs(state.leftStickX);
+        float ay = std::fabs(state.leftStickY);
+        if (ax * ax + ay * ay >= m_settings.deadzone * m_settings.deadzone) {
+            int sx = (state.leftStickX > 0.0f) ? 1 : -1;
+            int sy = (state.leftStickY > 0.0f) ? 1 : -1;
+            if (ay <= ax * m_diagonalLow) {
+                x = sx;
+            }
+            else if (ay >= ax * m_diagonalHigh) {
+                y = sy;
+            }
+            else {
+                x = sx;
+                y = sy;
+            }
+        }
+    }
+
+    int direction = 5 + x - 3 * y;
+    return m_facingRight ? direction : MIRROR_DIRECTIONS[direction];
+}
+
+//==============================================================================
+// R}h̓o^
+//==============================================================================
+bool MotionCommandRecognizer::Register(int command, const MotionStep* pSteps, int count, const MotionWindow& window) {
+    if (!IsValidCommand(command) || !pSteps || count <= 0 || count > MAX_STEPS) return false;
+    if (window.length == 0) return false;
+    if (window.unit == MotionWindowUnit::Frames && window.length > MAX_BUFFER_FRAMES) return false;
+    for (int i = 0; i < count; i++) {
+        if (!IsValidStep(pSteps[i])) return false;
+    }
+
+    int index = 0;
+    while (index < m_commandCount && m_commands[index].command != command) index++;
+
+    bool replaced = (index < m_commandCount);
+    if (!replaced && m_commandCount >= MAX_COMMANDS) return false;
+
+    Command previous = m_commands[index];
+    Command& entry = m_commands[index];
+    entry.command = command;
+    for (int i = 0; i < count; i++) {
+        entry.steps[i] = pSteps[i];
+    }
+    entry.stepCount = count;
+    entry.window = window;
+    if (!replaced) m_commandCount++;
+    if (Rebuild()) return true;
+
+    // Ɏ܂ȂΌɖ߂
+    if (replaced) {
+        entry = previous;
+    }
+    else {
+        m_commandCount--;
+    }
+    Rebuild();
+    return false;
+}
+
+void MotionCommandRecognizer::Unregister(int command) {
+    int count = 0;
+    for (int i = 0; i < m_commandCount; i++) {
+        if (m_commands[i].command != command) {
+            m_commands[count++] = m_commands[i];
+        }
+    }
+    m_commandCount = count;
+    Rebuild();
+}
+
+void MotionCommandRecognizer::ClearCommands() {
+    m_commandCount = 0;
+    Rebuild();
+}
+
+//==============================================================================
+// }XN\̍č\z
+//------------------------------------------------------------------------------
+// R}h͌܂Ȃ悤ɐ擪l߂ĕׂi菇 1  1 rbgjB
+// E{^́u̓͂Ői߂ʒuvA߂͏Ƃ̃}XNɂB
+// tԂ̓t[wȂo߃t[ň\AԎwȂ璷̕\ɂA
+// ݐςĂioߎԈȏ̎tԂR}h܂Ƃ߂ĈjB
+//==============================================================================
+bool MotionCommandRecognizer::Rebuild() {
+    m_start = {};
+    m_final = {};
+    for (Words& mask : m_directionMasks) mask = {};
+    for (Words& mask : m_buttonMasks) mask = {};
+    for (Words& mask : m_buttonDirectionMasks) mask = {};
+    for (Words& mask : m_frameAlive) mask = {};
+    m_timeWindowCount = 0;
+    m_chargeCount = 0;
+
+    int word = 0;
+    int bit = 0;
+    for (int i = 0; i < m_commandCount; i++) {
+        const Command& entry = m_commands[i];
+        if (bit + entry.stepCount > BITS_PER_WORD) {
+            word++;
+            bit = 0;
+        }
+        if (word >= WORD_COUNT) return false;
+
+        Uint64 commandBits = ((1ull << entry.stepCount) - 1) << bit;
+        m_commandMasks[i] = {};
+        m_commandMasks[i].bits[word] = commandBits;
+        m_start.bits[word] |= 1ull << bit;
+        m_final.bits[word] |= 1ull << (bit + entry.stepCount - 1);
+
+        for (int s = 0; s < entry.stepCount; s++) {
+            const MotionStep& step = entry.steps[s];
+            Uint64 position = 1ull << (bit + s);
+            m_positionCommands[word * BITS_PER_WORD + bit + s] = static_cast<Uint8>(i);
+
+            switch (step.kind) {
+            case MotionStepKind::Direction:
+                for (int d = 1; d <= 9; d++) {
+                    if (step.directions & MotionDir::FromNumpad(d)) m_directionMasks[d].bits[word] |= position;
+                }
+                break;
+
+            case MotionStepKind::Button:
+                for (int b = 0; b < BUTTON_BIT_COUNT; b++) {
+                    if (step.buttons & (1u << b)) m_buttonMasks[b].bits[word] |= position;
+                }
+                for (int d = 1; d <= 9; d++) {
+                    if (step.directions & MotionDir::FromNumpad(d)) m_buttonDirectionMasks[d].bits[word] |= position;
+                }
+                break;
+
+            case MotionStepKind::Charge: {
+                Charge* pCharge = FindCharge(step, entry.window.unit);
+                if (!pCharge) return false;
+                pCharge->mask.bits[word] |= position;
+                break;
+            }
+
+            default:
+                break;
+            }
+        }
+
+        if (entry.window.unit == MotionWindowUnit::Frames) {
+            for (Uint64 age = 0; age <= entry.window.length; age++) {
+                m_frameAlive[age].bits[word] |= commandBits;
+            }
+        }
+        else {
+            // ͂܂Ƃ߂
+            int index = 0;
+            while (index < m_timeWindowCount && m_timeWindows[index] != entry.window.length) index++;
+            if (index == m_timeWindowCount) {
+                m_timeWindows[index] = entry.window.length;
+                m_timeAlive[index] = {};
+                m_timeWindowCount++;
+            }
+            m_timeAlive[index].bits[word] |= commandBits;
+        }
+
+        bit += entry.stepCount;
+    }
+
+    // Ԏw̎tԂZɕׁAݐς
+    for (int i = 1; i < m_timeWindowCount; i++) {
+        for (int j = i; j > 0 && m_timeWindows[j - 1] > m_timeWindows[j]; j--) {
+            std::swap(m_timeWindows[j - 1], m_timeWindows[j]);
+            std::swap(m_timeAlive[j - 1], m_timeAlive[j]);
+        }
+    }
+    for (int i = m_timeWindowCount - 2; i >= 0; i--) {
+        for (int w = 0; w < WORD_COUNT; w++) {
+            m_timeAlive[i].bits[w] |= m_timeAlive[i + 1].bits[w];
+        }
+    }
+
+    Reset();
+    return true;
+}
+
+MotionCommandRecognizer::Charge* MotionCommandRecognizer::FindCharge(const MotionStep& step, MotionWindowUnit unit) {
+    for (int i = 0; i < m_chargeCount; i++) {
+        Charge& charge = m_charges[i];
+        if (charge.directions == step.directions && charge.unit == unit && charge.duration == step.duration) {
+            return &charge;
+        }
+    }
+
+    if (m_chargeCount >= MAX_CHARGES) return nullptr;
+    Charge& charge = m_charges[m_chargeCount++];
+    charge = {};
+    charge.directions = step.directions;
+    charge.unit = unit;
+    charge.duration = step.duration;
+    return &charge;
+}
+
+//==============================================================================
+// 
+//==============================================================================
+void MotionCommandRecognizer::Reset() {
+    for (Slot& slot : m_slots) slot = {};
+    for (int i = 0; i < m_chargeCount; i++) {
+        m_charges[i].holding = false;
+    }
+    m_head = 0;
+    m_triggered = 0;
+}
+
+void MotionCommandRecognizer::Update(const GamepadState& state, Uint64 timestampNS) {
+    m_triggered = 0;
+    m_frame++;
+
+    int direction = Quantize(state);
+    bool changed = (direction != m_direction);
+    m_direction = direction;
+
+    if (m_commandCount == 0) return;
+
+    // tԂ߂ro߂ĂAt[̎n܂pӂ
+    Expire(timestampNS);
+    m_head = (m_head + 1) % SLOT_COUNT;
+    Slot& head = m_slots[m_head];
+    head.bits = {};
+    head.frame = m_frame;
+    head.timestampNS = timestampNS;
+
+    // E
+    Words accept = changed ? m_directionMasks[direction] : Words{};
+    Uint16 directionBit = MotionDir::FromNumpad(direction);
+    for (int i = 0; i < m_chargeCount; i++) {
+        Charge& charge = m_charges[i];
+        if (!(charge.directions & directionBit)) {
+            charge.holding = false;
+            continue;
+        }
+
+        Uint64 now = (charge.unit == MotionWindowUnit::Frames) ? m_frame : timestampNS;
+        if (!charge.holding) {
+            charge.holding = true;
+            charge.holdStart = now;
+        }
+        if (now - charge.holdStart >= charge.duration) {
+            for (int w = 0; w < WORD_COUNT; w++) {
+                accept.bits[w] |= charge.mask.bits[w];
+            }
+        }
+    }
+    Advance(accept, m_head);
+
+    // {^iꂽ{^̂ꂩŐi߂ʒûÁj
+    if (state.triggered) {
+        accept = {};
+        for (uint32_t bits = state.triggered; bits; bits &= bits - 1) {
+            const Words& mask = m_buttonMasks[LowestBit64(bits)];
+            for (int w = 0; w < WORD_COUNT; w++) {
+                accept.bits[w] |= mask.bits[w];
+            }
+        }
+        for (int w = 0; w < WORD_COUNT; w++) {
+            accept.bits[w] &= m_buttonDirectionMasks[direction].bits[w];
+        }
+        Advance(accept, m_head);
+    }
+
+    // Ō̎菇܂Ői񂾃R}h
+    for (int w = 0; w < WORD_COUNT; w++) {
+        Uint64 finals = 0;
+        for (const Slot& slot : m_slots) {
+            finals |= slot.bits.bits[w];
+        }
+        finals &= m_final.bits[w];
+        if (finals) Consume(w, finals);
+    }
+}
+
+//------------------------------------------------------------------------------
+// SXbg accept  1 i߂ir̈ʒu͎ĉŁAԂ̗]vȓ͓͂ǂݔ΂j
+//------------------------------------------------------------------------------
+void MotionCommandRecognizer::Advance(const Words& accept, int head) {
+    Uint64 any = 0;
+    for (int w = 0; w < WORD_COUNT; w++) {
+        any |= accept.bits[w];
+    }
+    if (!any) return;
+
+    for (int i = 0; i < SLOT_COUNT; i++) {
+        Slot& slot = m_slots[i];
+        for (int w = 0; w < WORD_COUNT; w++) {
+            // ÕR}h̍Ō̈ʒu玟̃R}h̐擪ւ͐i߂Ȃ
+            Uint64 next = (slot.bits.bits[w] << 1) & ~m_start.bits[w];
+            if (i == head) next |= m_start.bits[w];
+            slot.bits.bits[w] |= next & accept.bits[w];
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// n܂ĂtԂ߂R}h̓ro߂
+//------------------------------------------------------------------------------
+void MotionCommandRecognizer::Expire(Uint64 timestampNS) {
+    for (Slot& slot : m_slots) {
+        Uint64 any = 0;
+        for (int w = 0; w < WORD_COUNT; w++) {
+            any |= slot.bits.bits[w];
+        }
+        if (!any) continue;
+
+        Uint64 age = m_frame - slot.frame;
+        Words alive = (age < SLOT_COUNT) ? m_frameAlive[age] : Words{};
+
+        const Uint64* pBegin = m_timeWindows;
+        const Uint64* pEnd = pBegin + m_timeWindowCount;
+        const Uint64* pFound = std::lower_bound(pBegin, pEnd, timestampNS - slot.timestampNS);
+        if (pFound != pEnd) {
+            const Words& mask = m_timeAlive[pFound - pBegin];
+            for (int w = 0; w < WORD_COUNT; w++) {
+                alive.bits[w] |= mask.bits[w];
+            }
+        }
+
+        for (int w = 0; w < WORD_COUNT; w++) {
+            slot.bits.bits[w] &= alive.bits[w];
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// R}hʒmÃR}h̓ro߂ׂĎ̂ĂiAŐȂj
+//------------------------------------------------------------------------------
+void MotionCommandRecognizer::Consume(int word, Uint64 finals) {
+    for (; finals; finals &= finals - 1) {
+        int index = m_positionCommands[word * BITS_PER_WORD + LowestBit64(finals)];
+        m_triggered |= 1ull << m_commands[index].command;
+
+        Uint64 keep = ~m_commandMasks[index].bits[word];
+        for (Slot& slot : m_slots) {
+            slot.bits.bits[word] &= keep;
+        }
+    }
+}
@@ -0,0 +1,221 @@
+/*********************************************************************
+ * \file   motion_command.h
+ * \brief  R}h͂̔Fi8  + rbgI[g}g / Œ蒷j
+ *********************************************************************/
+#pragma once
+#include "controller_types.h"
+
+//==============================================================================
+// ieL[\L̃rbgA5 j[gBO͌ɍ킹čE]j
+//==============================================================================
+namespace MotionDir {
+    constexpr Uint16 DOWN_BACK = 1u << 1;
+    constexpr Uint16 DOWN = 1u << 2;
+    constexpr Uint16 DOWN_FORWARD = 1u << 3;
+    constexpr Uint16 BACK = 1u << 4;
+    constexpr Uint16 NEUTRAL = 1u << 5;
+    constexpr Uint16 FORWARD = 1u << 6;
+    constexpr Uint16 UP_BACK = 1u << 7;
+    constexpr Uint16 UP = 1u << 8;
+    constexpr Uint16 UP_FORWARD = 1u << 9;
+
+    // O[vi΂߂܂߂Ċɂ󂯕tƂɎgj
+    constexpr Uint16 ANY_DOWN = DOWN_BACK | DOWN | DOWN_FORWARD;
+    constexpr Uint16 ANY_UP = UP_BACK | UP | UP_FORWARD;
+    constexpr Uint16 ANY_BACK = DOWN_BACK | BACK | UP_BACK;
+    constexpr Uint16 ANY_FORWARD = DOWN_FORWARD | FORWARD | UP_FORWARD;
+    constexpr Uint16 ANY = ANY_DOWN | ANY_UP | BACK | NEUTRAL | FORWARD;
+
+    // eL[̐
+    constexpr Uint16 FromNumpad(int numpad) { return static_cast<Uint16>(1u << numpad); }
+}
+
+//==============================================================================
+// R}h̎菇
+//==============================================================================
+enum class MotionStepKind : Uint8 {
+    None,
+    Direction,  //  directions ̂ꂩɕς
+    Button,     // buttons ̂ꂩꂽîƂ directions ̂ꂩj
+    Charge      // directions ̂ꂩ duration ȏꑱĂi߁j
+};
+
+struct MotionStep {
+    MotionStepKind kind = MotionStepKind::None;
+    Uint16 directions = 0;
+    uint32_t buttons = 0;
+    Uint64 duration = 0;        // ߂̒iPʂ̓R}h̎tԂƓj
+
+    constexpr MotionStep() = default;
+    constexpr MotionStep(MotionStepKind kind_, Uint16 directions_, uint32_t buttons_, Uint64 duration_)
+        : kind(kind_), directions(directions_), buttons(buttons_), duration(duration_) {}
+
+    static constexpr MotionStep Dir(Uint16 directions) {
+        return MotionStep(MotionStepKind::Direction, directions, 0, 0);
+    }
+    static constexpr MotionStep Button(uint32_t buttons, Uint16 directions = MotionDir::ANY) {
+        return MotionStep(MotionStepKind::Button, directions, buttons, 0);
+    }
+    static constexpr MotionStep Charge(Uint16 directions, Uint64 duration) {
+        return MotionStep(MotionStepKind::Charge, directions, 0, duration);
+    }
+};
+
+//==============================================================================
+// tԁiŏ̎菇Ō̎菇܂łɋj
+//==============================================================================
+enum class MotionWindowUnit : Uint8 {
+    Frames,         // Update() ̉
+    Nanoseconds     // Update() ɓn
+};
+
+struct MotionWindow {
+    Uint64 length = 0;
+    MotionWindowUnit unit = MotionWindowUnit::Frames;
+
+    static constexpr MotionWindow Frames(Uint64 frames) { return { frames, MotionWindowUnit::Frames }; }
+    static constexpr MotionWindow Nanoseconds(Uint64 ns) { return { ns, MotionWindowUnit::Nanoseconds }; }
+};
+
+//==============================================================================
+// ̔̐ݒ
+//==============================================================================
+struct MotionInputSettings {
+    float deadzone = 0.5f;          // XeBbNꖢȂj[g
+    float diagonalAngle = 45.0f;    // ΂߂Ƃ݂Ȃ`̕ixALقǎ΂߂₷j
+    bool useDpad = true;            // Ă΃XeBbND悷
+    bool useLeftStick = true;
+};
+
+//==============================================================================
+// R}h͔FNX
+//------------------------------------------------------------------------------
+//  enum Command { CMD_HADOKEN, CMD_SHORYUKEN, CMD_SONIC_BOOM, CMD_DASH };
+//  constexpr MotionStep HADOKEN[] = {       // 236 + P
+//      MotionStep::Dir(MotionDir::DOWN), MotionStep::Dir(MotionDir::DOWN_FORWARD),
+//      MotionStep::Dir(MotionDir::FORWARD), MotionStep::Button(BUTTON_MASK_LEFT),
+//  };
+//  constexpr MotionStep SONIC_BOOM[] = {    // [4] 45 t[ 6 + P
+//      MotionStep::Charge(MotionDir::ANY_BACK, 45), MotionStep::Dir(MotionDir::FORWARD),
+//      MotionStep::Button(BUTTON_MASK_LEFT),
+//  };
+//  recognizer.Register(CMD_HADOKEN, HADOKEN, MotionWindow::Frames(15));
+//
+// SR}h̎菇 64 rbg̃rbgʒuׁ֕AUpdate() ł͎菇̎ނƂ
+// Ă}XNőSR}h𓯎 1 i߂iShift-AndjBr̗]vȓ͂
+// ǂݔ΂BtԂ́ut[OɎn܂ro߂vƂɃrbg𕪂ĎA
+// ÂȂ̂R}hƂ̃}XNŏB1 t[̏ʂ͓o^ɂ炸
+// WORD_COUNT ~ (MAX_BUFFER_FRAMES + 1) ̉ZňɂȂB
+// 1 t[ł͕E߂̂ƂɃ{^̂ŁAŌ̕ƃ{^͓ł悢B
+// o^EύX͌Œ蒷̔zōsAmۂ͂ȂB
+//==============================================================================
+class MotionCommandRecognizer {
+public:
+    static constexpr int MAX_COMMANDS = 64;
+    static constexpr int MAX_STEPS = 16;            // 1 R}h̎菇
+    static constexpr int WORD_COUNT = 4;            // 菇̑ 64 ~ WORD_COUNT ܂
+    static constexpr int MAX_BUFFER_FRAMES = 64;    // tԂ̏iԎwłO͎̓͂gȂj
+    static constexpr int MAX_CHARGES = 16;          // ߏiƒ̑gj̎
+
+    MotionCommandRecognizer() { SetSettings(MotionInputSettings()); }
+
+    // ̔
+    void SetSettings(const MotionInputSettings& settings);
+    const MotionInputSettings& GetSettings() const { return m_settings; }
+
+    // iȂO𔽓]j
+    void SetFacingRight(bool facingRight) { m_facingRight = facingRight; }
+    bool IsFacingRight() const { return m_facingRight; }
+
+    // R}h̓o^icommand  0 ` MAX_COMMANDS - 1Aԍ͒uj
+    bool Register(int command, const MotionStep* pSteps, int count, const MotionWindow& window);
+    template<int N>
+    bool Register(int command, const MotionStep (&steps)[N], const MotionWindow& window) {
+        return Register(command, steps, N, window);
+    }
+    void Unregister(int command);
+    void ClearCommands();
+
+    // i1 t[ 1 j
+    void Update(const GamepadState& state, Uint64 timestampNS);
+
+    // ro߂̂ĂiEhJnȂǁj
+    void Reset();
+
+    // ݂̕ieL[\LA𔽉fς݁j
+    int GetDirection() const { return m_direction; }
+
+    // ̃t[ŐR}h
+    bool IsTriggered(int command) const { return (m_triggered >> command) & 1; }
+    Uint64 GetTriggered() const { return m_triggered; }
+
+private:
+    static constexpr int BUTTON_BIT_COUNT = 32;
+    static constexpr int SLOT_COUNT = MAX_BUFFER_FRAMES + 1;
+
+    struct Words {
+        Uint64 bits[WORD_COUNT];
+    };
+
+    struct Command {
+        int command = -1;
+        MotionStep steps[MAX_STEPS];
+        int stepCount = 0;
+        MotionWindow window;
+    };
+
+    // ߏiE̎菇ŋLj
+    struct Charge {
+        Uint16 directions;
+        MotionWindowUnit unit;
+        Uint64 duration;
+        Words mask;
+        bool holding;
+        Uint64 holdStart;
+    };
+
+    // n܂t[Ƃ̓ro
+    struct Slot {
+        Words bits;
+        Uint64 frame;
+        Uint64 timestampNS;
+    };
+
+    int Quantize(const GamepadState& state) const;
+    bool Rebuild();
+    Charge* FindCharge(const MotionStep& step, MotionWindowUnit unit);
+    void Advance(const Words& accept, int head);
+    void Expire(Uint64 timestampNS);
+    void Consume(int word, Uint64 finals);
+
+    MotionInputSettings m_settings;
+    float m_diagonalLow = 0.0f;
+    float m_diagonalHigh = 0.0f;
+    bool m_facingRight = true;
+
+    // o^io^j
+    Command m_commands[MAX_COMMANDS];
+    int m_commandCount = 0;
+
+    // ϊς݂̃}XN
+    Words m_start = {};
+    Words m_final = {};
+    Words m_directionMasks[10] = {};
+    Words m_buttonMasks[BUTTON_BIT_COUNT] = {};
+    Words m_buttonDirectionMasks[10] = {};
+    Words m_frameAlive[SLOT_COUNT] = {};
+    Uint64 m_timeWindows[MAX_COMMANDS] = {};
+    Words m_timeAlive[MAX_COMMANDS] = {};
+    int m_timeWindowCount = 0;
+    Charge m_charges[MAX_CHARGES] = {};
+    int m_chargeCount = 0;
+    Uint8 m_positionCommands[WORD_COUNT * 64] = {};
+    Words m_commandMasks[MAX_COMMANDS] = {};
+
+    // s̏
+    Slot m_slots[SLOT_COUNT] = {};
+    int m_head = 0;
+    Uint64 m_frame = 0;
+    int m_direction = 5;
+    Uint64 m_triggered = 0;
+};
@@ -0,0 +1,245 @@
+/*********************************************************************
+ * \file   orientation.cpp
+ * \brief  WCƉx̗ZɂpiÎ~o / WCoCAX␳j
+ *********************************************************************/
+#include "orientation.h"
+#include <cmath>
+
+//==============================================================================
+// 萔Ewp[
+//==============================================================================
+namespace {
+    constexpr Uint64 MAX_GYRO_GAP_NS = 100 * SDL_NS_PER_MS;  // 󂢂ϕȂ
+    constexpr float GYRO_SMOOTHING_TIME = 0.1f;             // Î~p̕ibj
+    constexpr float ACCEL_SMOOTHING = 0.1f;                 // x 1 Tv̕W
+    constexpr float PITCH_AXIS_MIN_LENGTH = 0.2f;           // ʂقڐƂ݂Ȃ
+
+    MotionVector3 Make(float x, float y, float z) {
+        MotionVector3 v;
+        v.x = x;
+        v.y = y;
+        v.z = z;
+        return v;
+    }
+
+    MotionVector3 Sub(const MotionVector3& a, const MotionVector3& b) {
+        return Make(a.x - b.x, a.y - b.y, a.z - b.z);
+    }
+
+    MotionVector3 Scale(const MotionVector3& v, float s) {
+        return Make(v.x * s, v.y * s, v.z * s);
+    }
+
+    float Dot(const MotionVector3& a, const MotionVector3& b) {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    MotionVector3 Cross(const MotionVector3& a, const MotionVector3& b) {
+        return Make(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+    }
+
+    float Length(const MotionVector3& v) {
+        return std::sqrt(Dot(v, v));
+    }
+
+    void Lerp(MotionVector3& v, const MotionVector3& target, float t) {
+        v.x += (target.x - v.x) * t;
+        v.y += (target.y - v.y) * t;
+        v.z += (target.z - v.z) * t;
+    }
+
+    MotionQuaternion Normalize(const MotionQuaternion& q) {
+        float length = std::sqrt(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z);
+        if (length <= 0.0f) return MotionQuaternion();
+        float inv = 1.0f / length;
+        MotionQuaternion r;
+        r.w = q.w * inv;
+        r.x = q.x * inv;
+        r.y = q.y * inv;
+        r.z = q.z * inv;
+        return r;
+    }
+
+    MotionQuaternion Multiply(const MotionQuaternion& a, const MotionQuaternion& b) {
+        MotionQuaternion r;
+        r.w = a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z;
+        r.x = a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y;
+        r.y = a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x;
+        r.z = a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w;
+        return r;
+    }
+
+    // q ̋t] v 񂷁i[h  foCXj
+    MotionVector3 RotateInverse(const MotionQuaternion& q, const MotionVector3& v) {
+        MotionVector3 u = Make(-q.x, -q.y, -q.z);
+        MotionVector3 t = Scale(Cross(u, v), 2.0f);
+        MotionVector3 c = Cross(u, t);
+        return Make(v.x + q.w * t.x + c.x, v.y + q.w * t.y + c.y, v.z + q.w * t.z + c.z);
+    }
+
+    MotionVector3 Rotate(const MotionQuaternion& q, const MotionVector3& v) {
+        MotionQuaternion inverse = q;
+        inverse.x = -q.x;
+        inverse.y = -q.y;
+        inverse.z = -q.z;
+        return RotateInverse(inverse, v);
+    }
+
+    float Sign(float value) {
+        return (value < 0.0f) ? -1.0f : 1.0f;
+    }
+}
+
+//==============================================================================
+// Zbg
+//==============================================================================
+void OrientationEstimator::Reset() {
+    OrientationSettings settings = m_settings;
+    *this = OrientationEstimator();
+    m_settings = settings;
+}
+
+void OrientationEstimator::ResetYaw() {
+    // foCX̐ʁi-Zj[h -Z 悤A㎲܂肾
+    MotionVector3 forward = Rotate(m_orientation, Make(0.0f, 0.0f, -1.0f));
+    float yaw = std::atan2(-forward.x, -forward.z);
+
+    MotionQuaternion undo;
+    undo.w = std::cos(yaw * 0.5f);
+    undo.y = -std::sin(yaw * 0.5f);
+    m_orientation = Normalize(Multiply(undo, m_orientation));
+}
+
+//==============================================================================
+// x
+//==============================================================================
+void OrientationEstimator::ProcessAccel(const float accel[3]) {
+    m_accel = Make(accel[0], accel[1], accel[2]);
+    if (!m_hasAccel) {
+        m_accelSmoothed = m_accel;
+        m_hasAccel = true;
+    }
+    Lerp(m_accelSmoothed, m_accel, ACCEL_SMOOTHING);
+
+    float magnitude = Length(m_accel);
+    m_accelUsable = std::fabs(magnitude - SDL_STANDARD_GRAVITY) < SDL_STANDARD_GRAVITY * m_settings.gravityTolerance;
+    m_accelStable = m_accelUsable && Length(Sub(m_accel, m_accelSmoothed)) < m_settings.restAccelThreshold;
+
+    // ŏ̏d͂ŌX킹î҂Ȃj
+    if (!m_hasGravity && m_accelUsable) {
+        MotionVector3 measured = Scale(m_accel, 1.0f / magnitude);
+        MotionVector3 up = Make(0.0f, 1.0f, 0.0f);
+        MotionVector3 axis = Cross(measured, up);
+
+        MotionQuaternion q;
+        q.w = 1.0f + Dot(measured, up);
+        q.x = axis.x;
+        q.y = axis.y;
+        q.z = axis.z;
+        if (q.w < 1e-6f) {
+            // ^ĂFX ܂ɔ]
+            q = MotionQuaternion();
+            q.w = 0.0f;
+            q.x = 1.0f;
+        }
+        m_orientation = Normalize(q);
+        m_hasGravity = true;
+    }
+}
+
+//==============================================================================
+// WCiϕƕ␳j
+//==============================================================================
+void OrientationEstimator::ProcessGyro(const float gyro[3], Uint64 timestampNS) {
+    MotionVector3 raw = Make(gyro[0], gyro[1], gyro[2]);
+
+    if (m_lastGyroNS == 0 || timestampNS <= m_lastGyroNS) {
+        m_lastGyroNS = timestampNS;
+        m_gyroSmoothed = raw;
+        return;
+    }
+
+    Uint64 dtNS = timestampNS - m_lastGyroNS;
+    m_lastGyroNS = timestampNS;
+    if (dtNS > MAX_GYRO_GAP_NS) {
+        // 肱ڂꎞ~̌FÎ~肾蒼
+        m_gyroSmoothed = raw;
+        m_restElapsedNS = 0;
+        return;
+    }
+    float dt = static_cast<float>(dtNS) * 1e-9f;
+    m_elapsedNS += dtNS;
+
+    // Î~oihꂪA]xAxĂj
+    Lerp(m_gyroSmoothed, raw, dt / (GYRO_SMOOTHING_TIME + dt));
+    bool still = m_accelStable &&
+        Length(Sub(raw, m_gyroSmoothed)) < m_settings.restGyroThreshold &&
+        Length(raw) < m_settings.restMaxRate;
+    m_restElapsedNS = still ? m_restElapsedNS + dtNS : 0;
+
+    // Î~̓WC̒l̂̂oCAX
+    if (IsAtRest()) {
+        Lerp(m_bias, raw, dt / (m_settings.biasTimeConstant + dt));
+    }
+    m_gyro = Sub(raw, m_bias);
+
+    // d͕̂ŕ␳px
+    MotionVector3 rate = m_gyro;
+    if (m_hasGravity && m_accelUsable) {
+        MotionVector3 measured = Scale(m_accel, 1.0f / Length(m_accel));
+        MotionVector3 error = Cross(measured, GetUp());
+        float gain = (IsAtRest() || m_elapsedNS < m_settings.startupNS)
+            ? m_settings.restCorrectionGain : m_settings.correctionGain;
+        rate.x += error.x * gain;
+        rate.y += error.y * gain;
+        rate.z += error.z * gain;
+    }
+
+    // q' = q * (1,  dt / 2)
+    MotionQuaternion delta;
+    delta.w = 1.0f;
+    delta.x = rate.x * dt * 0.5f;
+    delta.y = rate.y * dt * 0.5f;
+    delta.z = rate.z * dt * 0.5f;
+    m_orientation = Normalize(Multiply(m_orientation, delta));
+
+    // [hԁFd͂̎܂肪 yawAʁi-Zj𐅕ɂ̉܂肪 pitchB
+    // ʂ^E^ɋ߂Ƃ X 𐅕ɂĎg
+    MotionVector3 up = GetUp();
+    m_worldRate.yaw = Dot(m_gyro, up);
+    MotionVector3 pitchAxis = Cross(Sub(Make(0.0f, 0.0f, -1.0f), Scale(up, -up.z)), up);
+    if (Length(pitchAxis) < PITCH_AXIS_MIN_LENGTH) {
+        pitchAxis = Sub(Make(1.0f, 0.0f, 0.0f), Scale(up, up.x));
+    }
+    float pitchLength = Length(pitchAxis);
+    m_worldRate.pitch = (pitchLength > 0.0f) ? Dot(m_gyro, pitchAxis) / pitchLength : m_gyro.x;
+
+    // vC[ԁF͏d͂A傫̓foCX yaw / roll 
+    float worldYaw = m_gyro.y * up.y + m_gyro.z * up.z;
+    float localYaw = std::sqrt(m_gyro.y * m_gyro.y + m_gyro.z * m_gyro.z);
+    m_playerRate.yaw = Sign(worldYaw) * SDL_min(std::fabs(worldYaw) * m_settings.playerYawRelax, localYaw);
+    m_playerRate.pitch = m_gyro.x;
+
+    m_worldDelta.yaw += m_worldRate.yaw * dt;
+    m_worldDelta.pitch += m_worldRate.pitch * dt;
+    m_playerDelta.yaw += m_playerRate.yaw * dt;
+    m_playerDelta.pitch += m_playerRate.pitch * dt;
+}
+
+//==============================================================================
+// Q
+//==============================================================================
+MotionVector3 OrientationEstimator::GetUp() const {
+    return RotateInverse(m_orientation, Make(0.0f, 1.0f, 0.0f));
+}
+
+MotionVector3 OrientationEstimator::GetGravity() const {
+    return Scale(GetUp(), -1.0f);
+}
+
+void OrientationEstimator::TakeAimDelta(GyroAim* pWorld, GyroAim* pPlayer) {
+    if (pWorld) *pWorld = m_worldDelta;
+    if (pPlayer) *pPlayer = m_playerDelta;
+    m_worldDelta = GyroAim();
+    m_playerDelta = GyroAim();
+}
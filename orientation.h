@@ -0,0 +1,121 @@
+/*********************************************************************
+ * \file   orientation.h
+ * \brief  WCƉx̗ZɂpiÎ~o / WCoCAX␳j
+ *********************************************************************/
+#pragma once
+#include <SDL3/SDL.h>
+
+//==============================================================================
+// xNgENH[^jI
+//==============================================================================
+struct MotionVector3 {
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+};
+
+// ]ifoCXW  [hWj
+struct MotionQuaternion {
+    float w = 1.0f;
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+};
+
+//==============================================================================
+// GCp̉]iWAA܂̓WA / bj
+//------------------------------------------------------------------------------
+// yaw ͍Apitch ͏B
+//==============================================================================
+struct GyroAim {
+    float yaw = 0.0f;
+    float pitch = 0.0f;
+};
+
+//==============================================================================
+// p̐ݒ
+//==============================================================================
+struct OrientationSettings {
+    float correctionGain = 0.5f;        // xŌX␳鋭i1 / bj
+    float restCorrectionGain = 5.0f;    // Î~EN̕␳̋
+    Uint64 startupNS = SDL_NS_PER_SECOND;   // NƂ݂Ȃ
+    float gravityTolerance = 0.1f;      // x̑傫d͂炱̊ȓȂ␳Ɏg
+
+    // Î~oȉԂ restTimeNS Î~j
+    float restGyroThreshold = 0.05f;    // WC̗hiWA / bj
+    float restMaxRate = 0.25f;          // WC̐l̏iWA / bj
+    float restAccelThreshold = 0.4f;    // x̗him/s^2j
+    Uint64 restTimeNS = 500 * SDL_NS_PER_MS;
+    float biasTimeConstant = 1.0f;      // Î~ɃoCAX֒Ǐ]鎞萔ibj
+
+    float playerYawRelax = 1.41f;       // vC[Ԃ yaw ̊ɘaW
+};
+
+//==============================================================================
+// pNXi1 foCXj
+//------------------------------------------------------------------------------
+// Mahony ^̑tB^BWC̃TvƂɐϕAx狁߂
+// d͕Ƃ̂ŌXipitch / rollj␳Byaw ͏d͂ł͕␳łȂ̂ŁA
+// Î~ɊwKWCoCAXăhtg}B
+// 1 Tv̏ O(1)A͌ŒB
+// W SDL ̃ZT[WiX EAY AZ OjŁA[h̏ +YB
+//==============================================================================
+class OrientationEstimator {
+public:
+    void SetSettings(const OrientationSettings& settings) { m_settings = settings; }
+    const OrientationSettings& GetSettings() const { return m_settings; }
+
+    // Tv̓́iWC̓WA / bƃfoCXAx m/s^2j
+    void ProcessGyro(const float gyro[3], Uint64 timestampNS);
+    void ProcessAccel(const float accel[3]);
+
+    // pEoCAX̂ĂifoCX̕tւj
+    void Reset();
+
+    // pۂ܂܁Ǎ݂𐳖ʁiyaw = 0jɂ
+    void ResetYaw();
+
+    // 
+    const MotionQuaternion& GetOrientation() const { return m_orientation; }
+    MotionVector3 GetGravity() const;                   // foCXWł̏d͂̌iPʃxNgj
+    MotionVector3 GetCalibratedGyro() const { return m_gyro; }  // oCAXpx
+    MotionVector3 GetGyroBias() const { return m_bias; }
+    bool IsAtRest() const { return m_restElapsedNS >= m_settings.restTimeNS; }
+    bool IsInitialized() const { return m_hasGravity; }
+
+    // ߂̃Tv̊pxiWA / bj
+    GyroAim GetWorldGyro() const { return m_worldRate; }
+    GyroAim GetPlayerGyro() const { return m_playerRate; }
+
+    // O TakeAimDelta() ̉]ʁiWAjo 0 ɖ߂
+    void TakeAimDelta(GyroAim* pWorld, GyroAim* pPlayer);
+
+private:
+    MotionVector3 GetUp() const;
+
+    OrientationSettings m_settings;
+
+    MotionQuaternion m_orientation;
+    MotionVector3 m_gyro;
+    MotionVector3 m_bias;
+    bool m_hasGravity = false;
+    Uint64 m_lastGyroNS = 0;
+    Uint64 m_elapsedNS = 0;
+
+    // xiŐVlƕlj
+    MotionVector3 m_accel;
+    MotionVector3 m_accelSmoothed;
+    bool m_hasAccel = false;
+    bool m_accelUsable = false;     // d͂Ƃ݂Ȃ傫
+    bool m_accelStable = false;     // hĂȂ
+
+    // Î~o
+    MotionVector3 m_gyroSmoothed;
+    Uint64 m_restElapsedNS = 0;
+
+    // GC
+    GyroAim m_worldRate;
+    GyroAim m_playerRate;
+    GyroAim m_worldDelta;
+    GyroAim m_playerDelta;
+};
@@ -0,0 +1,322 @@
+/*********************************************************************
+ * \file   output_writer.cpp
+ * \brief  LEDEȔo̓|[gʃXbhŏށid / [gj
+ *********************************************************************/
+#include "output_writer.h"
+#include "input_profiler.h"
+#include <atomic>
+
+//==============================================================================
+// 
+//------------------------------------------------------------------------------
+// ۗ̒l 0 uvƂALrbg𗧂Ă 1 ɋl߂B
+//  LED    : VALID | r << 16 | g << 8 | b
+//  U   : VALID | durationMS << 32 | high << 16 | low
+//==============================================================================
+namespace {
+    constexpr Uint32 LED_VALID = 1u << 24;
+    constexpr Uint64 RUMBLE_VALID = 1ull << 63;
+    constexpr Uint32 RUMBLE_DURATION_MAX = 0x7FFFFFFF;
+    constexpr Sint32 DEFERRED_WAIT_MS = 1;
+
+    // ۗ̒l̎
+    enum OutputKind {
+        OUTPUT_LED = 0,
+        OUTPUT_RUMBLE,
+        OUTPUT_TRIGGERS,
+        OUTPUT_KIND_COUNT
+    };
+
+    struct DeviceSlot {
+        std::atomic<SDL_Gamepad*> pGamepad{ nullptr };
+        std::atomic<Uint32> pendingLED{ 0 };
+        std::atomic<Uint64> pendingRumble{ 0 };
+        std::atomic<Uint64> pendingTriggers{ 0 };
+
+        // v݂̂Gidpj
+        Uint32 requestedLED = 0;
+
+        // [J[݂̂G
+        Uint32 writtenLED = 0;
+        Uint64 lastWriteNS = 0;
+
+#if defined(GC_ENABLE_PROFILING)
+        // ۗ̒lŏɗvꂽiv͍ŏ̎̂܂܁j
+        std::atomic<Uint64> submitNS[OUTPUT_KIND_COUNT] = {};
+#endif
+    };
+
+    DeviceSlot s_slots[OutputWriter::MAX_DEVICES];
+    SDL_Thread* s_pWorker = nullptr;
+    SDL_Semaphore* s_pWake = nullptr;
+    SDL_Mutex* s_pMutex = nullptr;
+    std::atomic<bool> s_running{ false };
+    std::atomic<Uint64> s_minIntervalNS{ OutputWriter::DEFAULT_MIN_INTERVAL_NS };
+    int s_refCount = 0;
+
+    std::atomic<Uint32> s_submitted{ 0 };
+    std::atomic<Uint32> s_written{ 0 };
+    std::atomic<Uint32> s_dropped{ 0 };
+    std::atomic<Uint32> s_merged{ 0 };
+    std::atomic<Uint32> s_deferred{ 0 };
+
+    bool IsValidSlot(int slot) {
+        return slot >= 0 && slot < OutputWriter::MAX_DEVICES;
+    }
+
+    Uint64 PackRumble(Uint16 low, Uint16 high, Uint32 durationMS) {
+        Uint64 duration = (durationMS < RUMBLE_DURATION_MAX) ? durationMS : RUMBLE_DURATION_MAX;
+        return RUMBLE_VALID | (duration << 32) | (static_cast<Uint64>(high) << 16) | low;
+    }
+
+#if defined(GC_ENABLE_PROFILING)
+    // ۗȂvci݂܂ł̒xvpj
+    template<typename T>
+    void MarkSubmit(std::atomic<Uint64>& submitNS, const std::atomic<T>& pending) {
+        if (pending.load(std::memory_order_relaxed) == 0) {
+            submitNS.store(SDL_GetTicksNS(), std::memory_order_relaxed);
+        }
+    }
+#endif
+
+    // ۗ̒luA܂ĂȂl΍ƂĐ
+    template<typename T>
+    void Post(std::atomic<T>& pending, T value) {
+        if (pending.exchange(value, std::memory_order_acq_rel) != 0) {
+            s_merged.fetch_add(1, std::memory_order_relaxed);
+        }
+        s_submitted.fetch_add(1, std::memory_order_relaxed);
+        SDL_SignalSemaphore(s_pWake);
+    }
+}
+
+//==============================================================================
+// EIiQƃJEgtj
+//==============================================================================
+bool OutputWriter::Initialize() {
+    if (s_refCount++ > 0) return true;
+
+    s_pWake = SDL_CreateSemaphore(0);
+    s_pMutex = SDL_CreateMutex();
+    if (!s_pWake || !s_pMutex) {
+        Finalize();
+        return false;
+    }
+
+    s_running.store(true, std::memory_order_release);
+    s_pWorker = SDL_CreateThread(WorkerMain, "GameControllerOutput", nullptr);
+    if (!s_pWorker) {
+        s_running.store(false, std::memory_order_release);
+        Finalize();
+        return false;
+    }
+    return true;
+}
+
+void OutputWriter::Finalize() {
+    if (s_refCount <= 0 || --s_refCount > 0) return;
+
+    if (s_pWorker) {
+        s_running.store(false, std::memory_order_release);
+        SDL_SignalSemaphore(s_pWake);
+        SDL_WaitThread(s_pWorker, nullptr);
+        s_pWorker = nullptr;
+    }
+
+    // cĂloĂSXbgO
+    for (int i = 0; i < MAX_DEVICES; i++) {
+        if (s_slots[i].pGamepad.load(std::memory_order_acquire)) {
+            FlushSlot(i, SDL_GetTicksNS(), true);
+        }
+        s_slots[i].pGamepad.store(nullptr, std::memory_order_release);
+    }
+
+    SDL_DestroyMutex(s_pMutex);
+    SDL_DestroySemaphore(s_pWake);
+    s_pMutex = nullptr;
+    s_pWake = nullptr;
+}
+
+bool OutputWriter::IsRunning() {
+    return s_running.load(std::memory_order_acquire);
+}
+
+//==============================================================================
+// foCXo^
+//==============================================================================
+int OutputWriter::Register(SDL_Gamepad* pGamepad) {
+    if (!pGamepad || !IsRunning()) return -1;
+
+    SDL_LockMutex(s_pMutex);
+    int slot = -1;
+    for (int i = 0; i < MAX_DEVICES; i++) {
+        DeviceSlot& device = s_slots[i];
+        if (device.pGamepad.load(std::memory_order_relaxed)) continue;
+
+        device.pendingLED.store(0, std::memory_order_relaxed);
+        device.pendingRumble.store(0, std::memory_order_relaxed);
+        device.pendingTriggers.store(0, std::memory_order_relaxed);
+        device.requestedLED = 0;
+        device.writtenLED = 0;
+        device.lastWriteNS = 0;
+        device.pGamepad.store(pGamepad, std::memory_order_release);
+        slot = i;
+        break;
+    }
+    SDL_UnlockMutex(s_pMutex);
+    return slot;
+}
+
+void OutputWriter::Unregister(int slot) {
+    if (!IsValidSlot(slot) || !s_pMutex) return;
+
+    // [J[ݒȂÎ҂AۗoĂO
+    SDL_LockMutex(s_pMutex);
+    if (s_slots[slot].pGamepad.load(std::memory_order_relaxed)) {
+        FlushSlot(slot, SDL_GetTicksNS(), true);
+    }
+    s_slots[slot].pGamepad.store(nullptr, std::memory_order_release);
+    SDL_UnlockMutex(s_pMutex);
+}
+
+//==============================================================================
+// v
+//==============================================================================
+bool OutputWriter::SubmitLED(int slot, Uint8 r, Uint8 g, Uint8 b) {
+    if (!IsValidSlot(slot) || !s_slots[slot].pGamepad.load(std::memory_order_acquire)) return false;
+
+    DeviceSlot& device = s_slots[slot];
+    Uint32 value = LED_VALID | (static_cast<Uint32>(r) << 16) | (static_cast<Uint32>(g) << 8) | b;
+    if (value == device.requestedLED) {
+        s_dropped.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    device.requestedLED = value;
+    GC_PROFILE_ONLY(MarkSubmit(device.submitNS[OUTPUT_LED], device.pendingLED);)
+    Post(device.pendingLED, value);
+    return true;
+}
+
+bool OutputWriter::SubmitRumble(int slot, Uint16 low, Uint16 high, Uint32 durationMS) {
+    if (!IsValidSlot(slot) || !s_slots[slot].pGamepad.load(std::memory_order_acquire)) return false;
+    GC_PROFILE_ONLY(MarkSubmit(s_slots[slot].submitNS[OUTPUT_RUMBLE], s_slots[slot].pendingRumble);)
+    Post(s_slots[slot].pendingRumble, PackRumble(low, high, durationMS));
+    return true;
+}
+
+bool OutputWriter::SubmitTriggerRumble(int slot, Uint16 left, Uint16 right, Uint32 durationMS) {
+    if (!IsValidSlot(slot) || !s_slots[slot].pGamepad.load(std::memory_order_acquire)) return false;
+    GC_PROFILE_ONLY(MarkSubmit(s_slots[slot].submitNS[OUTPUT_TRIGGERS], s_slots[slot].pendingTriggers);)
+    Post(s_slots[slot].pendingTriggers, PackRumble(left, right, durationMS));
+    return true;
+}
+
+void OutputWriter::SetMinInterval(Uint64 intervalNS) {
+    s_minIntervalNS.store(intervalNS, std::memory_order_relaxed);
+}
+
+//==============================================================================
+// v
+//==============================================================================
+OutputWriterStats OutputWriter::GetStats() {
+    OutputWriterStats stats;
+    stats.submitted = s_submitted.load(std::memory_order_relaxed);
+    stats.written = s_written.load(std::memory_order_relaxed);
+    stats.dropped = s_dropped.load(std::memory_order_relaxed);
+    stats.merged = s_merged.load(std::memory_order_relaxed);
+    stats.deferred = s_deferred.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void OutputWriter::ResetStats() {
+    s_submitted.store(0, std::memory_order_relaxed);
+    s_written.store(0, std::memory_order_relaxed);
+    s_dropped.store(0, std::memory_order_relaxed);
+    s_merged.store(0, std::memory_order_relaxed);
+    s_deferred.store(0, std::memory_order_relaxed);
+}
+
+//==============================================================================
+// 1 foCX̏ois_pMutex ێČĂԁB܂ۗ truej
+//==============================================================================
+bool OutputWriter::FlushSlot(int slot, Uint64 nowNS, bool force) {
+    DeviceSlot& device = s_slots[slot];
+    bool hasPending = device.pendingLED.load(std::memory_order_acquire) != 0 ||
+        device.pendingRumble.load(std::memory_order_acquire) != 0 ||
+        device.pendingTriggers.load(std::memory_order_acquire) != 0;
+    if (!hasPending) return false;
+
+    if (!force && device.lastWriteNS != 0 &&
+        nowNS - device.lastWriteNS < s_minIntervalNS.load(std::memory_order_relaxed)) {
+        s_deferred.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    SDL_Gamepad* pGamepad = device.pGamepad.load(std::memory_order_relaxed);
+    bool wrote = false;
+
+    Uint32 led = device.pendingLED.exchange(0, std::memory_order_acq_rel);
+    if (led) {
+        if (led != device.writtenLED) {
+            SDL_SetGamepadLED(pGamepad, (led >> 16) & 0xFF, (led >> 8) & 0xFF, led & 0xFF);
+            GC_PROFILE_RECORD(PROFILE_LED_LATENCY, SDL_GetTicksNS() - device.submitNS[OUTPUT_LED].load(std::memory_order_relaxed));
+            device.writtenLED = led;
+            s_written.fetch_add(1, std::memory_order_relaxed);
+            wrote = true;
+        } else {
+            s_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    Uint64 rumble = device.pendingRumble.exchange(0, std::memory_order_acq_rel);
+    if (rumble) {
+        SDL_RumbleGamepad(pGamepad, rumble & 0xFFFF, (rumble >> 16) & 0xFFFF,
+            static_cast<Uint32>((rumble >> 32) & RUMBLE_DURATION_MAX));
+        GC_PROFILE_RECORD(PROFILE_RUMBLE_LATENCY, SDL_GetTicksNS() - device.submitNS[OUTPUT_RUMBLE].load(std::memory_order_relaxed));
+        s_written.fetch_add(1, std::memory_order_relaxed);
+        wrote = true;
+    }
+
+    Uint64 triggers = device.pendingTriggers.exchange(0, std::memory_order_acq_rel);
+    if (triggers) {
+        SDL_RumbleGamepadTriggers(pGamepad, triggers & 0xFFFF, (triggers >> 16) & 0xFFFF,
+            static_cast<Uint32>((triggers >> 32) & RUMBLE_DURATION_MAX));
+        GC_PROFILE_RECORD(PROFILE_RUMBLE_LATENCY, SDL_GetTicksNS() - device.submitNS[OUTPUT_TRIGGERS].load(std::memory_order_relaxed));
+        s_written.fetch_add(1, std::memory_order_relaxed);
+        wrote = true;
+    }
+
+    if (wrote) {
+        device.lastWriteNS = nowNS;
+    }
+    return false;
+}
+
+//==============================================================================
+// [J[Xbh
+//==============================================================================
+int SDLCALL OutputWriter::WorkerMain(void*) {
+    bool anyDeferred = false;
+    while (true) {
+        // [gŕۗĂԂ͒ZԊuŌ
+        if (anyDeferred) {
+            SDL_WaitSemaphoreTimeout(s_pWake, DEFERRED_WAIT_MS);
+        } else {
+            SDL_WaitSemaphore(s_pWake);
+        }
+        while (SDL_TryWaitSemaphore(s_pWake)) {
+        }
+        if (!s_running.load(std::memory_order_acquire)) break;
+
+        SDL_LockMutex(s_pMutex);
+        Uint64 nowNS = SDL_GetTicksNS();
+        anyDeferred = false;
+        for (int i = 0; i < MAX_DEVICES; i++) {
+            if (s_slots[i].pGamepad.load(std::memory_order_acquire)) {
+                anyDeferred |= FlushSlot(i, nowNS, false);
+            }
+        }
+        SDL_UnlockMutex(s_pMutex);
+    }
+    return 0;
+}
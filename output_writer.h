@@ -0,0 +1,57 @@
+/*********************************************************************
+ * \file   output_writer.h
+ * \brief  LEDEȔo̓|[gʃXbhŏށid / [gj
+ *********************************************************************/
+#pragma once
+#include <SDL3/SDL.h>
+
+//==============================================================================
+// o͏݂̓v
+//==============================================================================
+struct OutputWriterStats {
+    Uint32 submitted = 0;   // 󂯕tv
+    Uint32 written = 0;     // ۂɃfoCX֏񂾉
+    Uint32 dropped = 0;     // OƓlȂ̂Ŏ̂Ăv
+    Uint32 merged = 0;      // ݑOɎ̒lŏ㏑ꂽv
+    Uint32 deferred = 0;    // [gŎɉ񂵂
+};
+
+//==============================================================================
+// o͏݃NX
+//------------------------------------------------------------------------------
+// Ăяo͒lqIɒuŁAHID ւ̏݁iBluetooth ł
+// ubNj̓[J[XbhsBfoCXƂɕۗł̂
+// ŐV 1 ŁAݑOɓ͂l͂܂Ƃ߂B
+// LED ͒OɑFƓȂ̂ĂBU͎Ԃ̍XV˂̂Ŏ̂ĂȂB
+// Initialize() / Finalize() ͎QƃJEgtŁAGameController 
+// GamepadManager ̂ǂ炩Ăł悢B
+//==============================================================================
+class OutputWriter {
+public:
+    static constexpr int MAX_DEVICES = 16;
+    static constexpr Uint64 DEFAULT_MIN_INTERVAL_NS = 8 * SDL_NS_PER_MS;
+
+    static bool Initialize();
+    static void Finalize();
+    static bool IsRunning();
+
+    // foCXo^i߂l̓XbgA-1 Ŏsj
+    // Unregister() ͕ۗ̒loĂÔŁAؒf͏҂ƂB
+    static int Register(SDL_Gamepad* pGamepad);
+    static void Unregister(int slot);
+
+    // viubNȂj
+    static bool SubmitLED(int slot, Uint8 r, Uint8 g, Uint8 b);
+    static bool SubmitRumble(int slot, Uint16 low, Uint16 high, Uint32 durationMS);
+    static bool SubmitTriggerRumble(int slot, Uint16 left, Uint16 right, Uint32 durationMS);
+
+    // foCXƂ̍ŏ݊Ԋu
+    static void SetMinInterval(Uint64 intervalNS);
+
+    static OutputWriterStats GetStats();
+    static void ResetStats();
+
+private:
+    static int SDLCALL WorkerMain(void* pUserData);
+    static bool FlushSlot(int slot, Uint64 nowNS, bool force);
+};
@@ -0,0 +1,75 @@
+/*********************************************************************
+ * \file   response_curve.cpp
+ * \brief  XeBbNEgK[̉J[uiSint16 lňbNAbve[uj
+ *********************************************************************/
+#include "response_curve.h"
+
+//==============================================================================
+// wp[
+//==============================================================================
+namespace {
+    float Clamp01(float value) {
+        if (value < 0.0f) return 0.0f;
+        if (value > 1.0f) return 1.0f;
+        return value;
+    }
+
+    // _̐܂i[ (0,0)  (1,1) ₤j
+    float EvaluateCustom(const ResponseCurveSettings& settings, float t) {
+        float prevX = 0.0f;
+        float prevY = 0.0f;
+        for (int i = 0; i <= settings.numPoints; i++) {
+            float x = (i < settings.numPoints) ? settings.pointX[i] : 1.0f;
+            float y = (i < settings.numPoints) ? settings.pointY[i] : 1.0f;
+            if (t <= x) {
+                float span = x - prevX;
+                return (span > 0.0f) ? prevY + (y - prevY) * (t - prevX) / span : y;
+            }
+            prevX = x;
+            prevY = y;
+        }
+        return 1.0f;
+    }
+
+    // ͂̑傫i0 ` 1jo͂̑傫i0 ` 1j߂
+    float Evaluate(const ResponseCurveSettings& settings, float magnitude) {
+        float inner = Clamp01(settings.innerDeadzone);
+        float outer = Clamp01(settings.outerDeadzone);
+        float range = 1.0f - inner - outer;
+
+        if (magnitude <= inner) return 0.0f;
+        if (range <= 0.0f || magnitude >= 1.0f - outer) return 1.0f;
+
+        float t = (magnitude - inner) / range;
+        switch (settings.curve) {
+        case CurveType::Exponential:
+            t = std::pow(t, settings.exponent > 0.0f ? settings.exponent : 1.0f);
+            break;
+        case CurveType::Custom:
+            t = Clamp01(EvaluateCustom(settings, t));
+            break;
+        default:
+            break;
+        }
+
+        float anti = Clamp01(settings.antiDeadzone);
+        return anti + (1.0f - anti) * t;
+    }
+}
+
+//==============================================================================
+// e[u
+//==============================================================================
+void ResponseCurve::Compile(const ResponseCurveSettings& settings) {
+    m_settings = settings;
+    if (m_settings.numPoints < 0) m_settings.numPoints = 0;
+    if (m_settings.numPoints > ResponseCurveSettings::MAX_POINTS) m_settings.numPoints = ResponseCurveSettings::MAX_POINTS;
+
+    // 32767 >> LUT_SHIFT ̓Yŏo͂őɂȂ悤K
+    constexpr float LUT_MAX_INDEX = static_cast<float>(32767 >> LUT_SHIFT);
+    for (int i = 0; i < LUT_SIZE; i++) {
+        float magnitude = Clamp01(static_cast<float>(i) / LUT_MAX_INDEX);
+        float out = Evaluate(m_settings, magnitude);
+        m_table[i] = static_cast<Sint16>(std::lround(out * 32767.0f));
+    }
+}
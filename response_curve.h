@@ -0,0 +1,131 @@
+/*********************************************************************
+ * \file   response_curve.h
+ * \brief  XeBbNEgK[̉J[uiSint16 lňbNAbve[uj
+ *********************************************************************/
+#pragma once
+#include <SDL3/SDL.h>
+#include <cmath>
+
+//==============================================================================
+// fbh][`񋓌^
+//==============================================================================
+enum class DeadzoneShape {
+    Axial,      // Ɓi]̋A΂߂lpȂj
+    Radial      // XeBbŇXʂŔi΂߂~`j
+};
+
+//==============================================================================
+// J[uʗ񋓌^
+//==============================================================================
+enum class CurveType {
+    Linear,
+    Exponential,    // t^exponent
+    Custom          // _̐܂
+};
+
+//==============================================================================
+// J[uݒ\
+//==============================================================================
+struct ResponseCurveSettings {
+    static constexpr int MAX_POINTS = 8;
+
+    DeadzoneShape shape = DeadzoneShape::Axial;    // XeBbN̂ݗL
+    float innerDeadzone = 0.15f;    // ȉ 0
+    float outerDeadzone = 0.0f;     // 1.0 - outerDeadzone ȏ 1
+    float antiDeadzone = 0.0f;      // fbh][𔲂̏o͒l
+    CurveType curve = CurveType::Linear;
+    float exponent = 1.0f;
+
+    // Custom p̐_ix  0 ` 1 ̏A[ (0,0) / (1,1) ₤j
+    int numPoints = 0;
+    float pointX[MAX_POINTS] = {};
+    float pointY[MAX_POINTS] = {};
+
+    // gK[̊l
+    static ResponseCurveSettings Trigger() {
+        ResponseCurveSettings settings;
+        settings.innerDeadzone = 0.0f;
+        return settings;
+    }
+};
+
+//==============================================================================
+// J[uiRpCς݃e[uj
+//------------------------------------------------------------------------------
+// |l| >> LUT_SHIFT YɂāAo͂̑傫i0 ` 32767jB
+//==============================================================================
+class ResponseCurve {
+public:
+    static constexpr int LUT_SHIFT = 4;
+    static constexpr int LUT_SIZE = (32768 >> LUT_SHIFT) + 1;
+
+    ResponseCurve() { Compile(ResponseCurveSettings()); }
+    explicit ResponseCurve(const ResponseCurveSettings& settings) { Compile(settings); }
+
+    void Compile(const ResponseCurveSettings& settings);
+    const ResponseCurveSettings& GetSettings() const { return m_settings; }
+
+    // 1 itj
+    Sint16 ApplyAxis(Sint16 value) const {
+        int magnitude = (value < 0) ? -static_cast<int>(value) : value;
+        int out = m_table[magnitude >> LUT_SHIFT];
+        return static_cast<Sint16>((value < 0) ? -out : out);
+    }
+
+    // XeBbN 2 i`ɉĎ / aj
+    void ApplyStick(Sint16 x, Sint16 y, Sint16* pOutX, Sint16* pOutY) const {
+        if (m_settings.shape == DeadzoneShape::Axial) {
+            *pOutX = ApplyAxis(x);
+            *pOutY = ApplyAxis(y);
+            return;
+        }
+
+        float fx = static_cast<float>(x);
+        float fy = static_cast<float>(y);
+        float magnitude = std::sqrt(fx * fx + fy * fy);
+        int index = static_cast<int>(magnitude) >> LUT_SHIFT;
+        index = (index < LUT_SIZE - 1) ? index : LUT_SIZE - 1;
+        float scale = (magnitude > 0.0f) ? m_table[index] / magnitude : 0.0f;
+        *pOutX = ClampToSint16(fx * scale);
+        *pOutY = ClampToSint16(fy * scale);
+    }
+
+    // gK[i̒l 0 j
+    Sint16 ApplyTrigger(Sint16 value) const {
+        return (value > 0) ? m_table[value >> LUT_SHIFT] : 0;
+    }
+
+    static float ToFloat(Sint16 value) {
+        float v = static_cast<float>(value) / 32767.0f;
+        return (v < -1.0f) ? -1.0f : v;
+    }
+
+private:
+    static Sint16 ClampToSint16(float value) {
+        if (value > 32767.0f) return 32767;
+        if (value < -32767.0f) return -32767;
+        return static_cast<Sint16>(value);
+    }
+
+    ResponseCurveSettings m_settings;
+    Sint16 m_table[LUT_SIZE];
+};
+
+//==============================================================================
+// 1 foCX̉J[u
+//==============================================================================
+struct ResponseCurveSet {
+    ResponseCurve leftStick;
+    ResponseCurve rightStick;
+    ResponseCurve triggers{ ResponseCurveSettings::Trigger() };
+
+    // 6 iSDL_GamepadAxis j܂Ƃ߂ď
+    void Process(const Sint16* pRaw, Sint16* pOut) const {
+        leftStick.ApplyStick(pRaw[SDL_GAMEPAD_AXIS_LEFTX], pRaw[SDL_GAMEPAD_AXIS_LEFTY],
+            &pOut[SDL_GAMEPAD_AXIS_LEFTX], &pOut[SDL_GAMEPAD_AXIS_LEFTY]);
+        rightStick.ApplyStick(pRaw[SDL_GAMEPAD_AXIS_RIGHTX], pRaw[SDL_GAMEPAD_AXIS_RIGHTY],
+            &pOut[SDL_GAMEPAD_AXIS_RIGHTX], &pOut[SDL_GAMEPAD_AXIS_RIGHTY]);
+        pOut[SDL_GAMEPAD_AXIS_LEFT_TRIGGER] = triggers.ApplyTrigger(pRaw[SDL_GAMEPAD_AXIS_LEFT_TRIGGER]);
+        pOut[SDL_GAMEPAD_AXIS_RIGHT_TRIGGER] = triggers.ApplyTrigger(pRaw[SDL_GAMEPAD_AXIS_RIGHT_TRIGGER]);
+    }
+};
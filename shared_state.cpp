@@ -0,0 +1,138 @@
+/*********************************************************************
+ * \file   shared_state.cpp
+ * \brief  Rg[[Ԃ̋L`ivZXԂœǂݏj
+ *********************************************************************/
+#include "shared_state.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//==============================================================================
+// O
+//==============================================================================
+bool SharedMemoryMapping::MakeSystemName(const char* pName) {
+    if (!pName || !*pName || SDL_strlen(pName) > SharedStateFormat::MAX_NAME_LENGTH) return false;
+#ifdef _WIN32
+    SDL_snprintf(m_systemName, sizeof(m_systemName), "Local\\%s", pName);
+#else
+    SDL_snprintf(m_systemName, sizeof(m_systemName), "/%s", pName);
+#endif
+    return true;
+}
+
+//==============================================================================
+// 쐬
+//==============================================================================
+bool SharedMemoryMapping::Create(const char* pName, size_t size) {
+    Close();
+    if (!MakeSystemName(pName)) return false;
+
+#ifdef _WIN32
+    HANDLE hMapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+        0, static_cast<DWORD>(size), m_systemName);
+    if (!hMapping) return false;
+    if (GetLastError() == ERROR_ALREADY_EXISTS) {
+        // ʂ̏ݑĂ
+        CloseHandle(hMapping);
+        return false;
+    }
+
+    void* pView = MapViewOfFile(hMapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!pView) {
+        CloseHandle(hMapping);
+        return false;
+    }
+    m_hMapping = hMapping;
+#else
+    // ɂΕʂ̏ݑĂ̂ŎsiWindows ƓjB
+    // ُIŖOcꍇȂi/dev/shm ̂͗p҂̔fj
+    int fd = shm_open(m_systemName, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) return false;
+
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        shm_unlink(m_systemName);
+        return false;
+    }
+
+    void* pView = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (pView == MAP_FAILED) {
+        shm_unlink(m_systemName);
+        return false;
+    }
+#endif
+
+    m_pData = pView;
+    m_size = size;
+    m_owner = true;
+    return true;
+}
+
+//==============================================================================
+// Jiǂݎpj
+//==============================================================================
+bool SharedMemoryMapping::Open(const char* pName, size_t size) {
+    Close();
+    if (!MakeSystemName(pName)) return false;
+
+#ifdef _WIN32
+    HANDLE hMapping = OpenFileMappingA(FILE_MAP_READ, FALSE, m_systemName);
+    if (!hMapping) return false;
+
+    void* pView = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, size);
+    if (!pView) {
+        CloseHandle(hMapping);
+        return false;
+    }
+    m_hMapping = hMapping;
+#else
+    int fd = shm_open(m_systemName, O_RDONLY, 0);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < size) {
+        close(fd);
+        return false;
+    }
+
+    void* pView = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (pView == MAP_FAILED) return false;
+#endif
+
+    m_pData = pView;
+    m_size = size;
+    m_owner = false;
+    return true;
+}
+
+//==============================================================================
+// 
+//==============================================================================
+void SharedMemoryMapping::Close() {
+    if (!m_pData) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_pData);
+    CloseHandle(static_cast<HANDLE>(m_hMapping));
+#else
+    munmap(m_pData, m_size);
+    if (m_owner) {
+        shm_unlink(m_systemName);
+    }
+#endif
+
+    m_pData = nullptr;
+    m_size = 0;
+    m_hMapping = nullptr;
+    m_owner = false;
+}
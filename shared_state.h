@@ -0,0 +1,106 @@
+/*********************************************************************
+ * \file   shared_state.h
+ * \brief  Rg[[Ԃ̋L`ivZXԂœǂݏj
+ *********************************************************************/
+#pragma once
+#include "game_controller.h"
+#include <atomic>
+#include <cstddef>
+
+//==============================================================================
+// Ľ`
+//------------------------------------------------------------------------------
+//  Header
+//  Slot ~ MAX_SLOTSiXbgԍ DeviceRegistry Ɠj
+// ݂ 1 vZXiStatePublisherĵ݁Aǂݍ݂͉vZXł悢B
+// Xbg̓V[PXbNŎiݒ sequence jB
+// ͏ݑ SDL_GetTicksNS Ȃ̂ŁAǂݍݑł͊ԊuɂgƁB
+//==============================================================================
+namespace SharedStateFormat {
+    constexpr Uint32 MAGIC = 0x53534347;    // "GCSS"
+    constexpr Uint32 VERSION = 1;
+    constexpr int MAX_SLOTS = DeviceRegistry::MAX_SLOTS;
+
+    // POSIX ł "/" + OAWindows ł "Local\" + OŊJ
+    constexpr const char* DEFAULT_NAME = "gamecontroller_state";
+    constexpr size_t MAX_NAME_LENGTH = 64;
+
+    // XbgɊ܂܂ubN
+    constexpr Uint32 FLAG_SENSOR = 1u << 0;
+    constexpr Uint32 FLAG_TOUCHPAD = 1u << 1;
+    constexpr Uint32 FLAG_BATTERY = 1u << 2;
+
+    // BatteryInfo ̓|C^܂ނ̂ŕ񂲂Ǝ
+    struct Battery {
+        Uint8 isWired;
+        Uint8 hasBatteryInfo;
+        Sint16 percent;
+        char levelText[12];
+    };
+
+    struct SlotData {
+        Uint64 timestampNS;
+        Uint32 frame;
+        Uint32 flags;
+        SDL_JoystickID id;
+        ControllerType type;
+        char name[128];
+        GamepadState state;
+        SensorData sensor;
+        TouchpadData touchpad;
+        Battery battery;
+    };
+
+    struct alignas(64) Slot {
+        std::atomic<Uint32> sequence;
+        SlotData data;
+    };
+
+    struct alignas(64) Header {
+        Uint32 magic;
+        Uint32 version;
+        Uint32 slotCount;
+        Uint32 slotSize;
+        std::atomic<Uint32> connectedSlots;
+        std::atomic<Uint32> frame;          // ݑXV邽тɐi
+    };
+
+    struct Segment {
+        Header header;
+        Slot slots[MAX_SLOTS];
+    };
+
+    // ǂݍݑ͓ǂݎp map ̂ŁAbN̗vȂAg~bNg
+    static_assert(ATOMIC_INT_LOCK_FREE == 2, "shared memory requires lock-free 32-bit atomics");
+}
+
+//==============================================================================
+// OtLiPOSIX: shm_open + mmap / Windows: t@C}bsOj
+//==============================================================================
+class SharedMemoryMapping {
+public:
+    SharedMemoryMapping() = default;
+    ~SharedMemoryMapping() { Close(); }
+    SharedMemoryMapping(const SharedMemoryMapping&) = delete;
+    SharedMemoryMapping& operator=(const SharedMemoryMapping&) = delete;
+
+    // 쐬iǂݏAƂɖOBOɂΎsj
+    bool Create(const char* pName, size_t size);
+
+    // ̂̂JiǂݎpAsize Ȃ玸sj
+    bool Open(const char* pName, size_t size);
+
+    void Close();
+    bool IsOpen() const { return m_pData != nullptr; }
+    void* GetData() const { return m_pData; }
+    size_t GetSize() const { return m_size; }
+
+private:
+    bool MakeSystemName(const char* pName);
+
+    void* m_pData = nullptr;
+    size_t m_size = 0;
+    void* m_hMapping = nullptr;
+    bool m_owner = false;
+    char m_systemName[SharedStateFormat::MAX_NAME_LENGTH + 8] = {};
+};
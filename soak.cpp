@@ -0,0 +1,475 @@
+/*********************************************************************
+ * \file   soak.cpp
+ * \brief  ƃCxg^̑ϋveXgiSDL zWCXeBbNgp / wbhXj
+ *
+ * g: soak [--seconds N] [--pads N] [--churn N] [--flood N] [--seed N] [--json PATH]
+ *   ő N ̉zQ[pbh𖈕b churn ̊ŐڑEؒfȂA
+ *   ڑ̑Spbhփ{^EEZT[E^b` 1 t[ flood 񑗂葱B
+ *   GameController::Update() ̂тɕsϏmFAᔽΏIR[h 1 ԂB
+ *
+ * sϏ
+ *   stale_id         JĂ ID ؒfς / SDL ̃nhƈvȂ
+ *   missed_open      ڑ̃pbĥɂǂJĂȂ
+ *   registry         o^\̐ڑXbgƎۂɐڑ̃pbhHႤ
+ *   phantom_press    ĂȂ{^ĂiĐڑ܂ށj
+ *   leaked_gamepad   ؒfpbh SDL_Gamepad ĂȂ
+ *   lost_tap         Update() ̑O ProcessEvent() œnė삪GbWɎcȂ
+ *                    iCxg[ĥ݁j
+ *********************************************************************/
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "game_controller.h"
+
+//==============================================================================
+// 萔Eݒ
+//==============================================================================
+namespace {
+    constexpr int MAX_PADS = DeviceRegistry::MAX_SLOTS;
+    constexpr int IDENTITY_COUNT = MAX_PADS * 2;     // ĐڑN GUID g
+    constexpr int MAX_PENDING_DETACH = 1024;
+    constexpr int MAX_REPORTED_VIOLATIONS = 16;
+
+    // 1 t[Ŕit[xꂽƂɉ񐔂c܂Ȃ悤Ɂj
+    constexpr int MAX_CHURN_PER_FRAME = 64;
+
+    // SDL ̃{^ׂiL2/R2 ͎̂ŏj
+    constexpr uint32_t SDL_BUTTON_BITS = (1u << (SDL_GAMEPAD_BUTTON_MISC1 + 1)) - 1;
+
+    struct Options {
+        double seconds = 10.0;
+        int maxPads = 4;
+        int churnPerSec = 400;
+        int flood = 8;
+        Uint32 seed = 1;
+        const char* pJsonPath = nullptr;
+    };
+
+    enum Violation {
+        VIOLATION_STALE_ID,
+        VIOLATION_MISSED_OPEN,
+        VIOLATION_REGISTRY,
+        VIOLATION_PHANTOM_PRESS,
+        VIOLATION_LEAKED_GAMEPAD,
+        VIOLATION_LOST_TAP,
+        VIOLATION_COUNT
+    };
+
+    const char* const VIOLATION_NAMES[VIOLATION_COUNT] = {
+        "stale_id", "missed_open", "registry", "phantom_press", "leaked_gamepad", "lost_tap",
+    };
+
+    // zpbh
+    struct VirtualPad {
+        SDL_JoystickID id = 0;
+        SDL_Joystick* pJoystick = nullptr;
+        int identity = 0;
+        uint32_t buttons = 0;       // Ă SDL {^irbgʒu = SDL_GamepadButtonj
+        bool fingerDown = false;
+    };
+
+    // v
+    struct Stats {
+        Uint64 frames = 0;
+        Uint64 attaches = 0;
+        Uint64 detaches = 0;
+        Uint64 reopens = 0;
+        Uint64 eventsSent = 0;
+        Uint64 samplesProcessed = 0;
+        Uint64 updateTotalNS = 0;
+        Uint64 updateMaxNS = 0;
+        Uint64 elapsedNS = 0;
+        Uint64 violations[VIOLATION_COUNT] = {};
+    };
+
+    VirtualPad g_pads[MAX_PADS];
+    int g_padCount = 0;
+    SDL_JoystickID g_pendingDetach[MAX_PENDING_DETACH];
+    int g_pendingDetachCount = 0;
+    Stats g_stats;
+    int g_reportedViolations = 0;
+    Uint32 g_random = 1;
+}
+
+//==============================================================================
+// ixorshift32AČł悤 seed włj
+//==============================================================================
+namespace {
+    Uint32 NextRandom() {
+        g_random ^= g_random << 13;
+        g_random ^= g_random >> 17;
+        g_random ^= g_random << 5;
+        return g_random;
+    }
+
+    int RandomRange(int count) {
+        return static_cast<int>(NextRandom() % static_cast<Uint32>(count));
+    }
+
+    float RandomUnit() {
+        return static_cast<float>(NextRandom() & 0xFFFF) / 65535.0f;
+    }
+}
+
+//==============================================================================
+// ᔽ̋L^
+//==============================================================================
+namespace {
+    void ReportViolation(Violation violation, const char* pFormat, SDL_JoystickID id, Uint32 value) {
+        g_stats.violations[violation]++;
+        if (g_reportedViolations++ >= MAX_REPORTED_VIOLATIONS) return;
+
+        char message[128];
+        SDL_snprintf(message, sizeof(message), pFormat, static_cast<unsigned>(id), static_cast<unsigned>(value));
+        fprintf(stderr, "frame %llu: %s: %s\n",
+            static_cast<unsigned long long>(g_stats.frames), VIOLATION_NAMES[violation], message);
+    }
+}
+
+//==============================================================================
+// zpbh̐ڑEؒfE
+//==============================================================================
+namespace {
+    const SDL_VirtualJoystickSensorDesc SENSOR_DESCS[] = {
+        { SDL_SENSOR_GYRO, 1000.0f },
+        { SDL_SENSOR_ACCEL, 1000.0f },
+    };
+    const SDL_VirtualJoystickTouchpadDesc TOUCHPAD_DESCS[] = {
+        { 2, { 0, 0, 0 } },
+    };
+
+    bool AttachPad(int identity) {
+        if (g_padCount >= MAX_PADS) return false;
+
+        SDL_VirtualJoystickDesc desc;
+        SDL_INIT_INTERFACE(&desc);
+        desc.type = SDL_JOYSTICK_TYPE_GAMEPAD;
+        desc.naxes = SDL_GAMEPAD_AXIS_COUNT;
+        desc.nbuttons = SDL_GAMEPAD_BUTTON_COUNT;
+        desc.ntouchpads = SDL_arraysize(TOUCHPAD_DESCS);
+        desc.touchpads = TOUCHPAD_DESCS;
+        desc.nsensors = SDL_arraysize(SENSOR_DESCS);
+        desc.sensors = SENSOR_DESCS;
+        desc.vendor_id = 0x1234;
+        desc.product_id = static_cast<Uint16>(0x2000 + identity);
+        desc.name = "Soak Virtual Pad";
+
+        VirtualPad pad;
+        pad.identity = identity;
+        pad.id = SDL_AttachVirtualJoystick(&desc);
+        if (!pad.id) return false;
+
+        pad.pJoystick = SDL_OpenJoystick(pad.id);
+        if (!pad.pJoystick) {
+            SDL_DetachVirtualJoystick(pad.id);
+            return false;
+        }
+
+        g_pads[g_padCount++] = pad;
+        g_stats.attaches++;
+        return true;
+    }
+
+    void DetachPad(int index) {
+        VirtualPad& pad = g_pads[index];
+        SDL_CloseJoystick(pad.pJoystick);
+        SDL_DetachVirtualJoystick(pad.id);
+
+        if (g_pendingDetachCount < MAX_PENDING_DETACH) {
+            g_pendingDetach[g_pendingDetachCount++] = pad.id;
+        }
+        g_pads[index] = g_pads[--g_padCount];
+        g_stats.detaches++;
+    }
+
+    // ڑłȂ GUID Iԁiؒfς݂̂̂Iׂ΍ĐڑɂȂj
+    int PickIdentity() {
+        for (;;) {
+            int identity = RandomRange(IDENTITY_COUNT);
+            bool used = false;
+            for (int i = 0; i < g_padCount; i++) {
+                if (g_pads[i].identity == identity) used = true;
+            }
+            if (!used) return identity;
+        }
+    }
+
+    // tȂؒfAȂڑAȊO͔X
+    void Churn(int maxPads) {
+        bool detach = (g_padCount >= maxPads) || (g_padCount > 0 && (NextRandom() & 1));
+        if (detach) {
+            DetachPad(RandomRange(g_padCount));
+        } else {
+            AttachPad(PickIdentity());
+        }
+    }
+
+    // _ȓ́i{^ 2 ̐؂ւE 2 {EZT[E^b`j
+    void DrivePad(VirtualPad* pPad) {
+        for (int i = 0; i < 2; i++) {
+            int button = RandomRange(SDL_GAMEPAD_BUTTON_MISC1 + 1);
+            bool down = (NextRandom() & 1) != 0;
+            SDL_SetJoystickVirtualButton(pPad->pJoystick, button, down);
+            pPad->buttons = down ? (pPad->buttons | (1u << button)) : (pPad->buttons & ~(1u << button));
+        }
+
+        for (int i = 0; i < 2; i++) {
+            int axis = RandomRange(SDL_GAMEPAD_AXIS_COUNT);
+            SDL_SetJoystickVirtualAxis(pPad->pJoystick, axis, static_cast<Sint16>(NextRandom() & 0xFFFF));
+        }
+
+        Uint64 timestampNS = SDL_GetTicksNS();
+        float gyro[3] = { RandomUnit() - 0.5f, RandomUnit() - 0.5f, RandomUnit() - 0.5f };
+        float accel[3] = { 0.0f, -SDL_STANDARD_GRAVITY, RandomUnit() };
+        SDL_SendJoystickVirtualSensorData(pPad->pJoystick, SDL_SENSOR_GYRO, timestampNS, gyro, 3);
+        SDL_SendJoystickVirtualSensorData(pPad->pJoystick, SDL_SENSOR_ACCEL, timestampNS, accel, 3);
+
+        pPad->fingerDown = (NextRandom() % 4) != 0;
+        SDL_SetJoystickVirtualTouchpad(pPad->pJoystick, 0, 0, pPad->fingerDown, RandomUnit(), RandomUnit(), 1.0f);
+
+        g_stats.eventsSent += 2 + 2 + 2 + 1;
+    }
+
+    const VirtualPad* FindPad(SDL_JoystickID id) {
+        for (int i = 0; i < g_padCount; i++) {
+            if (g_pads[i].id == id) return &g_pads[i];
+        }
+        return nullptr;
+    }
+}
+
+//==============================================================================
+// ̃ReLXgnꂽCxgiė Update() ̑O ProcessEvent() ցj
+//==============================================================================
+namespace {
+    // {^̃}XNiȂ 0j
+    uint32_t ForwardTap() {
+        const SdlControllerBackend& backend = GameController::GetDefault().GetBackend();
+        if (!backend.IsOpen()) return 0;
+
+        // ĂȂ{^IԁiĂƉj
+        int button = RandomRange(SDL_GAMEPAD_BUTTON_MISC1 + 1);
+        uint32_t mask = 1u << button;
+        if (GameController::GetButtons() & mask) return 0;
+
+        SDL_Event event = {};
+        event.gbutton.which = backend.GetId();
+        event.gbutton.button = static_cast<Uint8>(button);
+        event.gbutton.timestamp = SDL_GetTicksNS();
+
+        event.type = SDL_EVENT_GAMEPAD_BUTTON_DOWN;
+        event.gbutton.down = true;
+        GameController::ProcessEvent(event);
+
+        event.type = SDL_EVENT_GAMEPAD_BUTTON_UP;
+        event.gbutton.down = false;
+        GameController::ProcessEvent(event);
+        return mask;
+    }
+
+    void CheckForwardedTap(uint32_t mask) {
+        if (!mask) return;
+        const GamepadState& state = GameController::GetDefault().GetCurrentState();
+        if (!(state.triggered & mask) || !(state.released & mask)) {
+            ReportViolation(VIOLATION_LOST_TAP, "id %u button 0x%x", GameController::GetDefault().GetBackend().GetId(), mask);
+        }
+    }
+}
+
+//==============================================================================
+// sϏ̊mFiUpdate() ̒ACxgׂ͂ďς݁j
+//==============================================================================
+namespace {
+    void CheckInvariants() {
+        const SdlControllerBackend& backend = GameController::GetDefault().GetBackend();
+        SDL_JoystickID openId = backend.GetId();
+
+        // JĂfoCX
+        if (backend.IsOpen()) {
+            const VirtualPad* pPad = FindPad(openId);
+            if (!pPad) {
+                ReportViolation(VIOLATION_STALE_ID, "id %u is open but detached (%u)", openId, 0);
+            } else if (SDL_GetGamepadFromID(openId) != backend.GetGamepad()) {
+                ReportViolation(VIOLATION_STALE_ID, "id %u handle mismatch (%u)", openId, 0);
+            } else {
+                uint32_t phantom = GameController::GetButtons() & SDL_BUTTON_BITS & ~pPad->buttons;
+                if (phantom) {
+                    ReportViolation(VIOLATION_PHANTOM_PRESS, "id %u buttons 0x%x not held", openId, phantom);
+                }
+            }
+        } else {
+            if (openId != 0) {
+                ReportViolation(VIOLATION_STALE_ID, "closed but id %u remains (%u)", openId, 0);
+            }
+            if (g_padCount > 0) {
+                ReportViolation(VIOLATION_MISSED_OPEN, "nothing open (id %u) with %u pads", 0, g_padCount);
+            }
+            if (GameController::GetButtons() != 0) {
+                ReportViolation(VIOLATION_PHANTOM_PRESS, "closed (id %u) buttons 0x%x", 0, GameController::GetButtons());
+            }
+        }
+
+        // o^\iڑXbgƊeXbg IDj
+        const DeviceRegistry& registry = backend.GetRegistry();
+        int connected = 0;
+        for (int slot = 0; slot < DeviceRegistry::MAX_SLOTS; slot++) {
+            if (!registry.IsConnected(slot)) continue;
+            connected++;
+            if (!FindPad(registry.GetId(slot))) {
+                ReportViolation(VIOLATION_REGISTRY, "slot holds detached id %u (slot %u)", registry.GetId(slot), slot);
+            }
+        }
+        if (connected != g_padCount) {
+            ReportViolation(VIOLATION_REGISTRY, "connected slots %u, attached %u", connected, g_padCount);
+        }
+
+        // ؒfpbh SDL_Gamepad cĂȂ
+        for (int i = 0; i < g_pendingDetachCount; i++) {
+            if (SDL_GetGamepadFromID(g_pendingDetach[i])) {
+                ReportViolation(VIOLATION_LEAKED_GAMEPAD, "id %u still open (%u)", g_pendingDetach[i], 0);
+            }
+        }
+        g_pendingDetachCount = 0;
+    }
+}
+
+//==============================================================================
+// 1 [h̎s
+//==============================================================================
+static void RunSoak(const Options& options, InputMode mode) {
+    if (!GameController::Initialize()) {
+        fprintf(stderr, "GameController::Initialize failed: %s\n", SDL_GetError());
+        return;
+    }
+    GameController::SetInputMode(mode);
+
+    Uint64 durationNS = static_cast<Uint64>(options.seconds * 0.5 * 1e9);
+    Uint64 startNS = SDL_GetTicksNS();
+    Uint64 prevNS = startNS;
+    double churnBudget = 0.0;
+
+    for (;;) {
+        Uint64 nowNS = SDL_GetTicksNS();
+        if (nowNS - startNS >= durationNS) break;
+
+        // oߎԂɉ񐔂
+        churnBudget += static_cast<double>(nowNS - prevNS) * 1e-9 * options.churnPerSec;
+        churnBudget = std::min(churnBudget, static_cast<double>(MAX_CHURN_PER_FRAME));
+        prevNS = nowNS;
+        while (churnBudget >= 1.0) {
+            Churn(options.maxPads);
+            churnBudget -= 1.0;
+        }
+
+        // ͂^̂悤ɑifoCXXVăCxgςށj
+        for (int i = 0; i < options.flood; i++) {
+            for (int pad = 0; pad < g_padCount; pad++) DrivePad(&g_pads[pad]);
+            SDL_UpdateJoysticks();
+        }
+
+        SDL_JoystickID prevId = GameController::GetDefault().GetBackend().GetId();
+        uint32_t forwardedTap = (mode == InputMode::Event) ? ForwardTap() : 0;
+
+        Uint64 updateStart = SDL_GetTicksNS();
+        GameController::Update();
+        Uint64 updateNS = SDL_GetTicksNS() - updateStart;
+
+        g_stats.updateTotalNS += updateNS;
+        g_stats.updateMaxNS = std::max(g_stats.updateMaxNS, updateNS);
+        g_stats.samplesProcessed += GameController::GetFrameSampleCount() +
+            GameController::GetSensorSampleCount() + GameController::GetTouchSampleCount();
+        if (GameController::GetDefault().GetBackend().GetId() != prevId) g_stats.reopens++;
+        g_stats.frames++;
+
+        // JȂ瑗Cxg͕ʂ̃foCX
+        if (GameController::GetDefault().GetBackend().GetId() == prevId) CheckForwardedTap(forwardedTap);
+        CheckInvariants();
+    }
+    g_stats.elapsedNS += SDL_GetTicksNS() - startNS;
+
+    // SOĂIAŌ̏ԂmF
+    while (g_padCount > 0) DetachPad(g_padCount - 1);
+    GameController::Update();
+    CheckInvariants();
+    GameController::Finalize();
+}
+
+//==============================================================================
+// ʏo
+//==============================================================================
+static Uint64 TotalViolations() {
+    Uint64 total = 0;
+    for (int i = 0; i < VIOLATION_COUNT; i++) total += g_stats.violations[i];
+    return total;
+}
+
+static void WriteJson(FILE* pFile, const Options& options) {
+    double seconds = static_cast<double>(g_stats.elapsedNS) * 1e-9;
+    double perSec = (seconds > 0.0) ? 1.0 / seconds : 0.0;
+
+    fprintf(pFile, "{\n");
+    fprintf(pFile, "  \"platform\": \"%s\",\n", SDL_GetPlatform());
+    fprintf(pFile, "  \"seed\": %u,\n", static_cast<unsigned>(options.seed));
+    fprintf(pFile, "  \"seconds\": %.2f,\n", seconds);
+    fprintf(pFile, "  \"frames\": %llu,\n", static_cast<unsigned long long>(g_stats.frames));
+    fprintf(pFile, "  \"attaches_per_sec\": %.1f,\n", g_stats.attaches * perSec);
+    fprintf(pFile, "  \"detaches_per_sec\": %.1f,\n", g_stats.detaches * perSec);
+    fprintf(pFile, "  \"reopens\": %llu,\n", static_cast<unsigned long long>(g_stats.reopens));
+    fprintf(pFile, "  \"events_sent_per_sec\": %.1f,\n", g_stats.eventsSent * perSec);
+    fprintf(pFile, "  \"samples_processed_per_sec\": %.1f,\n", g_stats.samplesProcessed * perSec);
+    fprintf(pFile, "  \"update_ns_avg\": %.1f,\n",
+        g_stats.frames ? static_cast<double>(g_stats.updateTotalNS) / g_stats.frames : 0.0);
+    fprintf(pFile, "  \"update_ns_max\": %llu,\n", static_cast<unsigned long long>(g_stats.updateMaxNS));
+    fprintf(pFile, "  \"violations\": {");
+    for (int i = 0; i < VIOLATION_COUNT; i++) {
+        fprintf(pFile, "%s \"%s\": %llu", i ? "," : "", VIOLATION_NAMES[i],
+            static_cast<unsigned long long>(g_stats.violations[i]));
+    }
+    fprintf(pFile, " }\n");
+    fprintf(pFile, "}\n");
+}
+
+//==============================================================================
+// Gg|Cg
+//==============================================================================
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--seconds") && i + 1 < argc) {
+            options.seconds = std::max(0.1, atof(argv[++i]));
+        } else if (!strcmp(argv[i], "--pads") && i + 1 < argc) {
+            options.maxPads = std::max(1, std::min(MAX_PADS, atoi(argv[++i])));
+        } else if (!strcmp(argv[i], "--churn") && i + 1 < argc) {
+            options.churnPerSec = std::max(0, atoi(argv[++i]));
+        } else if (!strcmp(argv[i], "--flood") && i + 1 < argc) {
+            options.flood = std::max(1, atoi(argv[++i]));
+        } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+            options.seed = static_cast<Uint32>(strtoul(argv[++i], nullptr, 10));
+        } else if (!strcmp(argv[i], "--json") && i + 1 < argc) {
+            options.pJsonPath = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--seconds N] [--pads N] [--churn N] [--flood N] [--seed N] [--json PATH]\n", argv[0]);
+            return 1;
+        }
+    }
+    g_random = options.seed ? options.seed : 1;
+
+    // Ԃ𔼕|[OƃCxgɎg
+    RunSoak(options, InputMode::Polling);
+    RunSoak(options, InputMode::Event);
+
+    FILE* pFile = stdout;
+    if (options.pJsonPath) {
+        pFile = fopen(options.pJsonPath, "w");
+        if (!pFile) {
+            fprintf(stderr, "cannot open %s\n", options.pJsonPath);
+            return 1;
+        }
+    }
+    WriteJson(pFile, options);
+    if (pFile != stdout) fclose(pFile);
+
+    SDL_Quit();
+    return TotalViolations() ? 1 : 0;
+}
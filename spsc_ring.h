@@ -0,0 +1,57 @@
+/*********************************************************************
+ * \file   spsc_ring.h
+ * \brief  PꐶYҁEP҂̃bNt[Oobt@
+ *********************************************************************/
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+//==============================================================================
+// SPSC Oobt@
+//------------------------------------------------------------------------------
+// Push() ͐Y҃Xbĥ݁APop() / Clear() ͏҃Xbĥ݂ĂԂƁB
+// eʂ 2 ׂ̂iۂɊi[ł̂ CAPACITY jB
+//==============================================================================
+template<typename T, size_t CAPACITY>
+class SpscRing {
+    static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+
+public:
+    // ǉitȂ falsej
+    bool Push(const T& item) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        size_t tail = m_tail.load(std::memory_order_acquire);
+        if (head - tail >= CAPACITY) return false;
+
+        m_items[head & (CAPACITY - 1)] = item;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // oiȂ falsej
+    bool Pop(T& out) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        size_t head = m_head.load(std::memory_order_acquire);
+        if (tail == head) return false;
+
+        out = m_items[tail & (CAPACITY - 1)];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // ܂ĂvfׂĎ̂Ă
+    void Clear() {
+        m_tail.store(m_head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    size_t Size() const {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+    bool IsEmpty() const { return Size() == 0; }
+
+private:
+    alignas(64) std::atomic<size_t> m_head{ 0 };  // ݈ʒuiYҁj
+    alignas(64) std::atomic<size_t> m_tail{ 0 };  // ǂݏoʒuiҁj
+    alignas(64) T m_items[CAPACITY];
+};
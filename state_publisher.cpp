@@ -0,0 +1,164 @@
+/*********************************************************************
+ * \file   state_publisher.cpp
+ * \brief  Rg[[ԂL֏oivZX̕\EL^c[j
+ *********************************************************************/
+#include "state_publisher.h"
+#include "gamepad_manager.h"
+#include <cstring>
+#include <new>
+
+using namespace SharedStateFormat;
+
+//==============================================================================
+// 
+//==============================================================================
+namespace {
+    SharedMemoryMapping s_mapping;
+    Segment* s_pSegment = nullptr;
+    Uint32 s_publishedSlots = 0;
+    Uint32 s_frame = 0;
+
+    // ݒ sequence ɂ
+    void WriteSlot(Slot& slot, const SlotData& data) {
+        Uint32 sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&slot.data, &data, sizeof(SlotData));
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+    }
+}
+
+//==============================================================================
+// JE
+//==============================================================================
+bool StatePublisher::Open(const char* pName) {
+    Close();
+
+    if (!s_mapping.Create(pName, sizeof(Segment))) return false;
+
+    s_pSegment = new (s_mapping.GetData()) Segment();
+    Header& header = s_pSegment->header;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.slotCount = MAX_SLOTS;
+    header.slotSize = sizeof(Slot);
+    header.connectedSlots.store(0, std::memory_order_relaxed);
+
+    // ǂݍݑ frame ǂłwb_[m߂
+    header.frame.store(0, std::memory_order_release);
+    s_publishedSlots = 0;
+    s_frame = 0;
+    return true;
+}
+
+void StatePublisher::Close() {
+    if (!s_pSegment) return;
+
+    s_pSegment->header.connectedSlots.store(0, std::memory_order_release);
+    s_pSegment = nullptr;
+    s_mapping.Close();
+    s_publishedSlots = 0;
+}
+
+bool StatePublisher::IsOpen() {
+    return s_pSegment != nullptr;
+}
+
+//==============================================================================
+// XbgPʂ̏o
+//==============================================================================
+void StatePublisher::Publish(int slot, const SlotData& data) {
+    if (!s_pSegment || slot < 0 || slot >= MAX_SLOTS) return;
+
+    WriteSlot(s_pSegment->slots[slot], data);
+    s_publishedSlots |= (1u << slot);
+    s_pSegment->header.connectedSlots.store(s_publishedSlots, std::memory_order_release);
+}
+
+void StatePublisher::Unpublish(int slot) {
+    if (!s_pSegment || slot < 0 || slot >= MAX_SLOTS) return;
+    if (!(s_publishedSlots & (1u << slot))) return;
+
+    SlotData data = {};
+    WriteSlot(s_pSegment->slots[slot], data);
+    s_publishedSlots &= ~(1u << slot);
+    s_pSegment->header.connectedSlots.store(s_publishedSlots, std::memory_order_release);
+}
+
+SharedStateFormat::Battery StatePublisher::MakeBattery(const BatteryInfo& info) {
+    Battery battery = {};
+    battery.isWired = info.isWired ? 1 : 0;
+    battery.hasBatteryInfo = info.hasBatteryInfo ? 1 : 0;
+    battery.percent = static_cast<Sint16>(info.percent);
+    SDL_strlcpy(battery.levelText, info.levelText ? info.levelText : "", sizeof(battery.levelText));
+    return battery;
+}
+
+// 񏑂oȂXbgāAt[i߂
+void StatePublisher::EndFrame(Uint32 connectedSlots) {
+    Uint32 stale = s_publishedSlots & ~connectedSlots;
+    for (int i = 0; stale; i++, stale >>= 1) {
+        if (stale & 1u) Unpublish(i);
+    }
+    s_pSegment->header.frame.store(++s_frame, std::memory_order_release);
+}
+
+//==============================================================================
+// GameController ̏o
+//==============================================================================
+void StatePublisher::PublishGameController() {
+    if (!s_pSegment) return;
+
+    int slot = GameController::GetSlot();
+    if (slot < 0 || !GameController::IsConnected()) {
+        EndFrame(0);
+        return;
+    }
+
+    const DeviceInfo& info = GameController::GetDeviceInfo();
+
+    SlotData data = {};
+    data.timestampNS = SDL_GetTicksNS();
+    data.frame = s_frame;
+    data.id = GameController::GetDeviceRegistry().GetId(slot);
+    data.type = info.type;
+    SDL_strlcpy(data.name, info.name, sizeof(data.name));
+    data.state = GameController::GetCurrentState();
+
+    data.flags = FLAG_BATTERY;
+    data.battery = MakeBattery(info.battery);
+    if (info.hasGyro || info.hasAccel) {
+        data.sensor = GameController::GetSensorData();
+        data.flags |= FLAG_SENSOR;
+    }
+    if (info.hasTouchpad) {
+        data.touchpad = GameController::GetTouchpadData();
+        data.flags |= FLAG_TOUCHPAD;
+    }
+
+    Publish(slot, data);
+    EndFrame(1u << slot);
+}
+
+//==============================================================================
+// GamepadManager ̏oi{^Ê݁j
+//==============================================================================
+void StatePublisher::PublishGamepadManager() {
+    if (!s_pSegment) return;
+
+    Uint64 nowNS = SDL_GetTicksNS();
+    Uint32 connected = GamepadManager::GetConnectedSlots();
+    for (int slot = 0; slot < MAX_SLOTS; slot++) {
+        if (!(connected & (1u << slot))) continue;
+
+        SlotData data = {};
+        data.timestampNS = nowNS;
+        data.frame = s_frame;
+        data.id = GamepadManager::GetDeviceRegistry().GetId(slot);
+        data.type = ControllerType::Unknown;
+        SDL_strlcpy(data.name, GamepadManager::GetControllerName(slot), sizeof(data.name));
+        data.state = GamepadManager::GetState(slot);
+        Publish(slot, data);
+    }
+    EndFrame(connected);
+}
@@ -0,0 +1,37 @@
+/*********************************************************************
+ * \file   state_publisher.h
+ * \brief  Rg[[ԂL֏oivZX̕\EL^c[j
+ *********************************************************************/
+#pragma once
+#include "shared_state.h"
+
+//==============================================================================
+// Ԃ̏oNX
+//------------------------------------------------------------------------------
+// foCXJĂvZX 1 oAI[o[C͕\Ȃǂ
+// StateReader œǂށBec[ SDL ŃfoCXJɍςނ̂ŁA
+// foCXƂ̒ʐMAUELED ̎荇NȂB
+// ݂̓XbgƂ̃V[PXbNŁAVXeR[bNgȂB
+// Publish n̓CXbhiUpdate() ĂԃXbhjĂԂƁB
+//==============================================================================
+class StatePublisher {
+public:
+    // OŏoĂvZXΎs
+    static bool Open(const char* pName = SharedStateFormat::DEFAULT_NAME);
+    static void Close();
+    static bool IsOpen();
+
+    // Xbg 1 o / ؒfƂď
+    static void Publish(int slot, const SharedStateFormat::SlotData& data);
+    static void Unpublish(int slot);
+
+    // GameController / GamepadManager ݂̌̃t[܂Ƃ߂ďoiUpdate() ̌ɌĂԁj
+    static void PublishGameController();
+    static void PublishGamepadManager();
+
+    // BatteryInfo Lpɕϊ
+    static SharedStateFormat::Battery MakeBattery(const BatteryInfo& info);
+
+private:
+    static void EndFrame(Uint32 connectedSlots);
+};
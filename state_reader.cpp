@@ -0,0 +1,75 @@
+/*********************************************************************
+ * \file   state_reader.cpp
+ * \brief  LɏoꂽRg[[ԂǂށiʃvZXpj
+ *********************************************************************/
+#include "state_reader.h"
+#include <cstring>
+
+using namespace SharedStateFormat;
+
+//==============================================================================
+// JE
+//==============================================================================
+bool StateReader::Open(const char* pName) {
+    Close();
+
+    if (!m_mapping.Open(pName, sizeof(Segment))) return false;
+
+    const Segment* pSegment = static_cast<const Segment*>(m_mapping.GetData());
+    const Header& header = pSegment->header;
+    header.frame.load(std::memory_order_acquire);
+    if (header.magic != MAGIC || header.version != VERSION ||
+        header.slotCount != static_cast<Uint32>(MAX_SLOTS) || header.slotSize != sizeof(Slot)) {
+        m_mapping.Close();
+        return false;
+    }
+
+    m_pSegment = pSegment;
+    return true;
+}
+
+void StateReader::Close() {
+    m_pSegment = nullptr;
+    m_mapping.Close();
+}
+
+//==============================================================================
+// Q
+//==============================================================================
+Uint32 StateReader::GetFrame() const {
+    if (!m_pSegment) return 0;
+    return m_pSegment->header.frame.load(std::memory_order_acquire);
+}
+
+Uint32 StateReader::GetConnectedSlots() const {
+    if (!m_pSegment) return 0;
+    return m_pSegment->header.connectedSlots.load(std::memory_order_acquire);
+}
+
+//==============================================================================
+// ǂݍ݁iV[PXbNj
+//==============================================================================
+bool StateReader::Read(int slot, SlotData* pOut, Uint32* pSequence) const {
+    if (!m_pSegment || !IsValidSlot(slot)) return false;
+
+    const Slot& source = m_pSegment->slots[slot];
+    for (int attempt = 0; attempt < MAX_RETRY; attempt++) {
+        Uint32 before = source.sequence.load(std::memory_order_acquire);
+        if (before & 1u) continue;
+
+        std::memcpy(pOut, &source.data, sizeof(SlotData));
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        Uint32 after = source.sequence.load(std::memory_order_relaxed);
+        if (before == after) {
+            if (pSequence) *pSequence = before;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool StateReader::HasChanged(int slot, Uint32 sequence) const {
+    if (!m_pSegment || !IsValidSlot(slot)) return false;
+    return m_pSegment->slots[slot].sequence.load(std::memory_order_acquire) != sequence;
+}
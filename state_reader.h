@@ -0,0 +1,45 @@
+/*********************************************************************
+ * \file   state_reader.h
+ * \brief  LɏoꂽRg[[ԂǂށiʃvZXpj
+ *********************************************************************/
+#pragma once
+#include "shared_state.h"
+
+//==============================================================================
+// Ԃ̓ǂݍ݃NX
+//------------------------------------------------------------------------------
+// LǂݎpŊJAbNVXeR[g킸ɍŐV̏Ԃ
+// Rs[B݂ƏdȂƂ̓V[PX܂œǂݒB
+// ݑĂǂݍݑ͍Ō̏Ԃǂ߂̂ŁAGetFrame() 
+// ił邩Ő𔻒f邱ƁB
+//==============================================================================
+class StateReader {
+public:
+    static constexpr int MAX_RETRY = 64;
+
+    StateReader() = default;
+    ~StateReader() { Close(); }
+    StateReader(const StateReader&) = delete;
+    StateReader& operator=(const StateReader&) = delete;
+
+    // ݑ܂E`Ⴄꍇ͎siŊJ΂悢j
+    bool Open(const char* pName = SharedStateFormat::DEFAULT_NAME);
+    void Close();
+    bool IsOpen() const { return m_pSegment != nullptr; }
+
+    // ݑ̃t[ԍioтɐiށj
+    Uint32 GetFrame() const;
+    Uint32 GetConnectedSlots() const;
+    bool IsConnected(int slot) const { return IsValidSlot(slot) && (GetConnectedSlots() & (1u << slot)) != 0; }
+
+    // Xbg̍ŐV̏ԂRs[i݂ēǂ߂Ȃ falsej
+    // pSequence ɂ͓ǂ񂾔łԂ̂ŁAHasChanged() ɓnƕω𒲂ׂ
+    bool Read(int slot, SharedStateFormat::SlotData* pOut, Uint32* pSequence = nullptr) const;
+    bool HasChanged(int slot, Uint32 sequence) const;
+
+private:
+    static bool IsValidSlot(int slot) { return slot >= 0 && slot < SharedStateFormat::MAX_SLOTS; }
+
+    SharedMemoryMapping m_mapping;
+    const SharedStateFormat::Segment* m_pSegment = nullptr;
+};
@@ -0,0 +1,237 @@
+/*********************************************************************
+ * \file   touch_gesture.cpp
+ * \brief  ^b`pbh̃WFX`[Fi^bv / XCv / XN[ / s`j
+ *********************************************************************/
+#include "touch_gesture.h"
+#include <cmath>
+
+//==============================================================================
+// wp[
+//==============================================================================
+namespace {
+    // 菬ʒu͓̍ʒuƂ݂Ȃi^b`pbh̕\\j
+    constexpr float POSITION_EPSILON = 1e-4f;
+
+    float Length(float x, float y) {
+        return std::sqrt(x * x + y * y);
+    }
+
+    int CountBits(Uint8 mask) {
+        int count = 0;
+        for (; mask; mask &= mask - 1) count++;
+        return count;
+    }
+}
+
+//==============================================================================
+// Zbg
+//==============================================================================
+void TouchGestureRecognizer::Reset() {
+    for (int i = 0; i < TOUCHPAD_MAX_COUNT; i++) {
+        m_pads[i] = {};
+    }
+}
+
+//==============================================================================
+// w̒ǐ
+//==============================================================================
+void TouchGestureRecognizer::BeginContact(Pad& pad, int contact, int finger, const TouchSample& sample) {
+    Contact& c = pad.contacts[contact];
+    c.startX = c.x = sample.x;
+    c.startY = c.y = sample.y;
+    c.velocityX = c.velocityY = 0.0f;
+    c.startNS = c.lastMoveNS = sample.timestampNS;
+    pad.contactOf[finger] = static_cast<Uint8>(contact + 1);
+}
+
+void TouchGestureRecognizer::MoveContact(Contact& contact, const TouchSample& sample) {
+    // |[goTv͎Ȃ̂őx͍XVȂ
+    if (sample.timestampNS > contact.lastMoveNS) {
+        float dt = static_cast<float>(sample.timestampNS - contact.lastMoveNS) * 1e-9f;
+        float vx = (sample.x - contact.x) / dt;
+        float vy = (sample.y - contact.y) / dt;
+        if (contact.lastMoveNS == contact.startNS) {
+            // ŏ̈ړ͂̂܂܎g
+            contact.velocityX = vx;
+            contact.velocityY = vy;
+        } else {
+            contact.velocityX += (vx - contact.velocityX) * m_settings.velocitySmoothing;
+            contact.velocityY += (vy - contact.velocityY) * m_settings.velocitySmoothing;
+        }
+        contact.lastMoveNS = sample.timestampNS;
+    }
+    contact.x = sample.x;
+    contact.y = sample.y;
+}
+
+// _̑xi΂炭~܂Ă 0j
+float TouchGestureRecognizer::ReleaseSpeed(const Contact& contact, Uint64 nowNS, float* pVelocityX, float* pVelocityY) const {
+    if (nowNS - contact.lastMoveNS > m_settings.velocityTimeoutNS) {
+        *pVelocityX = *pVelocityY = 0.0f;
+        return 0.0f;
+    }
+    *pVelocityX = contact.velocityX;
+    *pVelocityY = contact.velocityY;
+    return Length(contact.velocityX, contact.velocityY);
+}
+
+// s`Jn̎ẘԊu̔
+float TouchGestureRecognizer::SpanScale(const Pad& pad) {
+    if (pad.startSpan <= 0.0f) return 1.0f;
+    const Contact& a = pad.contacts[0];
+    const Contact& b = pad.contacts[1];
+    return Length(b.x - a.x, b.y - a.y) / pad.startSpan;
+}
+
+void TouchGestureRecognizer::Fill(const Pad& pad, const TouchSample& sample, TouchGestureType type, TouchGesturePhase phase, TouchGesture* pOut) const {
+    *pOut = {};
+    pOut->type = type;
+    pOut->phase = phase;
+    pOut->timestampNS = sample.timestampNS;
+    pOut->touchpad = sample.touchpad;
+    pOut->x = pad.centroidX;
+    pOut->y = pad.centroidY;
+}
+
+//==============================================================================
+// 
+//==============================================================================
+bool TouchGestureRecognizer::Process(const TouchSample& sample, TouchGesture* pOut) {
+    if (sample.touchpad >= TOUCHPAD_MAX_COUNT || sample.finger >= TOUCHPAD_MAX_FINGERS) return false;
+
+    Pad& pad = m_pads[sample.touchpad];
+    Uint8 bit = static_cast<Uint8>(1u << sample.finger);
+
+    switch (sample.type) {
+    case SDL_EVENT_GAMEPAD_TOUCHPAD_DOWN: {
+        if (pad.downMask & bit) return false;
+        pad.downMask |= bit;
+
+        int count = CountBits(pad.downMask);
+        if (count == 1) {
+            BeginContact(pad, 0, sample.finger, sample);
+            pad.mode = MODE_ONE_FINGER;
+            return false;
+        }
+        if (count == 2 && pad.mode == MODE_ONE_FINGER) {
+            BeginContact(pad, 1, sample.finger, sample);
+            const Contact& a = pad.contacts[0];
+            const Contact& b = pad.contacts[1];
+            pad.startSpan = Length(b.x - a.x, b.y - a.y);
+            pad.centroidX = (a.x + b.x) * 0.5f;
+            pad.centroidY = (a.y + b.y) * 0.5f;
+            pad.mode = MODE_TWO_FINGER;
+            return false;
+        }
+
+        // 3 {ځFĂWFX`[I点
+        Mode prevMode = pad.mode;
+        pad.mode = MODE_CANCELLED;
+        if (prevMode == MODE_SCROLL || prevMode == MODE_PINCH) {
+            Fill(pad, sample, (prevMode == MODE_SCROLL) ? TouchGestureType::Scroll : TouchGestureType::Pinch,
+                TouchGesturePhase::End, pOut);
+            pOut->scale = SpanScale(pad);
+            return true;
+        }
+        return false;
+    }
+
+    case SDL_EVENT_GAMEPAD_TOUCHPAD_MOTION: {
+        int index = pad.contactOf[sample.finger] - 1;
+        if (!(pad.downMask & bit) || index < 0) return false;
+
+        MoveContact(pad.contacts[index], sample);
+        if (pad.mode < MODE_TWO_FINGER || pad.mode > MODE_PINCH) return false;
+
+        const Contact& a = pad.contacts[0];
+        const Contact& b = pad.contacts[1];
+        float centroidX = (a.x + b.x) * 0.5f;
+        float centroidY = (a.y + b.y) * 0.5f;
+        float span = Length(b.x - a.x, b.y - a.y);
+
+        TouchGesturePhase phase = TouchGesturePhase::Change;
+        if (pad.mode == MODE_TWO_FINGER) {
+            // Ԋu̕ωƒ_̈ړ̑傫Ɍ߂
+            float spanChange = std::fabs(span - pad.startSpan);
+            float move = Length(centroidX - pad.centroidX, centroidY - pad.centroidY);
+            if (spanChange < m_settings.twoFingerSlop && move < m_settings.twoFingerSlop) return false;
+            pad.mode = (spanChange > move) ? MODE_PINCH : MODE_SCROLL;
+            phase = TouchGesturePhase::Begin;
+        }
+
+        Fill(pad, sample, (pad.mode == MODE_SCROLL) ? TouchGestureType::Scroll : TouchGestureType::Pinch, phase, pOut);
+        pOut->x = centroidX;
+        pOut->y = centroidY;
+        pOut->deltaX = centroidX - pad.centroidX;
+        pOut->deltaY = centroidY - pad.centroidY;
+        pOut->velocityX = (a.velocityX + b.velocityX) * 0.5f;
+        pOut->velocityY = (a.velocityY + b.velocityY) * 0.5f;
+        pOut->scale = SpanScale(pad);
+        pad.centroidX = centroidX;
+        pad.centroidY = centroidY;
+        return true;
+    }
+
+    case SDL_EVENT_GAMEPAD_TOUCHPAD_UP: {
+        if (!(pad.downMask & bit)) return false;
+        pad.downMask &= ~bit;
+
+        int index = pad.contactOf[sample.finger] - 1;
+        pad.contactOf[sample.finger] = 0;
+
+        Mode prevMode = pad.mode;
+        pad.mode = pad.downMask ? MODE_CANCELLED : MODE_IDLE;
+        if (index < 0) return false;
+
+        // UP ͍Ō̈ʒuJԂ̂Ƃ̂ŁAƂxɔf
+        Contact& contact = pad.contacts[index];
+        if (Length(sample.x - contact.x, sample.y - contact.y) > POSITION_EPSILON) {
+            MoveContact(contact, sample);
+        }
+
+        if (prevMode == MODE_ONE_FINGER) {
+            float dx = contact.x - contact.startX;
+            float dy = contact.y - contact.startY;
+            float distance = Length(dx, dy);
+            Uint64 duration = sample.timestampNS - contact.startNS;
+
+            float vx = 0.0f, vy = 0.0f;
+            float speed = ReleaseSpeed(contact, sample.timestampNS, &vx, &vy);
+
+            TouchGestureType type = TouchGestureType::None;
+            if (distance <= m_settings.tapMaxDistance && duration <= m_settings.tapMaxDurationNS) {
+                type = TouchGestureType::Tap;
+            } else if (distance >= m_settings.swipeMinDistance && speed >= m_settings.swipeMinVelocity) {
+                type = TouchGestureType::Swipe;
+            }
+            if (type == TouchGestureType::None) return false;
+
+            Fill(pad, sample, type, TouchGesturePhase::End, pOut);
+            pOut->x = (type == TouchGestureType::Tap) ? contact.startX : contact.x;
+            pOut->y = (type == TouchGestureType::Tap) ? contact.startY : contact.y;
+            pOut->deltaX = dx;
+            pOut->deltaY = dy;
+            pOut->velocityX = vx;
+            pOut->velocityY = vy;
+            return true;
+        }
+
+        if (prevMode == MODE_SCROLL || prevMode == MODE_PINCH) {
+            // ̎w̑xi~܂Ăw 0jɎg
+            float ax = 0.0f, ay = 0.0f, bx = 0.0f, by = 0.0f;
+            ReleaseSpeed(pad.contacts[0], sample.timestampNS, &ax, &ay);
+            ReleaseSpeed(pad.contacts[1], sample.timestampNS, &bx, &by);
+
+            Fill(pad, sample, (prevMode == MODE_SCROLL) ? TouchGestureType::Scroll : TouchGestureType::Pinch,
+                TouchGesturePhase::End, pOut);
+            pOut->velocityX = (ax + bx) * 0.5f;
+            pOut->velocityY = (ay + by) * 0.5f;
+            pOut->scale = SpanScale(pad);
+            return true;
+        }
+        return false;
+    }
+    }
+
+    return false;
+}
@@ -0,0 +1,129 @@
+/*********************************************************************
+ * \file   touch_gesture.h
+ * \brief  ^b`pbh̃WFX`[Fi^bv / XCv / XN[ / s`j
+ *********************************************************************/
+#pragma once
+#include <SDL3/SDL.h>
+#include "controller_types.h"
+
+//==============================================================================
+// ^b`Tv\́iSDL_EVENT_GAMEPAD_TOUCHPAD_* 1 j
+//==============================================================================
+struct TouchSample {
+    Uint64 timestampNS = 0;     // CxgiSDL_GetTicksNS j
+    Uint32 type = 0;            // SDL_EVENT_GAMEPAD_TOUCHPAD_DOWN / MOTION / UP
+    SDL_JoystickID which = 0;
+    Uint8 touchpad = 0;
+    Uint8 finger = 0;
+    float x = 0.0f;             // 0.0 ~ 1.0iオ_j
+    float y = 0.0f;
+    float pressure = 0.0f;      // 0.0 ~ 1.0
+};
+
+//==============================================================================
+// WFX`[
+//==============================================================================
+enum class TouchGestureType {
+    None,
+    Tap,        // 1 {wŒZGė
+    Swipe,      // 1 {wŕė
+    Scroll,     // 2 {wœɓĂ
+    Pinch       // 2 {ẘԊuςĂ
+};
+
+enum class TouchGesturePhase {
+    Begin,
+    Change,
+    End         // ^bvEXCv End ̂
+};
+
+struct TouchGesture {
+    TouchGestureType type = TouchGestureType::None;
+    TouchGesturePhase phase = TouchGesturePhase::End;
+    Uint64 timestampNS = 0;
+    int touchpad = 0;
+
+    // ʒui^bvEXCv͎wAXN[Es` 2 {̒_j
+    float x = 0.0f;
+    float y = 0.0f;
+
+    // ړʁiXCv͐GꂽʒuAXN[͑O̒ʒmj
+    float deltaX = 0.0f;
+    float deltaY = 0.0f;
+
+    // xiP / bAXN[ End ͗_̑xŊɎgj
+    float velocityX = 0.0f;
+    float velocityY = 0.0f;
+
+    // s`Jn̎ẘԊu̔
+    float scale = 1.0f;
+};
+
+//==============================================================================
+// F̐ݒi 0.0 ~ 1.0 ̍Wnj
+//==============================================================================
+struct TouchGestureSettings {
+    Uint64 tapMaxDurationNS = 250 * SDL_NS_PER_MS;
+    float tapMaxDistance = 0.03f;
+    float swipeMinDistance = 0.15f;
+    float swipeMinVelocity = 0.8f;      // P / b
+    float twoFingerSlop = 0.02f;        // 2 {wꂾXN[s`Ɍ߂
+    float velocitySmoothing = 0.5f;     // x̕Wi1.0 ŕȂj
+    Uint64 velocityTimeoutNS = 50 * SDL_NS_PER_MS;  // ~܂Ă痣瑬x 0 Ƃ݂Ȃ
+};
+
+//==============================================================================
+// WFX`[FNX
+//------------------------------------------------------------------------------
+// ^b`Tv 1 nƁAԂXV O(1) Ŕ肷B
+// 1 ̃TvoWFX`[͍ő 1 B
+// 3 {ڂ̎wGꂽ 2 {w̕Еꂽ肵AS̎w܂ŉoȂB
+//==============================================================================
+class TouchGestureRecognizer {
+public:
+    void SetSettings(const TouchGestureSettings& settings) { m_settings = settings; }
+    const TouchGestureSettings& GetSettings() const { return m_settings; }
+
+    // WFX`[ pOut ɏ true Ԃ
+    bool Process(const TouchSample& sample, TouchGesture* pOut);
+
+    // foCX̕tւɌĂ
+    void Reset();
+
+private:
+    enum Mode : Uint8 {
+        MODE_IDLE,
+        MODE_ONE_FINGER,
+        MODE_TWO_FINGER,    // 2 {ڂGꂽ܂܂ĂȂ
+        MODE_SCROLL,
+        MODE_PINCH,
+        MODE_CANCELLED
+    };
+
+    // FɎgwiő 2 {j
+    struct Contact {
+        float startX, startY;
+        float x, y;
+        float velocityX, velocityY;
+        Uint64 startNS;
+        Uint64 lastMoveNS;      // xXV
+    };
+
+    struct Pad {
+        Contact contacts[2];
+        Uint8 contactOf[TOUCHPAD_MAX_FINGERS];  // w  contacts ̓Y + 1i0 őΏۊOj
+        Uint8 downMask;
+        Mode mode;
+        float startSpan;
+        float centroidX, centroidY;             // Oɒʒm_
+    };
+
+    void BeginContact(Pad& pad, int contact, int finger, const TouchSample& sample);
+    void MoveContact(Contact& contact, const TouchSample& sample);
+    static float SpanScale(const Pad& pad);
+    float ReleaseSpeed(const Contact& contact, Uint64 nowNS, float* pVelocityX, float* pVelocityY) const;
+    void Fill(const Pad& pad, const TouchSample& sample, TouchGestureType type, TouchGesturePhase phase, TouchGesture* pOut) const;
+
+    TouchGestureSettings m_settings;
+    Pad m_pads[TOUCHPAD_MAX_COUNT] = {};
+};